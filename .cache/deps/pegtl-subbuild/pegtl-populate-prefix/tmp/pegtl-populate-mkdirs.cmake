@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/.cache/deps/pegtl-src"
+  "/root/repo/.cache/deps/pegtl-build"
+  "/root/repo/.cache/deps/pegtl-subbuild/pegtl-populate-prefix"
+  "/root/repo/.cache/deps/pegtl-subbuild/pegtl-populate-prefix/tmp"
+  "/root/repo/.cache/deps/pegtl-subbuild/pegtl-populate-prefix/src/pegtl-populate-stamp"
+  "/root/repo/.cache/deps/pegtl-subbuild/pegtl-populate-prefix/src"
+  "/root/repo/.cache/deps/pegtl-subbuild/pegtl-populate-prefix/src/pegtl-populate-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/.cache/deps/pegtl-subbuild/pegtl-populate-prefix/src/pegtl-populate-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/.cache/deps/pegtl-subbuild/pegtl-populate-prefix/src/pegtl-populate-stamp${cfgdir}") # cfgdir has leading slash
+endif()
@@ -0,0 +1,171 @@
+/// Latency of handing samples from acquisition threads to an evaluation thread.
+///
+/// Every producer thread samples its own signal at a fixed rate, and the time between
+/// producing a sample and storing it in its signal is recorded. The lock-free ingestion
+/// queue, drained by a consumer thread, is compared to producers appending to the
+/// signals directly under a shared mutex.
+///
+/// Usage: ingest_latency [n_producers] [n_samples] [period_ns]
+
+#include "signal_tl/ingest.hpp" // for IngestQueue
+#include "signal_tl/signal.hpp" // for Signal
+
+#include <fmt/format.h> // for print
+
+#include <algorithm> // for sort, max
+#include <atomic>    // for atomic
+#include <chrono>    // for steady_clock, nanoseconds
+#include <cstddef>   // for size_t
+#include <cstdint>   // for int64_t
+#include <cstdlib>   // for strtoull
+#include <memory>    // for make_shared, shared_ptr
+#include <mutex>     // for mutex, lock_guard
+#include <string>    // for string
+#include <thread>    // for thread, yield
+#include <vector>    // for vector
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using Queue      = signal_tl::semantics::BasicIngestQueue<std::int64_t, double>;
+using Signal     = signal_tl::signal::BasicSignal<std::int64_t, double>;
+
+std::int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             clock_type::now().time_since_epoch())
+      .count();
+}
+
+/// Busy-wait until `deadline`, like a producer polling its hardware.
+void wait_until(std::int64_t deadline) {
+  while (now_ns() < deadline) {}
+}
+
+struct Options {
+  size_t n_producers     = 4;
+  size_t n_samples       = 200000;
+  std::int64_t period_ns = 2000;
+};
+
+void report(const std::string& name, std::vector<std::int64_t>& latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  const auto at = [&](double q) {
+    const auto i = static_cast<size_t>(q * static_cast<double>(latencies.size() - 1));
+    return static_cast<double>(latencies[i]) / 1000.0;
+  };
+  fmt::print(
+      "{:<10} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f}\n",
+      name,
+      at(0.5),
+      at(0.9),
+      at(0.99),
+      at(0.999),
+      at(1.0));
+}
+
+/// Spawn the producers, each calling `emit(producer, time)` once per period.
+template <typename Emit>
+void run_producers(const Options& opt, Emit&& emit) {
+  auto producers = std::vector<std::thread>{};
+  for (size_t p = 0; p < opt.n_producers; p++) {
+    producers.emplace_back([&opt, &emit, p]() {
+      std::int64_t next = now_ns();
+      for (size_t i = 0; i < opt.n_samples; i++) {
+        next += opt.period_ns;
+        wait_until(next);
+        emit(p, now_ns());
+      }
+    });
+  }
+  for (auto& th : producers) { th.join(); }
+}
+
+std::vector<std::int64_t> bench_mutex(const Options& opt) {
+  auto signals   = std::vector<std::shared_ptr<Signal>>{};
+  auto latencies = std::vector<std::vector<std::int64_t>>(opt.n_producers);
+  for (size_t p = 0; p < opt.n_producers; p++) {
+    signals.push_back(std::make_shared<Signal>());
+    signals.back()->reserve(opt.n_samples);
+    latencies[p].reserve(opt.n_samples);
+  }
+
+  auto mtx = std::mutex{};
+  run_producers(opt, [&](size_t p, std::int64_t t) {
+    {
+      std::lock_guard<std::mutex> lock{mtx};
+      signals[p]->push_back(t, static_cast<double>(p));
+    }
+    latencies[p].push_back(now_ns() - t);
+  });
+
+  auto out = std::vector<std::int64_t>{};
+  for (const auto& l : latencies) { out.insert(out.end(), l.begin(), l.end()); }
+  return out;
+}
+
+std::vector<std::int64_t> bench_queue(const Options& opt) {
+  auto signals = std::vector<std::shared_ptr<Signal>>{};
+  for (size_t p = 0; p < opt.n_producers; p++) {
+    signals.push_back(std::make_shared<Signal>());
+    signals.back()->reserve(opt.n_samples);
+  }
+  auto queue     = Queue{opt.n_producers, 4096};
+  auto latencies = std::vector<std::int64_t>{};
+  latencies.reserve(opt.n_producers * opt.n_samples);
+
+  auto done     = std::atomic<bool>{false};
+  auto consumer = std::thread{[&]() {
+    const auto store = [&](const Queue::Record& r) {
+      signals[r.channel]->push_back(r.time, r.value);
+      latencies.push_back(now_ns() - r.time);
+    };
+    while (!done) {
+      if (queue.consume(store) == 0) {
+        std::this_thread::yield();
+      }
+    }
+    queue.consume(store);
+  }};
+
+  run_producers(opt, [&](size_t p, std::int64_t t) {
+    while (!queue.push(p, p, t, static_cast<double>(p))) { std::this_thread::yield(); }
+  });
+  done = true;
+  consumer.join();
+  return latencies;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  auto opt = Options{};
+  if (argc > 1) {
+    opt.n_producers = std::strtoull(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    opt.n_samples = std::strtoull(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    opt.period_ns = static_cast<std::int64_t>(std::strtoull(argv[3], nullptr, 10));
+  }
+
+  fmt::print(
+      "{} producers, {} samples each, one every {} ns\n",
+      opt.n_producers,
+      opt.n_samples,
+      opt.period_ns);
+  fmt::print(
+      "{:<10} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+      "latency",
+      "p50 (us)",
+      "p90",
+      "p99",
+      "p99.9",
+      "max");
+
+  auto mutex_latencies = bench_mutex(opt);
+  report("mutex", mutex_latencies);
+  auto queue_latencies = bench_queue(opt);
+  report("spsc", queue_latencies);
+  return 0;
+}
@@ -0,0 +1,288 @@
+/// Throughput of the robustness kernels and of the robustness of whole formulas.
+///
+/// The signals are random piecewise-linear signals (see `generators::random_signal`)
+/// with `n` samples, one per time unit, that cross zero about `d` times per 100
+/// samples (the "crossings" argument). Windows are given in
+/// samples. By default the sizes go from 10^3 to 10^6 samples: set the environment
+/// variable `SIGNALTL_BENCHMARK_MAX_SIZE` (e.g., to `100000000`) to run the larger
+/// sizes, which need a few GiB of memory.
+///
+/// Usage: robustness_kernels [google benchmark options]
+///
+/// The `benchmarks-json` target runs every benchmark and writes the results to
+/// `robustness_kernels.json` in the build directory of the benchmarks.
+
+#include "signal_tl/signal_tl.hpp"
+
+#include "minmax.hpp" // for compute_elementwise_min, compute_max_seq, ...
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm> // for min
+#include <cstddef>   // for size_t
+#include <cstdint>   // for int64_t
+#include <cstdlib>   // for getenv, strtoll
+#include <string>    // for string
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+namespace {
+
+namespace stl = signal_tl;
+using stl::signal::SignalPtr;
+
+stl::generators::SignalOptions signal_options(int64_t n, int64_t crossings) {
+  auto options      = stl::generators::SignalOptions{};
+  options.length    = static_cast<size_t>(n);
+  options.crossings = static_cast<double>(crossings) / 100.0;
+  options.noise     = 0.01;
+  return options;
+}
+
+/// A signal with `n` samples at the times `offset + i` that crosses `0` about
+/// `crossings` times per 100 samples.
+SignalPtr
+make_signal(int64_t n, int64_t crossings, double offset = 0, unsigned seed = 0) {
+  auto options  = signal_options(n, crossings);
+  options.begin = offset;
+  return stl::generators::random_signal(options, seed);
+}
+
+int64_t max_size() {
+  const char* env = std::getenv("SIGNALTL_BENCHMARK_MAX_SIZE");
+  return (env == nullptr) ? 1000000 : std::strtoll(env, nullptr, 10);
+}
+
+/// Register the powers of 10 from 10^3 to the maximum size, times each of `extra`.
+void sizes_times(benchmark::internal::Benchmark* b, const std::vector<int64_t>& extra) {
+  for (int64_t n = 1000; n <= std::min<int64_t>(max_size(), 100000000); n *= 10) {
+    if (extra.empty()) {
+      b->Arg(n);
+    }
+    for (const auto e : extra) { b->Args({n, e}); }
+  }
+}
+
+void sizes(benchmark::internal::Benchmark* b) {
+  sizes_times(b, {});
+}
+
+void crossings(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"n", "crossings"});
+  sizes_times(b, {1, 10, 50});
+}
+
+void widths(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"n", "width"});
+  sizes_times(b, {10, 1000, 100000});
+}
+
+void fan_in(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"n", "k"});
+  sizes_times(b, {4, 16});
+}
+
+void set_items(benchmark::State& state, int64_t per_iteration) {
+  state.SetItemsProcessed(state.iterations() * per_iteration);
+}
+
+// ---------------------------------------------------------------------------------
+// Signal operations
+// ---------------------------------------------------------------------------------
+
+void BM_Synchronize(benchmark::State& state) {
+  const auto n = state.range(0);
+  // Interleaved sampling times, so each signal gets the samples of the other.
+  const auto x = make_signal(n, state.range(1), 0.0, 1);
+  const auto y = make_signal(n, state.range(1), 0.5, 2);
+  for (auto _ : state) { benchmark::DoNotOptimize(stl::signal::synchronize(x, y)); }
+  set_items(state, 2 * n);
+}
+BENCHMARK(BM_Synchronize)->Apply(crossings)->Unit(benchmark::kMillisecond);
+
+void BM_Simplify(benchmark::State& state) {
+  const auto x = make_signal(state.range(0), state.range(1));
+  for (auto _ : state) { benchmark::DoNotOptimize(x->simplify()); }
+  set_items(state, state.range(0));
+}
+BENCHMARK(BM_Simplify)->Apply(crossings)->Unit(benchmark::kMillisecond);
+
+void BM_SimplifyEpsilon(benchmark::State& state) {
+  const auto x = make_signal(state.range(0), state.range(1));
+  for (auto _ : state) { benchmark::DoNotOptimize(x->simplify(0.05)); }
+  set_items(state, state.range(0));
+}
+BENCHMARK(BM_SimplifyEpsilon)->Apply(crossings)->Unit(benchmark::kMillisecond);
+
+void BM_Resize(benchmark::State& state) {
+  const auto n = state.range(0);
+  const auto x = make_signal(n, 10);
+  const auto m = static_cast<double>(n);
+  for (auto _ : state) {
+    // Truncate the start and extend past the end.
+    benchmark::DoNotOptimize(x->resize(0.25 * m, 1.25 * m, 0.0));
+  }
+  set_items(state, n);
+}
+BENCHMARK(BM_Resize)->Apply(sizes)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------
+// Min/max kernels
+// ---------------------------------------------------------------------------------
+
+template <bool IsMax>
+void BM_Elementwise(benchmark::State& state) {
+  const auto n = state.range(0);
+  const auto x = make_signal(n, state.range(1), 0.0, 1);
+  const auto y = make_signal(n, state.range(1), 0.0, 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        (IsMax) ? stl::minmax::compute_elementwise_max(x, y)
+                : stl::minmax::compute_elementwise_min(x, y));
+  }
+  set_items(state, 2 * n);
+}
+BENCHMARK_TEMPLATE(BM_Elementwise, false)
+    ->Name("BM_ElementwiseMin")
+    ->Apply(crossings)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Elementwise, true)
+    ->Name("BM_ElementwiseMax")
+    ->Apply(crossings)
+    ->Unit(benchmark::kMillisecond);
+
+template <bool IsMax>
+void BM_ElementwiseN(benchmark::State& state) {
+  const auto n = state.range(0);
+  auto xs      = std::vector<SignalPtr>{};
+  for (int64_t k = 0; k < state.range(1); k++) {
+    xs.push_back(make_signal(n, 10, 0.0, static_cast<unsigned>(k)));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        (IsMax) ? stl::minmax::compute_elementwise_max(xs)
+                : stl::minmax::compute_elementwise_min(xs));
+  }
+  set_items(state, n * state.range(1));
+}
+BENCHMARK_TEMPLATE(BM_ElementwiseN, false)
+    ->Name("BM_ElementwiseMinN")
+    ->Apply(fan_in)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ElementwiseN, true)
+    ->Name("BM_ElementwiseMaxN")
+    ->Apply(fan_in)
+    ->Unit(benchmark::kMillisecond);
+
+template <bool IsMax>
+void BM_Seq(benchmark::State& state) {
+  const auto x = make_signal(state.range(0), 10);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        (IsMax) ? stl::minmax::compute_max_seq(x) : stl::minmax::compute_min_seq(x));
+  }
+  set_items(state, state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_Seq, false)
+    ->Name("BM_MinSeq")
+    ->Apply(sizes)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Seq, true)
+    ->Name("BM_MaxSeq")
+    ->Apply(sizes)
+    ->Unit(benchmark::kMillisecond);
+
+template <bool IsMax>
+void BM_SeqWindow(benchmark::State& state) {
+  const auto x = make_signal(state.range(0), 10);
+  const auto b = static_cast<double>(state.range(1));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        (IsMax) ? stl::minmax::compute_max_seq(x, 0.0, b)
+                : stl::minmax::compute_min_seq(x, 0.0, b));
+  }
+  set_items(state, state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SeqWindow, false)
+    ->Name("BM_MinSeqWindow")
+    ->Apply(widths)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SeqWindow, true)
+    ->Name("BM_MaxSeqWindow")
+    ->Apply(widths)
+    ->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------------------------------------
+// Robustness of formulas
+// ---------------------------------------------------------------------------------
+
+stl::Trace make_trace(int64_t n, int64_t crossings) {
+  return stl::generators::random_trace({"x", "y"}, signal_options(n, crossings));
+}
+
+void BM_Predicate(benchmark::State& state) {
+  const auto trace = make_trace(state.range(0), 10);
+  const auto phi   = stl::Predicate("x") > 0.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stl::compute_robustness(phi, trace, true));
+  }
+  set_items(state, state.range(0));
+}
+BENCHMARK(BM_Predicate)->Apply(sizes)->Unit(benchmark::kMillisecond);
+
+void BM_Until(benchmark::State& state) {
+  const auto trace = make_trace(state.range(0), state.range(1));
+  const auto phi   = stl::Until(stl::Predicate("x") > 0, stl::Predicate("y") > 0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stl::compute_robustness(phi, trace, true));
+  }
+  set_items(state, 2 * state.range(0));
+}
+BENCHMARK(BM_Until)->Apply(crossings)->Unit(benchmark::kMillisecond);
+
+using Formulas = std::vector<std::pair<std::string, stl::ast::Expr>>;
+
+/// Representative formulas over the signals `x` and `y`.
+const Formulas& formulas() {
+  static const auto f = []() {
+    const auto x = stl::Predicate("x");
+    const auto y = stl::Predicate("y");
+    return Formulas{
+        {"always_eventually", stl::Always(stl::Eventually(x > 0, {0.0, 10.0}))},
+        {"response",
+         stl::Always(stl::Implies(x > 0.5, stl::Eventually(y < 0, {0.0, 100.0})))},
+        {"stabilize",
+         stl::Eventually(stl::Always(stl::And({x > -0.9, x < 0.9}), {0.0, 50.0}))},
+        {"conjunction",
+         stl::And({x > -0.5, x < 0.5, y > -0.5, y < 0.5, stl::Eventually(y > 0.9)})},
+        {"past", stl::Historically(stl::Once(x > 0, {0.0, 20.0}) | (y < 0))},
+    };
+  }();
+  return f;
+}
+
+void BM_Robustness(benchmark::State& state) {
+  const auto trace       = make_trace(state.range(0), state.range(1));
+  const auto& [name, phi] = formulas().at(static_cast<size_t>(state.range(2)));
+  state.SetLabel(name);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stl::compute_robustness(phi, trace, true));
+  }
+  set_items(state, 2 * state.range(0));
+}
+BENCHMARK(BM_Robustness)
+    ->Apply([](benchmark::internal::Benchmark* b) {
+      b->ArgNames({"n", "crossings", "formula"});
+      for (int64_t n = 1000; n <= std::min<int64_t>(max_size(), 100000000); n *= 10) {
+        for (const int64_t d : {1, 50}) {
+          for (size_t i = 0; i < formulas().size(); i++) {
+            b->Args({n, d, static_cast<int64_t>(i)});
+          }
+        }
+      }
+    })
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -12,9 +12,10 @@ x = np.cos(t)
 y = np.sin(t)
 
 trace = {
-    "a": stl.Signal(x, t),
-    "b": stl.Signal(x, t),
+    "a": stl.Signal.from_numpy(t, x),
+    "b": stl.Signal.from_numpy(t, y),
 }
 
 rob = stl.compute_robustness(phi, trace)
 print(rob.at(0))
+print(rob.times, rob.values)
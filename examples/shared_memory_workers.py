@@ -0,0 +1,29 @@
+from multiprocessing import Pool
+
+import numpy as np
+
+import signal_tl as stl
+
+phi = stl.Always(stl.Predicate("x") > -0.9)
+
+
+def worker(args):
+    # Only a handle to the shared memory block is pickled for each worker.
+    trace, phase = args
+    rob = stl.compute_robustness(phi, trace)
+    return phase, rob.at(0)
+
+
+if __name__ == "__main__":
+    t = np.linspace(0, 50, 100_001)
+    trace = stl.Trace()
+    trace["x"] = stl.Signal.from_numpy(t, np.cos(t))
+    shared = trace.to_shared_memory()
+
+    with Pool(4) as pool:
+        for phase, rob in pool.map(worker, [(shared, i) for i in range(8)]):
+            print(phase, rob)
+
+    # The process that created the blocks is responsible for freeing them.
+    for sig in shared.values():
+        sig.shared_memory.unlink()
@@ -19,5 +19,6 @@ namespace py = pybind11;
 void init_ast_module(py::module&);
 void init_signal_module(py::module&);
 void init_robustness_module(py::module&);
+void init_generators_module(py::module&);
 
 #endif
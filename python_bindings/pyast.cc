@@ -48,6 +48,9 @@ void init_ast_module(py::module& parent) {
   parent.def("Always", &Always, "arg"_a, "interval"_a = std::nullopt);
   parent.def("Eventually", &Eventually, "arg"_a, "interval"_a = std::nullopt);
   parent.def("Until", &Until, "arg0"_a, "arg1"_a, "interval"_a = std::nullopt);
+  parent.def("Historically", &Historically, "arg"_a, "interval"_a = std::nullopt);
+  parent.def("Once", &Once, "arg"_a, "interval"_a = std::nullopt);
+  parent.def("Since", &Since, "arg0"_a, "arg1"_a, "interval"_a = std::nullopt);
 
   auto m = parent.def_submodule("ast", "Define the AST nodes for STL");
   py::class_<ast::Const>(m, "Const")
@@ -58,6 +61,13 @@ void init_ast_module(py::module& parent) {
       .def("__invert__", &not_op<ast::Const>)
       .def("__repr__", [](const ast::Const& e) { return fmt::format("{}", e); });
 
+  py::class_<ast::Parameter>(m, "Parameter")
+      .def(py::init<std::string>(), "name"_a)
+      .def_readonly("name", &ast::Parameter::name)
+      .def("__repr__", [](const ast::Parameter& p) {
+        return fmt::format("Parameter({})", p.name);
+      });
+
   py::class_<ast::Predicate>(m, "Predicate")
       .def(py::init<const std::string&>(), "name"_a)
       .def_readonly("name", &ast::Predicate::name)
@@ -68,6 +78,11 @@ void init_ast_module(py::module& parent) {
       .def(py::self <= double())
       .def(py::self > double())
       .def(py::self >= double())
+      .def(py::self < ast::Parameter())
+      .def(py::self <= ast::Parameter())
+      .def(py::self > ast::Parameter())
+      .def(py::self >= ast::Parameter())
+      .def_readonly("param", &ast::Predicate::param)
       .def("__repr__", [](const ast::Predicate& e) { return fmt::format("{}", e); });
 
   py::class_<ast::Not, ast::NotPtr>(m, "Not")
@@ -130,4 +145,52 @@ void init_ast_module(py::module& parent) {
       .def("__or__", &or_op<ast::UntilPtr>)
       .def("__invert__", &not_op<ast::UntilPtr>)
       .def("__repr__", [](const ast::Until& e) { return fmt::format("{}", e); });
+
+  py::class_<ast::Historically, ast::HistoricallyPtr>(m, "Historically")
+      .def(
+          py::init<const Expr&, std::optional<ast::Interval>>(),
+          "arg"_a,
+          "interval"_a = std::nullopt)
+      .def_readonly("arg", &ast::Historically::arg)
+      .def_readonly("interval", &ast::Historically::interval)
+      .def("__and__", &and_op<ast::HistoricallyPtr>)
+      .def("__or__", &or_op<ast::HistoricallyPtr>)
+      .def("__invert__", &not_op<ast::HistoricallyPtr>)
+      .def("__repr__", [](const ast::Historically& e) { return fmt::format("{}", e); });
+
+  py::class_<ast::Once, ast::OncePtr>(m, "Once")
+      .def(
+          py::init<const Expr&, std::optional<ast::Interval>>(),
+          "arg"_a,
+          "interval"_a = std::nullopt)
+      .def_readonly("arg", &ast::Once::arg)
+      .def_readonly("interval", &ast::Once::interval)
+      .def("__and__", &and_op<ast::OncePtr>)
+      .def("__or__", &or_op<ast::OncePtr>)
+      .def("__invert__", &not_op<ast::OncePtr>)
+      .def("__repr__", [](const ast::Once& e) { return fmt::format("{}", e); });
+
+  py::class_<ast::Since, ast::SincePtr>(m, "Since")
+      .def(
+          py::init<const Expr&, const Expr&, std::optional<ast::Interval>>(),
+          "arg0"_a,
+          "arg1"_a,
+          "interval"_a = std::nullopt)
+      .def_readonly("args", &ast::Since::args)
+      .def_readonly("interval", &ast::Since::interval)
+      .def("__and__", &and_op<ast::SincePtr>)
+      .def("__or__", &or_op<ast::SincePtr>)
+      .def("__invert__", &not_op<ast::SincePtr>)
+      .def("__repr__", [](const ast::Since& e) { return fmt::format("{}", e); });
+
+  py::class_<ast::Horizon>(m, "Horizon")
+      .def_readonly("past", &ast::Horizon::past)
+      .def_readonly("future", &ast::Horizon::future)
+      .def("is_bounded", &ast::Horizon::is_bounded)
+      .def("__repr__", [](const ast::Horizon& h) {
+        return fmt::format("Horizon(past={}, future={})", h.past, h.future);
+      });
+  m.def("horizon", &ast::horizon, "phi"_a);
+  m.def("parameters", &ast::parameters, "phi"_a);
+  m.def("substitute", &ast::substitute, "phi"_a, "values"_a);
 }
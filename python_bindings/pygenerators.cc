@@ -0,0 +1,151 @@
+#include "bindings.hpp"             // for init_generators_module
+#include "signal_tl/ast.hpp"        // for Expr
+#include "signal_tl/generators.hpp" // for random_signal, random_formula, to_spec
+#include "signal_tl/signal.hpp"     // for Trace, SignalPtr
+
+#include <pybind11/cast.h>     // for operator""_a, arg
+#include <pybind11/pybind11.h> // for module, module_, gil_scoped_release
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <map>     // for map
+#include <string>  // for string
+#include <vector>  // for vector
+
+using namespace signal_tl;
+using namespace generators;
+
+namespace {
+
+SignalOptions signal_options(
+    size_t length,
+    double begin,
+    double period,
+    double jitter,
+    double crossings,
+    double amplitude,
+    double noise) {
+  auto options      = SignalOptions{};
+  options.length    = length;
+  options.begin     = begin;
+  options.period    = period;
+  options.jitter    = jitter;
+  options.crossings = crossings;
+  options.amplitude = amplitude;
+  options.noise     = noise;
+  return options;
+}
+
+} // namespace
+
+void init_generators_module(py::module& parent) {
+  auto m = parent.def_submodule(
+      "generators", "Random signals and formulas for benchmarks and stress tests");
+
+  m.def(
+      "random_signal",
+      [](size_t length,
+         double begin,
+         double period,
+         double jitter,
+         double crossings,
+         double amplitude,
+         double noise,
+         std::uint64_t seed) {
+        return random_signal(
+            signal_options(length, begin, period, jitter, crossings, amplitude, noise),
+            seed);
+      },
+      "length"_a    = 1000,
+      "begin"_a     = 0.0,
+      "period"_a    = 1.0,
+      "jitter"_a    = 0.0,
+      "crossings"_a = 0.1,
+      "amplitude"_a = 1.0,
+      "noise"_a     = 0.0,
+      "seed"_a      = 0,
+      py::call_guard<py::gil_scoped_release>(),
+      "Generate a piecewise-linear signal whose sign flips with probability "
+      "`crossings` between consecutive samples.");
+
+  m.def(
+      "random_trace",
+      [](const std::vector<std::string>& names,
+         size_t length,
+         double begin,
+         double period,
+         double jitter,
+         double crossings,
+         double amplitude,
+         double noise,
+         std::uint64_t seed) {
+        return random_trace(
+            names,
+            signal_options(length, begin, period, jitter, crossings, amplitude, noise),
+            seed);
+      },
+      "names"_a,
+      "length"_a    = 1000,
+      "begin"_a     = 0.0,
+      "period"_a    = 1.0,
+      "jitter"_a    = 0.0,
+      "crossings"_a = 0.1,
+      "amplitude"_a = 1.0,
+      "noise"_a     = 0.0,
+      "seed"_a      = 0,
+      py::call_guard<py::gil_scoped_release>(),
+      "Generate a trace with an independent random signal for each of `names`.");
+
+  m.def(
+      "random_formula",
+      [](const std::vector<std::string>& signals,
+         size_t depth,
+         double leaf_probability,
+         size_t fanout,
+         double min_threshold,
+         double max_threshold,
+         bool future,
+         bool past,
+         double bounded_probability,
+         double max_interval_start,
+         double mean_interval_width,
+         std::uint64_t seed) {
+        auto options                = FormulaOptions{};
+        options.signals             = signals;
+        options.depth               = depth;
+        options.leaf_probability    = leaf_probability;
+        options.fanout              = fanout;
+        options.min_threshold       = min_threshold;
+        options.max_threshold       = max_threshold;
+        options.future              = future;
+        options.past                = past;
+        options.bounded_probability = bounded_probability;
+        options.max_interval_start  = max_interval_start;
+        options.mean_interval_width = mean_interval_width;
+        return random_formula(options, seed);
+      },
+      "signals"_a             = std::vector<std::string>{"x"},
+      "depth"_a               = 4,
+      "leaf_probability"_a    = 0.2,
+      "fanout"_a              = 3,
+      "min_threshold"_a       = 0.0,
+      "max_threshold"_a       = 1.0,
+      "future"_a              = true,
+      "past"_a                = false,
+      "bounded_probability"_a = 0.5,
+      "max_interval_start"_a  = 5.0,
+      "mean_interval_width"_a = 10.0,
+      "seed"_a                = 0,
+      "Generate a random formula over the predicates on `signals`.");
+
+  m.def(
+      "to_spec",
+      py::overload_cast<const ast::Expr&>(&to_spec),
+      "phi"_a,
+      "Write `phi` in the syntax of the specification files.");
+  m.def(
+      "to_spec",
+      py::overload_cast<const std::map<std::string, ast::Expr>&>(&to_spec),
+      "assertions"_a,
+      "Write a specification file that asserts each of the named formulas.");
+}
@@ -1,32 +1,327 @@
-#include "bindings.hpp"             // for init_robustness_module
-#include "signal_tl/ast.hpp"        // for Expr, signal_tl
-#include "signal_tl/robustness.hpp" // for compute_robustness, semantics
-#include "signal_tl/signal.hpp"     // for Trace, signal
+#include "bindings.hpp"               // for init_robustness_module
+#include "signal_tl/ast.hpp"          // for Expr, signal_tl
+#include "signal_tl/mining.hpp"       // for mine_parameter, MiningOptions
+#include "signal_tl/online.hpp"       // for OnlineMonitor, AsyncMonitor
+#include "signal_tl/robustness.hpp"   // for compute_robustness, semantics
+#include "signal_tl/satisfaction.hpp" // for compute_satisfaction
+#include "signal_tl/signal.hpp"       // for Trace, signal
 
 #include "signal_tl/fmt.hpp" // IWYU pragma: keep
 
+#include "signal_tl/internal/parallel.hpp" // for parallel_for
+
 #include <pybind11/cast.h>          // for operator""_a, arg
 #include <pybind11/detail/common.h> // for constexpr_first, ignore_unused
 #include <pybind11/detail/descr.h>  // for operator+
-#include <pybind11/pybind11.h>      // for module, module_
-#include <pybind11/pytypes.h>       // for dict
+#include <pybind11/numpy.h>         // for array_t
+#include <pybind11/pybind11.h>      // for module, module_, gil_scoped_release
+#include <pybind11/pytypes.h>       // for dict, list, object
 
-#include <memory> // for shared_ptr
-#include <vector> // for vector
+#include <cstddef>   // for size_t
+#include <limits>    // for numeric_limits
+#include <map>       // for map
+#include <memory>    // for shared_ptr, make_shared
+#include <stdexcept> // for invalid_argument
+#include <string>    // for string
+#include <vector>    // for vector
 
 using namespace signal_tl;
 using namespace semantics;
 using namespace signal;
 
+namespace {
+
+/// Evaluate `phi` over all the `traces` on native threads.
+///
+/// If `return_signals` is `false`, only the robustness value at the start of each
+/// trace is returned (as a 1D NumPy array). Otherwise, a list of the full robustness
+/// signals is returned.
+py::object batch_robustness(
+    const ast::Expr& phi,
+    const std::vector<Trace>& traces,
+    size_t n_threads,
+    bool synchronized,
+    bool return_signals) {
+  auto robs = std::vector<SignalPtr>{};
+  {
+    py::gil_scoped_release release;
+    robs = compute_robustness_batch(phi, traces, n_threads, synchronized);
+  }
+
+  if (return_signals) {
+    return py::cast(robs);
+  }
+
+  auto out = py::array_t<double>(static_cast<py::ssize_t>(robs.size()));
+  auto buf = out.mutable_unchecked<1>();
+  for (size_t i = 0; i < robs.size(); i++) {
+    const auto& rob = robs[i];
+    buf(static_cast<py::ssize_t>(i)) =
+        (rob->empty()) ? std::numeric_limits<double>::quiet_NaN() : rob->front().value;
+  }
+  return std::move(out);
+}
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Evaluate `phi` over a stack of traces sampled on a shared time grid.
+///
+/// `data` has the shape `(n_traces, n_channels, n_steps)`, where `data[k, c, :]` are
+/// the values of the signal named `channels[c]` in the `k`th trace, at the time points
+/// in `times`. The traces are built and evaluated natively (one trace at a time per
+/// thread), so no per-trace Python objects are created.
+///
+/// The robustness of each trace is evaluated on the time grid, giving an array of
+/// shape `(n_traces, n_steps)`, or `(n_traces,)` with only the robustness at the first
+/// time point if `start_only` is `true`.
+py::array_t<double> stacked_robustness(
+    const ast::Expr& phi,
+    const DoubleArray& data,
+    const std::vector<std::string>& channels,
+    const DoubleArray& times,
+    size_t n_threads,
+    bool start_only) {
+  if (data.ndim() != 3) {
+    throw std::invalid_argument(
+        "Expected data of shape (n_traces, n_channels, n_steps).");
+  }
+  if (data.shape(2) == 0) {
+    throw std::invalid_argument("Expected at least one time step in the data.");
+  }
+  if (times.ndim() != 1 || times.shape(0) != data.shape(2)) {
+    throw std::invalid_argument(
+        "Expected the time vector to have n_steps elements, matching data.shape[2].");
+  }
+  if (static_cast<py::ssize_t>(channels.size()) != data.shape(1)) {
+    throw std::invalid_argument(
+        "Expected one channel name per channel, matching data.shape[1].");
+  }
+
+  const auto n_traces   = static_cast<size_t>(data.shape(0));
+  const auto n_channels = static_cast<size_t>(data.shape(1));
+  const auto n_steps    = static_cast<size_t>(data.shape(2));
+
+  auto out = (start_only) ? py::array_t<double>(static_cast<py::ssize_t>(n_traces))
+                          : py::array_t<double>(
+                                {static_cast<py::ssize_t>(n_traces),
+                                 static_cast<py::ssize_t>(n_steps)});
+
+  const double* values = data.data();
+  const double* ts     = times.data();
+  double* results      = out.mutable_data();
+  {
+    py::gil_scoped_release release;
+    parallel::parallel_for(n_traces, n_threads, [&](size_t k) {
+      auto trace = Trace{};
+      for (size_t c = 0; c < n_channels; c++) {
+        const double* xs = values + (k * n_channels + c) * n_steps;
+        auto sig         = std::make_shared<Signal>();
+        sig->reserve(n_steps);
+        for (size_t j = 0; j < n_steps; j++) { sig->push_back(ts[j], xs[j]); }
+        trace[channels[c]] = sig;
+      }
+
+      const auto rob = compute_robustness(phi, trace);
+      if (start_only) {
+        rob->interpolate_at(ts, ts + 1, results + k);
+      } else {
+        rob->interpolate_at(ts, ts + n_steps, results + k * n_steps);
+      }
+    });
+  }
+  return out;
+}
+
+MiningOptions
+mining_options(double lower, double upper, double tolerance, double time) {
+  auto options      = MiningOptions{};
+  options.lower     = lower;
+  options.upper     = upper;
+  options.tolerance = tolerance;
+  options.time      = time;
+  return options;
+}
+
+} // namespace
+
 void init_robustness_module(py::module& parent) {
   auto m = parent.def_submodule("semantics", "Robustness semantics for STL");
 
   m.def(
       "compute_robustness",
-      [](const ast::Expr& phi, const Trace& trace, bool synchronized) {
-        return compute_robustness(phi, trace, synchronized);
+      [](const ast::Expr& phi,
+         const Trace& trace,
+         bool synchronized,
+         double epsilon,
+         double begin,
+         double end) {
+        auto options         = RobustnessOptions{};
+        options.synchronized = synchronized;
+        options.epsilon      = epsilon;
+        options.query_begin  = begin;
+        options.query_end    = end;
+        return compute_robustness(phi, trace, options);
       },
       "phi"_a,
       "trace"_a,
-      "synchronized"_a = false);
+      "synchronized"_a = false,
+      "epsilon"_a      = 0.0,
+      "begin"_a        = -std::numeric_limits<double>::infinity(),
+      "end"_a          = std::numeric_limits<double>::infinity(),
+      py::call_guard<py::gil_scoped_release>());
+
+  m.def(
+      "compute_satisfaction",
+      &compute_satisfaction<double, double>,
+      "phi"_a,
+      "trace"_a,
+      py::call_guard<py::gil_scoped_release>(),
+      "Compute the set of times at which `trace` satisfies `phi`.");
+
+  m.def(
+      "compute_robustness_at",
+      &compute_robustness_at<double, double>,
+      "phi"_a,
+      "trace"_a,
+      "t0"_a = 0.0,
+      py::call_guard<py::gil_scoped_release>(),
+      "Compute the robustness of `phi` at the time `t0` only.");
+
+  m.def(
+      "compute_sign_at",
+      &compute_sign_at<double, double>,
+      "phi"_a,
+      "trace"_a,
+      "t0"_a = 0.0,
+      py::call_guard<py::gil_scoped_release>(),
+      "Compute the sign (-1, 0, or 1) of the robustness of `phi` at the time `t0`.");
+
+  m.def(
+      "compute_robustness_sweep",
+      [](const ast::Expr& phi,
+         const Trace& trace,
+         const std::vector<ast::ParameterValues>& grid,
+         double begin,
+         double end) {
+        auto options        = RobustnessOptions{};
+        options.query_begin = begin;
+        options.query_end   = end;
+        return compute_robustness_sweep(phi, trace, grid, options);
+      },
+      "phi"_a,
+      "trace"_a,
+      "grid"_a,
+      "begin"_a = -std::numeric_limits<double>::infinity(),
+      "end"_a   = std::numeric_limits<double>::infinity(),
+      py::call_guard<py::gil_scoped_release>(),
+      "Compute the robustness of the parametric formula `phi` for each assignment of "
+      "its parameters (a dict from names to values) in `grid`.");
+
+  m.def(
+      "monotonicity",
+      &monotonicity,
+      "phi"_a,
+      "param"_a,
+      "Whether the robustness of `phi` increases (1) or decreases (-1) with `param`.");
+
+  m.def(
+      "mine_parameter",
+      [](const ast::Expr& phi,
+         const std::string& param,
+         const Trace& trace,
+         double lower,
+         double upper,
+         double tolerance,
+         double time) {
+        return mine_parameter(
+            phi, param, trace, mining_options(lower, upper, tolerance, time));
+      },
+      "phi"_a,
+      "param"_a,
+      "trace"_a,
+      "lower"_a     = 0.0,
+      "upper"_a     = std::numeric_limits<double>::max(),
+      "tolerance"_a = 1e-6,
+      "time"_a      = 0.0,
+      py::call_guard<py::gil_scoped_release>(),
+      "Find the tightest value of `param` for which `trace` satisfies `phi`, or None.");
+
+  m.def(
+      "mine_parameter_batch",
+      [](const ast::Expr& phi,
+         const std::string& param,
+         const std::vector<Trace>& traces,
+         double lower,
+         double upper,
+         double tolerance,
+         double time,
+         size_t n_threads) {
+        const auto options = mining_options(lower, upper, tolerance, time);
+        return mine_parameter_batch(phi, param, traces, options, n_threads);
+      },
+      "phi"_a,
+      "param"_a,
+      "traces"_a,
+      "lower"_a     = 0.0,
+      "upper"_a     = std::numeric_limits<double>::max(),
+      "tolerance"_a = 1e-6,
+      "time"_a      = 0.0,
+      "n_threads"_a = 0,
+      py::call_guard<py::gil_scoped_release>(),
+      "Find the tightest value of `param` for each trace in `traces`, using native "
+      "threads.");
+
+  m.def(
+      "compute_robustness_batch",
+      &batch_robustness,
+      "phi"_a,
+      "traces"_a,
+      "n_threads"_a      = 0,
+      "synchronized"_a   = false,
+      "return_signals"_a = false,
+      "Compute the robustness of `phi` over many traces using native threads.");
+
+  m.def(
+      "compute_robustness_stacked",
+      &stacked_robustness,
+      "phi"_a,
+      "data"_a,
+      "channels"_a,
+      "times"_a,
+      "n_threads"_a  = 0,
+      "start_only"_a = false,
+      "Compute the robustness of `phi` over a (n_traces, n_channels, n_steps) array "
+      "of traces sampled on a shared time grid.");
+
+  py::class_<OnlineMonitor>(m, "OnlineMonitor")
+      .def(py::init<const ast::Expr&>(), "phi"_a)
+      .def_property_readonly("signals", &OnlineMonitor::signals)
+      .def(
+          "update",
+          py::overload_cast<double, const std::map<std::string, double>&>(
+              &OnlineMonitor::update),
+          "time"_a,
+          "values"_a,
+          "Feed the values of the signals at `time`, and return the robustness of "
+          "the (past-time) formula at `time`.");
+
+  py::class_<AsyncMonitor>(m, "AsyncMonitor")
+      .def(py::init<const ast::Expr&, double>(), "phi"_a, "lateness"_a = 0.0)
+      .def_property_readonly("signals", &AsyncMonitor::signals)
+      .def_property_readonly("watermark", &AsyncMonitor::watermark)
+      .def_property_readonly("dropped", &AsyncMonitor::dropped)
+      .def(
+          "push",
+          py::overload_cast<const std::string&, double, double>(&AsyncMonitor::push),
+          "name"_a,
+          "time"_a,
+          "value"_a,
+          "Buffer a sample of the channel `name`. Returns `False` if it is dropped.")
+      .def(
+          "heartbeat",
+          py::overload_cast<const std::string&, double>(&AsyncMonitor::heartbeat),
+          "name"_a,
+          "time"_a)
+      .def("poll", &AsyncMonitor::poll, "Evaluate the formula up to the safe time.")
+      .def("flush", &AsyncMonitor::flush, "Evaluate the formula at all pending times.");
 }
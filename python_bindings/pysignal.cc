@@ -1,58 +1,362 @@
-#include "bindings.hpp"         // for init_signal_module
-#include "signal_tl/ast.hpp"    // for signal_tl
-#include "signal_tl/fmt.hpp"    // IWYU pragma: keep
-#include "signal_tl/signal.hpp" // for Sample, Trace, Signal, SignalPtr
+#include "bindings.hpp"               // for init_signal_module
+#include "signal_tl/ast.hpp"          // for signal_tl
+#include "signal_tl/fmt.hpp"          // IWYU pragma: keep
+#include "signal_tl/interval_set.hpp" // for IntervalSet
+#include "signal_tl/range_index.hpp"  // for RangeIndex
+#include "signal_tl/signal.hpp"       // for Sample, Trace, Signal, SignalPtr
 
+#include <algorithm>                // for max
 #include <array>                    // for array
 #include <cstddef>                  // for size_t
+#include <cstring>                  // for memcpy
 #include <exception>                // for exception
 #include <fmt/format.h>             // for format
 #include <map>                      // for operator==, map, operator!=
-#include <memory>                   // for allocator, operator<<, __shared_...
+#include <memory>                   // for allocator, get_deleter, __shared_...
+#include <optional>                 // for optional
 #include <pybind11/attr.h>          // for buffer_protocol, keep_alive
 #include <pybind11/cast.h>          // for operator""_a, handle::cast, cast_op
 #include <pybind11/detail/common.h> // for ignore_unused, constexpr_first
 #include <pybind11/detail/descr.h>  // for operator+
+#include <pybind11/numpy.h>         // for array, array_t, dtype
 #include <pybind11/operators.h>     // for self, self_t, operator<, operator<=
 #include <pybind11/pybind11.h>      // for class_, init, make_iterator, mod...
 #include <pybind11/pytypes.h>       // for getattr, iterable, sequence, dict
 #include <pybind11/stl_bind.h>      // for bind_vector, bind_map
+#include <stdexcept>                // for invalid_argument
 #include <string>                   // for basic_string
+#include <utility>                  // for move
 #include <vector>                   // for vector
 
 using namespace signal_tl;
 
+namespace {
+using namespace signal;
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Build a Signal directly from two 1D float64 buffers.
+///
+/// Contiguous float64 arrays are read in place; anything else is converted once by
+/// NumPy (via `forcecast`) before being read.
+SignalPtr signal_from_numpy(
+    const DoubleArray& times,
+    const DoubleArray& values,
+    Interpolation interpolation) {
+  if (times.ndim() != 1 || values.ndim() != 1) {
+    throw std::invalid_argument("Expected 1-dimensional arrays for times and values.");
+  }
+  if (times.shape(0) != values.shape(0)) {
+    throw std::invalid_argument(
+        "Number of sample points and time points need to be equal.");
+  }
+
+  const auto n   = static_cast<size_t>(times.shape(0));
+  const auto* ts = times.data();
+  const auto* vs = values.data();
+
+  auto sig = std::make_shared<Signal>(interpolation);
+  sig->reserve(n);
+  {
+    py::gil_scoped_release release;
+    for (size_t i = 0; i < n; i++) { sig->push_back(ts[i], vs[i]); }
+  }
+  return sig;
+}
+
+/// Create a read-only NumPy view over one field of the samples in the signal.
+///
+/// The view is strided over the array of `Sample`s and keeps the signal alive for as
+/// long as the array exists.
+py::array sample_field_view(const SignalPtr& sig, double Sample::*field) {
+  const auto n        = static_cast<py::ssize_t>(sig->size());
+  const double* start = (sig->empty()) ? nullptr : &(sig->data()->*field);
+
+  auto arr = py::array(
+      py::dtype::of<double>(),
+      {n},
+      {static_cast<py::ssize_t>(sizeof(Sample))},
+      start,
+      py::cast(sig));
+  auto* proxy = py::detail::array_proxy(arr.ptr());
+  proxy->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+  return arr;
+}
+
+/// A `multiprocessing.shared_memory.SharedMemory` block that signals borrow their
+/// samples from.
+///
+/// The exported buffer of the block is held for as long as any signal uses it, so
+/// the block cannot be closed from Python while it is in use.
+struct SharedMemoryBlock {
+  py::object shm;
+  py::buffer_info buffer;
+  std::string name;
+  const Sample* base;
+
+  /// Deleter for the storage of the signals backed by the block.
+  ///
+  /// The Python objects must be released with the GIL held, and the last reference to
+  /// a signal may be dropped from a native worker thread.
+  struct Deleter {
+    SharedMemoryBlock* block;
+
+    void operator()(const Sample*) const {
+      py::gil_scoped_acquire gil;
+      delete block; // NOLINT(cppcoreguidelines-owning-memory)
+    }
+  };
+};
+
+/// Get the shared memory block backing a signal, or `nullptr` if there is none.
+const SharedMemoryBlock* shared_memory_block(const SignalPtr& sig) {
+  const auto* deleter =
+      std::get_deleter<SharedMemoryBlock::Deleter>(sig->borrowed_storage());
+  return (deleter == nullptr) ? nullptr : deleter->block;
+}
+
+/// Create a signal that borrows `n` samples starting at sample `offset` in the
+/// `SharedMemory` block `shm`.
+SignalPtr attach_shared_memory(
+    py::object shm,
+    size_t offset,
+    size_t n,
+    Interpolation interpolation) {
+  auto buffer        = py::buffer(shm.attr("buf")).request();
+  const auto n_bytes = static_cast<size_t>(buffer.size * buffer.itemsize);
+  if ((offset + n) * sizeof(Sample) > n_bytes) {
+    throw std::invalid_argument(
+        "Shared memory block is too small for the requested number of samples.");
+  }
+
+  const auto* base = static_cast<const Sample*>(buffer.ptr);
+  auto name        = shm.attr("name").cast<std::string>();
+
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  auto* block  = new SharedMemoryBlock{std::move(shm), std::move(buffer), name, base};
+  auto storage = std::shared_ptr<const Sample>(base, SharedMemoryBlock::Deleter{block});
+  return std::make_shared<Signal>(
+      std::shared_ptr<const Sample>(storage, base + offset), n, interpolation);
+}
+
+/// Copy the samples of the signal into a new shared memory block, and return a
+/// signal backed by the block.
+SignalPtr signal_to_shared_memory(
+    const SignalPtr& sig,
+    const std::optional<std::string>& name) {
+  const auto shared_memory = py::module::import("multiprocessing.shared_memory");
+
+  // NOTE: A SharedMemory block cannot be empty.
+  const size_t n_bytes = sig->size() * sizeof(Sample);
+  auto shm             = shared_memory.attr("SharedMemory")(
+      "name"_a = name, "create"_a = true, "size"_a = std::max<size_t>(n_bytes, 1));
+  {
+    auto buffer = py::buffer(shm.attr("buf")).request(true);
+    std::memcpy(buffer.ptr, sig->data(), n_bytes);
+  }
+  return attach_shared_memory(std::move(shm), 0, sig->size(), sig->interpolation());
+}
+
+/// Attach to the existing shared memory block called `name`, and return a signal
+/// borrowing `size` samples from it, starting at sample `offset`.
+SignalPtr signal_from_shared_memory(
+    const std::string& name,
+    size_t size,
+    size_t offset,
+    Interpolation interpolation) {
+  const auto shared_memory = py::module::import("multiprocessing.shared_memory");
+  auto shm                 = shared_memory.attr("SharedMemory")("name"_a = name);
+
+  // NOTE: Before Python 3.13, attaching to a block registers it with the resource
+  // tracker, which unlinks it when the attaching process (e.g., a worker) exits. Only
+  // the process that created the block should unlink it.
+  try {
+    py::module::import("multiprocessing.resource_tracker")
+        .attr("unregister")(shm.attr("_name"), "shared_memory");
+  } catch (const py::error_already_set&) {
+    // The resource tracker is not used on this platform.
+  }
+
+  return attach_shared_memory(std::move(shm), offset, size, interpolation);
+}
+
+/// Pickle a signal.
+///
+/// Signals backed by shared memory are pickled as a handle to the block, and all other
+/// signals as the raw bytes of their samples.
+py::tuple signal_getstate(const SignalPtr& sig) {
+  if (const auto* block = shared_memory_block(sig)) {
+    const auto offset = static_cast<size_t>(sig->data() - block->base);
+    return py::make_tuple(
+        "shm", block->name, offset, sig->size(), sig->interpolation());
+  }
+  return py::make_tuple(
+      "samples",
+      py::bytes(
+          reinterpret_cast<const char*>(sig->data()), // NOLINT
+          sig->size() * sizeof(Sample)),
+      sig->interpolation());
+}
+
+SignalPtr signal_setstate(const py::tuple& state) {
+  const auto kind = state[0].cast<std::string>();
+  if (kind == "shm" && state.size() == 5) {
+    return signal_from_shared_memory(
+        state[1].cast<std::string>(),
+        state[3].cast<size_t>(),
+        state[2].cast<size_t>(),
+        state[4].cast<Interpolation>());
+  } else if (kind == "samples" && state.size() == 3) {
+    const auto bytes = state[1].cast<std::string>();
+    auto samples     = std::vector<Sample>(bytes.size() / sizeof(Sample));
+    std::memcpy(samples.data(), bytes.data(), samples.size() * sizeof(Sample));
+    return std::make_shared<Signal>(samples, state[2].cast<Interpolation>());
+  }
+  throw std::invalid_argument("Invalid state for unpickling a Signal");
+}
+
+py::list trace_getstate(const Trace& trace) {
+  auto state = py::list{};
+  for (const auto& [name, sig] : trace) { state.append(py::make_tuple(name, sig)); }
+  return state;
+}
+
+Trace trace_setstate(const py::list& state) {
+  auto trace = Trace{};
+  for (const auto& item : state) {
+    const auto entry = item.cast<py::tuple>();
+    const auto name  = entry[0].cast<std::string>();
+    trace[name]      = entry[1].cast<SignalPtr>();
+  }
+  return trace;
+}
+
+} // namespace
+
 void init_signal_module(py::module& parent) {
   using namespace signal;
 
   auto m = parent.def_submodule("signal", "A general class of signals (PWL, etc.)");
   py::bind_vector<std::vector<double>>(m, "DoubleList", py::buffer_protocol());
   py::bind_vector<std::vector<Sample>>(m, "SampleList");
-  py::bind_map<Trace>(m, "Trace").def(py::init<const Trace&>(), "other"_a);
+  py::bind_map<Trace>(m, "Trace")
+      .def(py::init<const Trace&>(), "other"_a)
+      .def(
+          "to_shared_memory",
+          [](const Trace& trace) {
+            auto out = Trace{};
+            for (const auto& [name, sig] : trace) {
+              out[name] = signal_to_shared_memory(sig, std::nullopt);
+            }
+            return out;
+          },
+          "Copy every signal in the trace into its own shared memory block.")
+      .def(py::pickle(&trace_getstate, &trace_setstate));
+
+  py::enum_<Interpolation>(m, "Interpolation")
+      .value("Linear", Interpolation::Linear)
+      .value("Step", Interpolation::Step);
 
   py::class_<Sample>(m, "Sample")
       .def(py::init())
       .def_readonly("time", &Sample::time)
       .def_readonly("value", &Sample::value)
-      .def_readonly("derivative", &Sample::value)
+      .def_readonly("derivative", &Sample::derivative)
       .def(py::self < py::self)
       .def(py::self > py::self)
       .def(py::self >= py::self)
       .def(py::self <= py::self)
       .def("__repr__", [](const Sample& e) { return fmt::format("{}", e); });
 
+  using SignalSummary = BasicSignalSummary<double, double>;
+  py::class_<SignalSummary>(m, "SignalSummary")
+      .def_readonly("min", &SignalSummary::min)
+      .def_readonly("max", &SignalSummary::max)
+      .def_readonly("argmin", &SignalSummary::argmin)
+      .def_readonly("argmax", &SignalSummary::argmax)
+      .def_readonly("nondecreasing", &SignalSummary::nondecreasing)
+      .def_readonly("nonincreasing", &SignalSummary::nonincreasing)
+      .def_readonly("uniform", &SignalSummary::uniform);
+
+  py::class_<RangeIndex, std::shared_ptr<RangeIndex>>(m, "RangeIndex")
+      .def("__len__", &RangeIndex::size)
+      .def("min", &RangeIndex::min, "start"_a, "end"_a)
+      .def("max", &RangeIndex::max, "start"_a, "end"_a)
+      .def("memory_usage", &RangeIndex::memory_usage);
+
+  py::class_<IntervalSet>(m, "IntervalSet")
+      .def(py::init<>())
+      .def(
+          py::init<const std::vector<IntervalSet::interval_type>&>(), "intervals"_a)
+      .def("__len__", &IntervalSet::size)
+      .def(
+          "__iter__",
+          [](const IntervalSet& s) { return py::make_iterator(s.begin(), s.end()); },
+          py::keep_alive<0, 1>())
+      .def("__contains__", &IntervalSet::contains, "t"_a)
+      .def("measure", &IntervalSet::measure)
+      .def("unite", &IntervalSet::unite, "other"_a)
+      .def("intersect", &IntervalSet::intersect, "other"_a)
+      .def("complement", &IntervalSet::complement, "lo"_a, "hi"_a)
+      .def("clip", &IntervalSet::clip, "lo"_a, "hi"_a)
+      .def(py::self == py::self)
+      .def(py::self != py::self)
+      .def("__repr__", [](const IntervalSet& s) {
+        auto parts = std::vector<std::string>{};
+        for (const auto& [lo, hi] : s) {
+          parts.push_back(fmt::format("[{}, {}]", lo, hi));
+        }
+        return fmt::format("IntervalSet({})", fmt::join(parts, ", "));
+      });
+
   py::class_<Signal, std::shared_ptr<Signal>>(m, "Signal")
       .def(py::init<>())
       .def(py::init<const Signal&>(), "other"_a)
-      .def(py::init<const std::vector<Sample>&>())
       .def(
-          py::init<const std::vector<double>&, const std::vector<double>&>(),
+          py::init<const std::vector<Sample>&, Interpolation>(),
+          "samples"_a,
+          "interpolation"_a = Interpolation::Linear)
+      .def(
+          py::init<
+              const std::vector<double>&,
+              const std::vector<double>&,
+              Interpolation>(),
           "points"_a,
-          "times"_a)
+          "times"_a,
+          "interpolation"_a = Interpolation::Linear)
+      .def_static(
+          "from_numpy",
+          &signal_from_numpy,
+          "times"_a,
+          "values"_a,
+          "interpolation"_a = Interpolation::Linear)
+      .def_property_readonly("interpolation", &Signal::interpolation)
+      .def_property_readonly(
+          "times", [](const SignalPtr& s) { return sample_field_view(s, &Sample::time); })
+      .def_property_readonly(
+          "values",
+          [](const SignalPtr& s) { return sample_field_view(s, &Sample::value); })
+      .def_property_readonly(
+          "derivatives",
+          [](const SignalPtr& s) { return sample_field_view(s, &Sample::derivative); })
       .def_property_readonly("begin_time", &Signal::begin_time)
       .def_property_readonly("end_time", &Signal::end_time)
-      .def("simplify", &Signal::simplify)
+      .def("simplify", py::overload_cast<>(&Signal::simplify, py::const_))
+      .def(
+          "simplify",
+          py::overload_cast<double>(&Signal::simplify, py::const_),
+          "epsilon"_a,
+          "Approximate the signal with fewer samples, within `epsilon` of the signal.")
+      .def("summary", &Signal::summary)
+      .def(
+          "range_index",
+          [](const Signal& sig) {
+            // The index is immutable, but Python has no notion of const objects.
+            return std::const_pointer_cast<RangeIndex>(sig.range_index());
+          },
+          "Get the range min/max index of the signal, building it if needed.")
       .def("resize", &Signal::resize, "start"_a, "end"_a, "fill"_a)
+      .def("slice", &Signal::slice, "start"_a, "end"_a)
       .def("shift", &Signal::shift, "dt"_a)
       .def("__repr__", [](const Signal& e) { return fmt::format("{}", e); })
       .def(
@@ -63,6 +367,29 @@ void init_signal_module(py::module& parent) {
           "__getitem__",
           [](const SignalPtr& s, size_t i) { return s->at_idx(i).value; })
       .def("__len__", &Signal::size)
+      .def(
+          "to_shared_memory",
+          &signal_to_shared_memory,
+          "name"_a = std::nullopt,
+          "Copy the samples into a new shared memory block, and return a signal "
+          "backed by the block.")
+      .def_static(
+          "from_shared_memory",
+          &signal_from_shared_memory,
+          "name"_a,
+          "size"_a,
+          "offset"_a        = 0,
+          "interpolation"_a = Interpolation::Linear,
+          "Attach (read-only) to `size` samples in an existing shared memory block.")
+      .def_property_readonly(
+          "shared_memory",
+          [](const SignalPtr& s) -> py::object {
+            if (const auto* block = shared_memory_block(s)) {
+              return block->shm;
+            }
+            return py::none();
+          })
+      .def(py::pickle(&signal_getstate, &signal_setstate))
       .def("at", [](const SignalPtr& s, double t) { return s->at(t).value; });
 
   m.def("synchronize", &synchronize, "x"_a, "y"_a);
@@ -14,4 +14,5 @@ PYBIND11_MODULE(_cext, m) { // NOLINT
   init_ast_module(m);
   init_signal_module(m);
   init_robustness_module(m);
+  init_generators_module(m);
 }
@@ -2,14 +2,21 @@ __version__ = "0.1.4-dev55+9d981d4"
 
 # isort: split
 
-from signal_tl._cext import (Always, And, Const, Eventually, Not, Or,
-                             Predicate, Until)
-from signal_tl._cext.semantics import compute_robustness
-from signal_tl._cext.signal import Sample, Signal, Trace, synchronize
+from signal_tl._cext import (Always, And, Const, Eventually, Historically,
+                             Not, Once, Or, Predicate, Since, Until,
+                             generators)
+from signal_tl._cext.semantics import (compute_robustness,
+                                        compute_robustness_batch,
+                                        compute_robustness_stacked)
+from signal_tl._cext.signal import (Interpolation, Sample, Signal, Trace,
+                                     synchronize)
 
 F = Eventually
 G = Always
 U = Until
+H = Historically
+O = Once
+S = Since
 
 TOP = Const(True)
 BOT = Const(False)
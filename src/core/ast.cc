@@ -1,8 +1,14 @@
 #include "signal_tl/ast.hpp"
 #include "signal_tl/internal/utils.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <variant>
 
 namespace signal_tl {
 
@@ -24,6 +30,22 @@ Predicate operator<=(const Predicate& lhs, const double bound) {
   return Predicate{lhs.name, ComparisonOp::LE, bound};
 }
 
+Predicate operator>(const Predicate& lhs, const Parameter& bound) {
+  return Predicate{lhs.name, ComparisonOp::GT, bound};
+}
+
+Predicate operator>=(const Predicate& lhs, const Parameter& bound) {
+  return Predicate{lhs.name, ComparisonOp::GE, bound};
+}
+
+Predicate operator<(const Predicate& lhs, const Parameter& bound) {
+  return Predicate{lhs.name, ComparisonOp::LT, bound};
+}
+
+Predicate operator<=(const Predicate& lhs, const Parameter& bound) {
+  return Predicate{lhs.name, ComparisonOp::LE, bound};
+}
+
 using utils::overloaded;
 
 namespace {
@@ -97,6 +119,189 @@ Expr operator~(const Expr& expr) {
   return std::make_shared<Not>(expr);
 }
 
+Horizon horizon(const Expr& phi) {
+  // The formula holds at `t` depending on its operands over `[t + a, t + b]`.
+  const auto shifted = [](const Horizon& h, const Interval& interval) {
+    const auto [a, b] = interval.as_double();
+    return Horizon{std::max(h.past - a, 0.0), h.future + b};
+  };
+  // The past-time operators depend on their operands over `[t - b, t - a]`.
+  const auto shifted_past = [](const Horizon& h, const Interval& interval) {
+    const auto [a, b] = interval.as_double();
+    return Horizon{h.past + b, std::max(h.future - a, 0.0)};
+  };
+  const auto max_of = [](const Horizon& lhs, const Horizon& rhs) {
+    return Horizon{std::max(lhs.past, rhs.past), std::max(lhs.future, rhs.future)};
+  };
+
+  return std::visit(
+      utils::overloaded{
+          [](const Const&) { return Horizon{}; },
+          [](const Predicate&) { return Horizon{}; },
+          [](const NotPtr& e) { return horizon(e->arg); },
+          [&](const AndPtr& e) {
+            auto out = Horizon{};
+            for (const auto& arg : e->args) { out = max_of(out, horizon(arg)); }
+            return out;
+          },
+          [&](const OrPtr& e) {
+            auto out = Horizon{};
+            for (const auto& arg : e->args) { out = max_of(out, horizon(arg)); }
+            return out;
+          },
+          [&](const AlwaysPtr& e) { return shifted(horizon(e->arg), e->interval); },
+          [&](const EventuallyPtr& e) {
+            return shifted(horizon(e->arg), e->interval);
+          },
+          [&](const UntilPtr& e) {
+            // The left operand is needed from `t` on, and the right one in the window.
+            const double b = e->interval.as_double().second;
+            const auto lhs = horizon(e->args.first);
+            const auto rhs = horizon(e->args.second);
+            return max_of(
+                Horizon{lhs.past, lhs.future + b}, shifted(rhs, e->interval));
+          },
+          [&](const HistoricallyPtr& e) {
+            return shifted_past(horizon(e->arg), e->interval);
+          },
+          [&](const OncePtr& e) { return shifted_past(horizon(e->arg), e->interval); },
+          [&](const SincePtr& e) {
+            // The left operand is needed up to `t`, and the right one in the window.
+            const double b = e->interval.as_double().second;
+            const auto lhs = horizon(e->args.first);
+            const auto rhs = horizon(e->args.second);
+            return max_of(
+                Horizon{lhs.past + b, lhs.future}, shifted_past(rhs, e->interval));
+          }},
+      phi);
+}
+
+std::set<std::string> parameters(const Expr& phi) {
+  auto out       = std::set<std::string>{};
+  const auto add = [&out](const std::string& name) {
+    if (!name.empty()) {
+      out.insert(name);
+    }
+  };
+  const auto add_interval = [&](const Interval& interval) {
+    add(interval.low_param);
+    add(interval.high_param);
+  };
+  const auto add_all = [&out](const Expr& e) { out.merge(parameters(e)); };
+
+  std::visit(
+      utils::overloaded{
+          [](const Const&) {},
+          [&](const Predicate& e) { add(e.param); },
+          [&](const NotPtr& e) { add_all(e->arg); },
+          [&](const AndPtr& e) {
+            for (const auto& arg : e->args) { add_all(arg); }
+          },
+          [&](const OrPtr& e) {
+            for (const auto& arg : e->args) { add_all(arg); }
+          },
+          [&](const AlwaysPtr& e) {
+            add_all(e->arg);
+            add_interval(e->interval);
+          },
+          [&](const EventuallyPtr& e) {
+            add_all(e->arg);
+            add_interval(e->interval);
+          },
+          [&](const UntilPtr& e) {
+            add_all(e->args.first);
+            add_all(e->args.second);
+            add_interval(e->interval);
+          },
+          [&](const HistoricallyPtr& e) {
+            add_all(e->arg);
+            add_interval(e->interval);
+          },
+          [&](const OncePtr& e) {
+            add_all(e->arg);
+            add_interval(e->interval);
+          },
+          [&](const SincePtr& e) {
+            add_all(e->args.first);
+            add_all(e->args.second);
+            add_interval(e->interval);
+          }},
+      phi);
+  return out;
+}
+
+Expr substitute(const Expr& phi, const ParameterValues& values) {
+  const auto value_of = [&values](const std::string& name, double default_value) {
+    const auto it = values.find(name);
+    return (name.empty() || it == values.end()) ? default_value : it->second;
+  };
+  const auto bind = [&](const Interval& interval) {
+    if (!interval.is_parametric()) {
+      return interval;
+    }
+    const auto [a0, b0] = interval.as_double();
+    const double a      = value_of(interval.low_param, a0);
+    const double b      = value_of(interval.high_param, b0);
+    if (a < 0 || b < 0) {
+      throw std::invalid_argument("Interval cannot have negative values");
+    } else if (b < a) {
+      throw std::invalid_argument("Interval [a,b] cannot have b < a");
+    }
+    // `[a, a]` is a valid binding of a parametric interval.
+    auto out = Interval{};
+    out.low  = a;
+    out.high = b;
+    return out;
+  };
+  const auto all = [&](const std::vector<Expr>& args) {
+    auto out = std::vector<Expr>{};
+    out.reserve(args.size());
+    for (const auto& arg : args) { out.push_back(substitute(arg, values)); }
+    return out;
+  };
+
+  return std::visit(
+      utils::overloaded{
+          [](const Const& e) -> Expr { return e; },
+          [&](const Predicate& e) -> Expr {
+            return Predicate{e.name, e.op, value_of(e.param, e.rhs)};
+          },
+          [&](const NotPtr& e) -> Expr {
+            return std::make_shared<Not>(substitute(e->arg, values));
+          },
+          [&](const AndPtr& e) -> Expr { return std::make_shared<And>(all(e->args)); },
+          [&](const OrPtr& e) -> Expr { return std::make_shared<Or>(all(e->args)); },
+          [&](const AlwaysPtr& e) -> Expr {
+            return std::make_shared<Always>(
+                substitute(e->arg, values), bind(e->interval));
+          },
+          [&](const EventuallyPtr& e) -> Expr {
+            return std::make_shared<Eventually>(
+                substitute(e->arg, values), bind(e->interval));
+          },
+          [&](const UntilPtr& e) -> Expr {
+            return std::make_shared<Until>(
+                substitute(e->args.first, values),
+                substitute(e->args.second, values),
+                bind(e->interval));
+          },
+          [&](const HistoricallyPtr& e) -> Expr {
+            return std::make_shared<Historically>(
+                substitute(e->arg, values), bind(e->interval));
+          },
+          [&](const OncePtr& e) -> Expr {
+            return std::make_shared<Once>(
+                substitute(e->arg, values), bind(e->interval));
+          },
+          [&](const SincePtr& e) -> Expr {
+            return std::make_shared<Since>(
+                substitute(e->args.first, values),
+                substitute(e->args.second, values),
+                bind(e->interval));
+          }},
+      phi);
+}
+
 } // namespace ast
 
 ast::Const Const(bool value) {
@@ -158,4 +363,28 @@ Expr Until(Expr arg1, Expr arg2, ast::Interval interval) {
   return std::make_shared<ast::Until>(std::move(arg1), std::move(arg2), interval);
 }
 
+Expr Historically(Expr arg) {
+  return std::make_shared<ast::Historically>(std::move(arg));
+}
+
+Expr Historically(Expr arg, ast::Interval interval) {
+  return std::make_shared<ast::Historically>(std::move(arg), interval);
+}
+
+Expr Once(Expr arg) {
+  return std::make_shared<ast::Once>(std::move(arg));
+}
+
+Expr Once(Expr arg, ast::Interval interval) {
+  return std::make_shared<ast::Once>(std::move(arg), interval);
+}
+
+Expr Since(Expr arg1, Expr arg2) {
+  return std::make_shared<ast::Since>(std::move(arg1), std::move(arg2));
+}
+
+Expr Since(Expr arg1, Expr arg2, ast::Interval interval) {
+  return std::make_shared<ast::Since>(std::move(arg1), std::move(arg2), interval);
+}
+
 } // namespace signal_tl
@@ -0,0 +1,296 @@
+#include "signal_tl/compressed.hpp" // for CompressedSignal
+#include "signal_tl/signal.hpp"     // for Sample, Signal, SignalPtr
+
+#include <algorithm>    // for min, upper_bound
+#include <cstdint>      // for uint64_t, int64_t
+#include <cstring>      // for memcpy
+#include <fmt/format.h> // for format
+#include <iterator>     // for prev
+#include <memory>       // for make_shared
+#include <stdexcept>    // for invalid_argument, out_of_range
+#include <utility>      // for move
+#include <vector>       // for vector
+
+namespace signal_tl::signal {
+
+namespace {
+
+std::uint64_t to_bits(double x) {
+  std::uint64_t out = 0;
+  std::memcpy(&out, &x, sizeof(out));
+  return out;
+}
+
+double from_bits(std::uint64_t x) {
+  double out = 0;
+  std::memcpy(&out, &x, sizeof(out));
+  return out;
+}
+
+constexpr std::uint64_t mask(unsigned n) {
+  return (n >= 64) ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1;
+}
+
+unsigned leading_zeros(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (x == 0) ? 64 : static_cast<unsigned>(__builtin_clzll(x));
+#else
+  unsigned n = 0;
+  for (auto bit = std::uint64_t{1} << 63; bit != 0 && (x & bit) == 0; bit >>= 1) {
+    n++;
+  }
+  return n;
+#endif
+}
+
+unsigned trailing_zeros(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (x == 0) ? 64 : static_cast<unsigned>(__builtin_ctzll(x));
+#else
+  unsigned n = 0;
+  for (auto bit = std::uint64_t{1}; bit != 0 && (x & bit) == 0; bit <<= 1) { n++; }
+  return n;
+#endif
+}
+
+/// Map signed integers (in two's complement) to unsigned ones, such that numbers with
+/// small magnitude have few significant bits.
+constexpr std::uint64_t zigzag(std::uint64_t x) {
+  return (x << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(x) >> 63);
+}
+
+constexpr std::uint64_t unzigzag(std::uint64_t x) {
+  return (x >> 1) ^ (~(x & 1) + 1);
+}
+
+/// Append the lowest `n` bits of `bits` (most significant first) to a bit stream.
+void write_bits(
+    std::vector<std::uint64_t>& words,
+    size_t& n_bits,
+    std::uint64_t bits,
+    unsigned n) {
+  bits &= mask(n);
+  while (n > 0) {
+    if (n_bits % 64 == 0) {
+      words.push_back(0);
+    }
+    const auto free = static_cast<unsigned>(64 - n_bits % 64);
+    const auto k    = std::min(free, n);
+    words.back() |= ((bits >> (n - k)) & mask(k)) << (free - k);
+    n_bits += k;
+    n -= k;
+  }
+}
+
+struct BitReader {
+  const std::vector<std::uint64_t>& words;
+  size_t pos = 0;
+
+  std::uint64_t read(unsigned n) {
+    std::uint64_t out = 0;
+    while (n > 0) {
+      const auto offset = static_cast<unsigned>(pos % 64);
+      const auto avail  = 64 - offset;
+      const auto k      = std::min(avail, n);
+      const auto chunk  = (words[pos / 64] >> (avail - k)) & mask(k);
+      out               = (k == 64) ? chunk : (out << k) | chunk;
+      pos += k;
+      n -= k;
+    }
+    return out;
+  }
+};
+
+// Bucket sizes for the zigzag-encoded delta-of-delta of the timestamps, and the
+// number of bits of the prefix ('10', '110', '1110', '1111') selecting the bucket.
+constexpr unsigned DOD_BITS[] = {7, 9, 12, 64};
+
+} // namespace
+
+CompressedSignal::CompressedSignal(
+    Interpolation interpolation,
+    size_t samples_per_block) :
+    block_size{std::max<size_t>(samples_per_block, 1)}, interp{interpolation} {}
+
+CompressedSignal::CompressedSignal(const Signal& sig, size_t samples_per_block) :
+    CompressedSignal(sig.interpolation(), samples_per_block) {
+  for (const auto& s : sig) { this->push_back(s.time, s.value); }
+}
+
+void CompressedSignal::push_back(double time, double value) {
+  if (!this->empty() && time <= this->end_time()) {
+    throw std::invalid_argument(fmt::format(
+        "Trying to append a Sample timestamped at or before the Signal end_time,"
+        "i.e., time is not strictly monotonically increasing."
+        "Current end_time is {}, given time is {}.",
+        this->end_time(),
+        time));
+  }
+  this->n_samples++;
+
+  auto& enc = this->encoder;
+  if (this->blocks.empty() || this->blocks.back().size == this->block_size) {
+    if (!this->blocks.empty()) {
+      this->blocks.back().words.shrink_to_fit();
+    }
+    auto block        = Block{};
+    block.begin_time  = time;
+    block.end_time    = time;
+    block.first_value = value;
+    block.size        = 1;
+    this->blocks.push_back(std::move(block));
+    this->block_times.push_back(time);
+    enc = Encoder{to_bits(time), 0, to_bits(value), 0, 0};
+    return;
+  }
+
+  auto& block = this->blocks.back();
+  auto& words = block.words;
+  auto& n     = block.n_bits;
+
+  // Timestamp: delta-of-delta of the bit patterns.
+  const auto time_bits = to_bits(time);
+  const auto delta     = time_bits - enc.time_bits;
+  const auto dod       = zigzag(delta - enc.delta);
+  if (dod == 0) {
+    write_bits(words, n, 0b0, 1);
+  } else {
+    unsigned bucket = 0;
+    while (bucket < 3 && dod > mask(DOD_BITS[bucket])) { bucket++; }
+    // Prefix of `bucket + 1` ones (at most 4), followed by a zero if not the last.
+    const unsigned prefix_len = (bucket < 3) ? bucket + 2 : 4;
+    const auto prefix         = (bucket < 3) ? mask(bucket + 1) << 1 : mask(4);
+    write_bits(words, n, prefix, prefix_len);
+    write_bits(words, n, dod, DOD_BITS[bucket]);
+  }
+  enc.time_bits = time_bits;
+  enc.delta     = delta;
+
+  // Value: XOR with the previous value.
+  const auto value_bits = to_bits(value);
+  const auto xored      = value_bits ^ enc.value_bits;
+  if (xored == 0) {
+    write_bits(words, n, 0b0, 1);
+  } else {
+    const unsigned leading  = std::min(leading_zeros(xored), 31U);
+    const unsigned trailing = trailing_zeros(xored);
+    if (enc.leading + enc.trailing > 0 && leading >= enc.leading &&
+        trailing >= enc.trailing) {
+      // The meaningful bits fit in the window of the previous value.
+      write_bits(words, n, 0b10, 2);
+      write_bits(words, n, xored >> enc.trailing, 64 - enc.leading - enc.trailing);
+    } else {
+      const unsigned length = 64 - leading - trailing;
+      write_bits(words, n, 0b11, 2);
+      write_bits(words, n, leading, 5);
+      write_bits(words, n, length - 1, 6);
+      write_bits(words, n, xored >> trailing, length);
+      enc.leading  = leading;
+      enc.trailing = trailing;
+    }
+  }
+  enc.value_bits = value_bits;
+
+  block.end_time = time;
+  block.size++;
+}
+
+size_t CompressedSignal::memory_usage() const {
+  size_t bytes = sizeof(*this) + this->block_times.capacity() * sizeof(double) +
+                 this->blocks.capacity() * sizeof(Block);
+  for (const auto& block : this->blocks) {
+    bytes += block.words.capacity() * sizeof(std::uint64_t);
+  }
+  return bytes;
+}
+
+size_t CompressedSignal::find_block(double t) const {
+  const auto it =
+      std::upper_bound(this->block_times.begin(), this->block_times.end(), t);
+  return (it == this->block_times.begin())
+             ? 0
+             : static_cast<size_t>(std::prev(it) - this->block_times.begin());
+}
+
+void CompressedSignal::decode_block(size_t i, std::vector<Sample>& out) const {
+  const auto& block = this->blocks.at(i);
+  out.clear();
+  out.reserve(block.size);
+
+  auto reader         = BitReader{block.words};
+  auto time_bits      = to_bits(block.begin_time);
+  auto value_bits     = to_bits(block.first_value);
+  std::uint64_t delta = 0;
+  unsigned leading = 0, trailing = 0;
+  out.push_back(Sample{block.begin_time, block.first_value, 0.0});
+  for (size_t k = 1; k < block.size; k++) {
+    if (reader.read(1) != 0) {
+      unsigned bucket = 0;
+      while (bucket < 3 && reader.read(1) != 0) { bucket++; }
+      delta += unzigzag(reader.read(DOD_BITS[bucket]));
+    }
+    time_bits += delta;
+
+    if (reader.read(1) != 0) {
+      if (reader.read(1) != 0) {
+        leading  = static_cast<unsigned>(reader.read(5));
+        trailing = 64 - leading - (static_cast<unsigned>(reader.read(6)) + 1);
+      }
+      value_bits ^= reader.read(64 - leading - trailing) << trailing;
+    }
+    out.push_back(Sample{from_bits(time_bits), from_bits(value_bits), 0.0});
+  }
+
+  if (this->interp == Interpolation::Linear) {
+    for (size_t k = 0; k + 1 < out.size(); k++) {
+      out[k].derivative =
+          (out[k + 1].value - out[k].value) / (out[k + 1].time - out[k].time);
+    }
+    if (i + 1 < this->blocks.size()) {
+      const auto& next = this->blocks[i + 1];
+      auto& last       = out.back();
+      last.derivative = (next.first_value - last.value) / (next.begin_time - last.time);
+    }
+  }
+}
+
+Sample CompressedSignal::at(double t) const {
+  if (this->empty() || t < this->begin_time() || t > this->end_time()) {
+    throw std::out_of_range(
+        fmt::format("Signal is undefined for given time instance {}", t));
+  }
+  auto samples = std::vector<Sample>{};
+  this->decode_block(this->find_block(t), samples);
+
+  // The last sample timed at or before `t`.
+  const auto it = std::prev(std::upper_bound(
+      samples.begin(), samples.end(), t, [](double s, const Sample& a) {
+        return s < a.time;
+      }));
+  return Sample{t, it->interpolate(t), it->derivative};
+}
+
+SignalPtr CompressedSignal::decompress() const {
+  return this->decompress(this->begin_time(), this->end_time());
+}
+
+SignalPtr CompressedSignal::decompress(double start, double end) const {
+  auto sig = std::make_shared<Signal>(this->interp);
+  if (this->empty() || end < start) {
+    return sig;
+  }
+  auto buffer      = std::vector<Sample>{};
+  const size_t last = this->find_block(end);
+  for (size_t i = this->find_block(start); i <= last; i++) {
+    this->decode_block(i, buffer);
+    for (const auto& s : buffer) { sig->push_back(s.time, s.value); }
+  }
+  // Include the first sample of the next block, to cover the time between the blocks.
+  if (last + 1 < this->blocks.size()) {
+    const auto& next = this->blocks[last + 1];
+    sig->push_back(next.begin_time, next.first_value);
+  }
+  return sig;
+}
+
+} // namespace signal_tl::signal
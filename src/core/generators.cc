@@ -0,0 +1,301 @@
+#include "signal_tl/generators.hpp"
+#include "signal_tl/internal/utils.hpp"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace signal_tl::generators {
+
+using utils::overloaded;
+
+signal::SignalPtr random_signal(const SignalOptions& options, std::uint64_t seed) {
+  if (!(options.period > 0)) {
+    throw std::invalid_argument("Signal period must be positive");
+  } else if (!(options.jitter >= 0 && options.jitter < 1)) {
+    throw std::invalid_argument("Signal jitter must be in [0, 1)");
+  } else if (!(options.crossings >= 0 && options.crossings <= 1)) {
+    throw std::invalid_argument("Signal crossing density must be in [0, 1]");
+  } else if (!(options.amplitude > 0) || !(options.noise >= 0)) {
+    throw std::invalid_argument(
+        "Signal amplitude must be positive, and noise not negative");
+  }
+
+  auto rng       = std::mt19937_64{seed};
+  auto uniform   = std::uniform_real_distribution<double>{0.0, 1.0};
+  auto magnitude = std::uniform_real_distribution<double>{0.1, 1.0};
+  auto noise     = std::normal_distribution<double>{0.0, 1.0};
+
+  auto sig = std::make_shared<signal::Signal>();
+  sig->reserve(options.length);
+  double sign = (uniform(rng) < 0.5) ? -1.0 : 1.0;
+  for (size_t i = 0; i < options.length; i++) {
+    const double shift = options.jitter * (uniform(rng) - 0.5);
+    const double t = options.begin + options.period * (static_cast<double>(i) + shift);
+    if (i > 0 && uniform(rng) < options.crossings) {
+      sign = -sign;
+    }
+    double value = sign * options.amplitude * magnitude(rng);
+    if (options.noise > 0) {
+      value += options.noise * noise(rng);
+    }
+    sig->push_back(t, value);
+  }
+  return sig;
+}
+
+signal::Trace random_trace(
+    const std::vector<std::string>& names,
+    const SignalOptions& options,
+    std::uint64_t seed) {
+  // Each signal gets its own stream of random numbers.
+  auto seeds = std::seed_seq{
+      static_cast<std::uint32_t>(seed >> 32U), static_cast<std::uint32_t>(seed)};
+  auto keys  = std::vector<std::uint32_t>(names.size());
+  seeds.generate(keys.begin(), keys.end());
+
+  auto trace = signal::Trace{};
+  for (size_t i = 0; i < names.size(); i++) {
+    trace[names[i]] = random_signal(options, keys[i]);
+  }
+  return trace;
+}
+
+namespace {
+
+/// The operators a subformula can be built with.
+enum class Op { Not, And, Or, Always, Eventually, Until, Historically, Once, Since };
+
+struct FormulaGenerator {
+  const FormulaOptions& options;
+  std::mt19937_64 rng;
+  std::vector<Op> ops;
+
+  FormulaGenerator(const FormulaOptions& opts, std::uint64_t seed) :
+      options{opts}, rng{seed}, ops{Op::Not, Op::And, Op::Or} {
+    if (options.future) {
+      ops.insert(ops.end(), {Op::Always, Op::Eventually, Op::Until});
+    }
+    if (options.past) {
+      ops.insert(ops.end(), {Op::Historically, Op::Once, Op::Since});
+    }
+  }
+
+  double uniform(double a, double b) {
+    return std::uniform_real_distribution<double>{a, b}(this->rng);
+  }
+
+  size_t index(size_t lo, size_t hi) {
+    return std::uniform_int_distribution<size_t>{lo, hi}(this->rng);
+  }
+
+  template <typename C>
+  const auto& choose(const C& items) {
+    return items[this->index(0, std::size(items) - 1)];
+  }
+
+  ast::Expr predicate() {
+    constexpr ast::ComparisonOp comparisons[] = {
+        ast::ComparisonOp::GT,
+        ast::ComparisonOp::GE,
+        ast::ComparisonOp::LT,
+        ast::ComparisonOp::LE};
+    const auto& opts = this->options;
+    const auto& name = this->choose(opts.signals);
+    const auto op    = this->choose(comparisons);
+    const auto rhs   = this->uniform(opts.min_threshold, opts.max_threshold);
+    return ast::Predicate{name, op, rhs};
+  }
+
+  ast::Interval interval() {
+    if (this->uniform(0, 1) >= this->options.bounded_probability) {
+      return ast::Interval{};
+    }
+    const double a = this->uniform(0, this->options.max_interval_start);
+    double w       = std::exponential_distribution<double>{
+        1.0 / this->options.mean_interval_width}(this->rng);
+    if (!(a + w > a)) {
+      w = this->options.mean_interval_width;
+    }
+    return ast::Interval{a, a + w};
+  }
+
+  ast::Expr formula(size_t depth) {
+    if (depth <= 1 || this->uniform(0, 1) < this->options.leaf_probability) {
+      return this->predicate();
+    }
+    switch (this->choose(this->ops)) {
+      case Op::Not:
+        return Not(this->formula(depth - 1));
+      case Op::And:
+        return And(this->operands(depth - 1));
+      case Op::Or:
+        return Or(this->operands(depth - 1));
+      case Op::Always:
+        return Always(this->formula(depth - 1), this->interval());
+      case Op::Eventually:
+        return Eventually(this->formula(depth - 1), this->interval());
+      case Op::Until: {
+        auto lhs = this->formula(depth - 1);
+        return Until(std::move(lhs), this->formula(depth - 1), this->interval());
+      }
+      case Op::Historically:
+        return Historically(this->formula(depth - 1), this->interval());
+      case Op::Once:
+        return Once(this->formula(depth - 1), this->interval());
+      case Op::Since: {
+        auto lhs = this->formula(depth - 1);
+        return Since(std::move(lhs), this->formula(depth - 1), this->interval());
+      }
+    }
+    return this->predicate();
+  }
+
+  std::vector<ast::Expr> operands(size_t depth) {
+    const auto n = this->index(2, this->options.fanout);
+    auto args    = std::vector<ast::Expr>{};
+    for (size_t i = 0; i < n; i++) { args.push_back(this->formula(depth)); }
+    return args;
+  }
+};
+
+void append(fmt::memory_buffer& out, std::string_view s) {
+  out.append(s.data(), s.data() + s.size());
+}
+
+void write_spec(const ast::Expr& phi, fmt::memory_buffer& out);
+
+/// Write the form `(keyword args...)`.
+void write_form(
+    std::string_view keyword,
+    const std::vector<const ast::Expr*>& args,
+    fmt::memory_buffer& out) {
+  out.push_back('(');
+  append(out, keyword);
+  for (const auto arg : args) {
+    out.push_back(' ');
+    write_spec(*arg, out);
+  }
+  out.push_back(')');
+}
+
+void check_unbounded(std::string_view keyword, const ast::Interval& interval) {
+  if (interval.is_parametric() || !interval.is_zero_to_inf()) {
+    throw std::invalid_argument(fmt::format(
+        "The specification language has no intervals, in `{}`", keyword));
+  }
+}
+
+template <typename Ptr>
+void write_temporal(std::string_view keyword, const Ptr& e, fmt::memory_buffer& out) {
+  check_unbounded(keyword, e->interval);
+  write_form(keyword, {&e->arg}, out);
+}
+
+template <typename Ptr>
+void write_binary(std::string_view keyword, const Ptr& e, fmt::memory_buffer& out) {
+  check_unbounded(keyword, e->interval);
+  write_form(keyword, {&e->args.first, &e->args.second}, out);
+}
+
+void write_nary(
+    std::string_view keyword,
+    const std::vector<ast::Expr>& args,
+    fmt::memory_buffer& out) {
+  auto ptrs = std::vector<const ast::Expr*>{};
+  for (const auto& arg : args) { ptrs.push_back(&arg); }
+  write_form(keyword, ptrs, out);
+}
+
+void write_predicate(const ast::Predicate& e, fmt::memory_buffer& out) {
+  if (!e.param.empty()) {
+    throw std::invalid_argument(
+        fmt::format("The specification language has no parameters, in `{}`", e.param));
+  } else if (!(e.rhs >= 0) || std::isinf(e.rhs)) {
+    throw std::invalid_argument(fmt::format(
+        "The specification language has no negative or infinite numbers, in the "
+        "predicate on `{}`",
+        e.name));
+  }
+  const char* op = ">=";
+  switch (e.op) {
+    case ast::ComparisonOp::GT:
+      op = ">";
+      break;
+    case ast::ComparisonOp::GE:
+      op = ">=";
+      break;
+    case ast::ComparisonOp::LT:
+      op = "<";
+      break;
+    case ast::ComparisonOp::LE:
+      op = "<=";
+      break;
+  }
+  fmt::format_to(std::back_inserter(out), "({} {} {})", op, e.name, e.rhs);
+}
+
+void write_spec(const ast::Expr& phi, fmt::memory_buffer& out) {
+  std::visit(
+      overloaded{
+          [&](const ast::Const& e) { append(out, (e.value) ? "true" : "false"); },
+          [&](const ast::Predicate& e) { write_predicate(e, out); },
+          [&](const ast::NotPtr& e) { write_form("not", {&e->arg}, out); },
+          [&](const ast::AndPtr& e) { write_nary("and", e->args, out); },
+          [&](const ast::OrPtr& e) { write_nary("or", e->args, out); },
+          [&](const ast::AlwaysPtr& e) { write_temporal("always", e, out); },
+          [&](const ast::EventuallyPtr& e) { write_temporal("eventually", e, out); },
+          [&](const ast::UntilPtr& e) { write_binary("until", e, out); },
+          [&](const ast::HistoricallyPtr& e) {
+            write_temporal("historically", e, out);
+          },
+          [&](const ast::OncePtr& e) { write_temporal("once", e, out); },
+          [&](const ast::SincePtr& e) { write_binary("since", e, out); }},
+      phi);
+}
+
+} // namespace
+
+ast::Expr random_formula(const FormulaOptions& options, std::uint64_t seed) {
+  if (options.signals.empty()) {
+    throw std::invalid_argument("Formulas need at least one signal");
+  } else if (options.depth == 0) {
+    throw std::invalid_argument("Formula depth must be positive");
+  } else if (options.fanout < 2) {
+    throw std::invalid_argument("Formula fan-out must be at least 2");
+  } else if (!(options.min_threshold <= options.max_threshold)) {
+    throw std::invalid_argument("Threshold range cannot be empty");
+  } else if (!(options.max_interval_start >= 0) || !(options.mean_interval_width > 0)) {
+    throw std::invalid_argument(
+        "Interval start must not be negative, and interval width must be positive");
+  }
+  return FormulaGenerator{options, seed}.formula(options.depth);
+}
+
+std::string to_spec(const ast::Expr& phi) {
+  auto out = fmt::memory_buffer{};
+  write_spec(phi, out);
+  return fmt::to_string(out);
+}
+
+std::string to_spec(const std::map<std::string, ast::Expr>& assertions) {
+  auto out = fmt::memory_buffer{};
+  for (const auto& [name, phi] : assertions) {
+    fmt::format_to(std::back_inserter(out), "(assert {} ", name);
+    write_spec(phi, out);
+    append(out, ")\n");
+  }
+  return fmt::to_string(out);
+}
+
+} // namespace signal_tl::generators
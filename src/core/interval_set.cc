@@ -0,0 +1,158 @@
+#include "signal_tl/interval_set.hpp" // for BasicIntervalSet
+
+#include <algorithm> // for min, max, upper_bound
+#include <cstdint>   // for int64_t
+#include <iterator>  // for prev
+#include <stdexcept> // for invalid_argument
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+namespace signal_tl::signal {
+
+template <typename T>
+BasicIntervalSet<T>::BasicIntervalSet(const std::vector<interval_type>& sorted) {
+  this->intervals.reserve(sorted.size());
+  for (const auto& [lo, hi] : sorted) { this->push_back(lo, hi); }
+}
+
+template <typename T>
+void BasicIntervalSet<T>::push_back(T lo, T hi) {
+  if (hi < lo) {
+    throw std::invalid_argument("Interval [lo, hi] cannot have hi < lo");
+  }
+  if (this->intervals.empty()) {
+    this->intervals.emplace_back(lo, hi);
+    return;
+  }
+  auto& last = this->intervals.back();
+  if (lo < last.first) {
+    throw std::invalid_argument(
+        "Intervals must be added to an IntervalSet in the order of their start");
+  } else if (lo <= last.second) {
+    last.second = std::max(last.second, hi);
+  } else {
+    this->intervals.emplace_back(lo, hi);
+  }
+}
+
+template <typename T>
+bool BasicIntervalSet<T>::contains(T t) const {
+  // The last interval starting at or before `t`.
+  const auto it = std::upper_bound(
+      this->intervals.begin(),
+      this->intervals.end(),
+      t,
+      [](T s, const interval_type& a) { return s < a.first; });
+  return it != this->intervals.begin() && t <= std::prev(it)->second;
+}
+
+template <typename T>
+T BasicIntervalSet<T>::measure() const {
+  T out = 0;
+  for (const auto& [lo, hi] : this->intervals) { out += hi - lo; }
+  return out;
+}
+
+template <typename T>
+BasicIntervalSet<T> BasicIntervalSet<T>::unite(const BasicIntervalSet& other) const {
+  auto out = BasicIntervalSet{};
+  out.intervals.reserve(this->size() + other.size());
+  auto i = this->begin();
+  auto j = other.begin();
+  while (i != this->end() || j != other.end()) {
+    if (j == other.end() || (i != this->end() && i->first <= j->first)) {
+      out.push_back(i->first, i->second);
+      i++;
+    } else {
+      out.push_back(j->first, j->second);
+      j++;
+    }
+  }
+  return out;
+}
+
+template <typename T>
+BasicIntervalSet<T>
+BasicIntervalSet<T>::intersect(const BasicIntervalSet& other) const {
+  auto out = BasicIntervalSet{};
+  auto i   = this->begin();
+  auto j   = other.begin();
+  while (i != this->end() && j != other.end()) {
+    const T lo = std::max(i->first, j->first);
+    const T hi = std::min(i->second, j->second);
+    if (lo <= hi) {
+      out.intervals.emplace_back(lo, hi);
+    }
+    // The interval that ends first cannot intersect any other interval.
+    if (i->second < j->second) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+  return out;
+}
+
+template <typename T>
+BasicIntervalSet<T> BasicIntervalSet<T>::complement(T lo, T hi) const {
+  auto out  = BasicIntervalSet{};
+  T current = lo;
+  for (const auto& [start, stop] : this->intervals) {
+    if (stop < lo) {
+      continue;
+    } else if (start > hi) {
+      break;
+    }
+    // Gaps around a single point of the set touch, and are merged.
+    if (start > current) {
+      out.push_back(current, start);
+    }
+    current = std::max(current, stop);
+  }
+  if (current < hi) {
+    out.push_back(current, hi);
+  }
+  return out;
+}
+
+template <typename T>
+BasicIntervalSet<T> BasicIntervalSet<T>::clip(T lo, T hi) const {
+  auto out = BasicIntervalSet{};
+  for (const auto& [start, stop] : this->intervals) {
+    if (stop < lo) {
+      continue;
+    } else if (start > hi) {
+      break;
+    }
+    out.intervals.emplace_back(std::max(start, lo), std::min(stop, hi));
+  }
+  return out;
+}
+
+template <typename T>
+BasicIntervalSet<T> BasicIntervalSet<T>::minkowski_sum(T lo, T hi) const {
+  auto out = BasicIntervalSet{};
+  out.intervals.reserve(this->size());
+  for (const auto& [start, stop] : this->intervals) {
+    out.push_back(start + lo, stop + hi);
+  }
+  return out;
+}
+
+template <typename T>
+BasicIntervalSet<T> BasicIntervalSet<T>::minkowski_difference(T lo, T hi) const {
+  // The intervals of the set are disjoint and do not touch, so a window in the set is
+  // contained in one of them.
+  auto out = BasicIntervalSet{};
+  for (const auto& [start, stop] : this->intervals) {
+    if (stop - start >= hi - lo) {
+      out.intervals.emplace_back(start - lo, stop - hi);
+    }
+  }
+  return out;
+}
+
+template class BasicIntervalSet<double>;
+template class BasicIntervalSet<std::int64_t>;
+
+} // namespace signal_tl::signal
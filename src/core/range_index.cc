@@ -0,0 +1,122 @@
+#include "signal_tl/range_index.hpp" // for BasicRangeIndex
+#include "signal_tl/signal.hpp"      // for BasicSample, BasicSignal
+
+#include <algorithm> // for min, max, upper_bound, lower_bound
+#include <cstdint>   // for int64_t
+#include <iterator>  // for prev
+#include <limits>    // for numeric_limits
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+namespace signal_tl::signal {
+
+namespace {
+
+/// The largest `k` such that `2^k <= n`, for `n > 0`.
+size_t floor_log2(size_t n) {
+  size_t k = 0;
+  while ((n >> (k + 1)) != 0) { k++; }
+  return k;
+}
+
+} // namespace
+
+template <typename T, typename V>
+BasicRangeIndex<T, V>::BasicRangeIndex(const BasicSignal<T, V>& sig) :
+    samples(sig.begin(), sig.end()) {
+  const size_t n = this->samples.size();
+  if (n == 0) {
+    return;
+  }
+  const size_t levels = floor_log2(n) + 1;
+  this->lo.reserve(levels);
+  this->hi.reserve(levels);
+
+  auto& lo0 = this->lo.emplace_back(n);
+  auto& hi0 = this->hi.emplace_back(n);
+  for (size_t i = 0; i < n; i++) { lo0[i] = hi0[i] = this->samples[i].value; }
+
+  for (size_t k = 1; k < levels; k++) {
+    const size_t half = size_t{1} << (k - 1);
+    const size_t m    = n - (size_t{1} << k) + 1;
+    auto lo_k         = std::vector<V>(m);
+    auto hi_k         = std::vector<V>(m);
+    for (size_t i = 0; i < m; i++) {
+      lo_k[i] = std::min(this->lo[k - 1][i], this->lo[k - 1][i + half]);
+      hi_k[i] = std::max(this->hi[k - 1][i], this->hi[k - 1][i + half]);
+    }
+    this->lo.push_back(std::move(lo_k));
+    this->hi.push_back(std::move(hi_k));
+  }
+}
+
+template <typename T, typename V>
+V BasicRangeIndex<T, V>::value_at(T t) const {
+  const auto it = std::upper_bound(
+      this->samples.begin(), this->samples.end(), t, [](T s, const sample_type& a) {
+        return s < a.time;
+      });
+  if (it == this->samples.begin()) {
+    return this->samples.front().value;
+  } else if (it == this->samples.end()) {
+    return this->samples.back().value;
+  }
+  return std::prev(it)->interpolate(t);
+}
+
+template <typename T, typename V>
+std::pair<size_t, size_t> BasicRangeIndex<T, V>::interior(T start, T end) const {
+  const auto first = std::upper_bound(
+      this->samples.begin(), this->samples.end(), start, [](T s, const sample_type& a) {
+        return s < a.time;
+      });
+  const auto last =
+      std::lower_bound(first, this->samples.end(), end, [](const sample_type& a, T s) {
+        return a.time < s;
+      });
+  return {
+      static_cast<size_t>(first - this->samples.begin()),
+      static_cast<size_t>(last - this->samples.begin())};
+}
+
+template <typename T, typename V>
+V BasicRangeIndex<T, V>::min(T start, T end) const {
+  if (this->samples.empty()) {
+    return std::numeric_limits<V>::infinity();
+  }
+  V out = std::min(this->value_at(start), this->value_at(end));
+  if (const auto [i, j] = this->interior(start, end); i < j) {
+    const size_t k = floor_log2(j - i);
+    out = std::min({out, this->lo[k][i], this->lo[k][j - (size_t{1} << k)]});
+  }
+  return out;
+}
+
+template <typename T, typename V>
+V BasicRangeIndex<T, V>::max(T start, T end) const {
+  if (this->samples.empty()) {
+    return -std::numeric_limits<V>::infinity();
+  }
+  V out = std::max(this->value_at(start), this->value_at(end));
+  if (const auto [i, j] = this->interior(start, end); i < j) {
+    const size_t k = floor_log2(j - i);
+    out = std::max({out, this->hi[k][i], this->hi[k][j - (size_t{1} << k)]});
+  }
+  return out;
+}
+
+template <typename T, typename V>
+size_t BasicRangeIndex<T, V>::memory_usage() const {
+  size_t bytes = sizeof(*this) + this->samples.capacity() * sizeof(sample_type);
+  for (size_t k = 0; k < this->lo.size(); k++) {
+    bytes += (this->lo[k].capacity() + this->hi[k].capacity()) * sizeof(V);
+  }
+  return bytes;
+}
+
+template class BasicRangeIndex<double, double>;
+template class BasicRangeIndex<double, float>;
+template class BasicRangeIndex<std::int64_t, double>;
+template class BasicRangeIndex<std::int64_t, float>;
+
+} // namespace signal_tl::signal
@@ -1,17 +1,23 @@
-#include "signal_tl/signal.hpp" // for Sample, Signal, SignalPtr, synchronize
-#include "signal_tl/fmt.hpp"    // IWYU pragma: keep
+#include "signal_tl/signal.hpp"      // for Sample, Signal, SignalPtr, synchronize
+#include "signal_tl/fmt.hpp"         // IWYU pragma: keep
+#include "signal_tl/range_index.hpp" // for BasicRangeIndex
 
-#include <algorithm>    // for lower_bound, max
+#include <algorithm>    // for lower_bound, upper_bound, max, min
+#include <cmath>        // for abs, nextafter
+#include <cstdint>      // for int64_t
 #include <fmt/format.h> // for format
 #include <iterator>     // for prev, next
-#include <memory>       // for shared_ptr, __shared_ptr_access, mak...
+#include <limits>       // for numeric_limits
+#include <memory>       // for shared_ptr, make_shared
 #include <stdexcept>    // for invalid_argument
 #include <tuple>        // for make_tuple, tuple
+#include <type_traits>  // for is_floating_point_v
 #include <vector>       // for vector
 
 namespace signal_tl::signal {
 
-Sample Signal::at(double t) const {
+template <typename T, typename V>
+BasicSample<T, V> BasicSignal<T, V>::at(T t) const {
   if (this->begin_time() > t && this->end_time() < t) {
     throw std::invalid_argument(
         fmt::format("Signal is undefined for given time instance {}", t));
@@ -21,14 +27,77 @@ Sample Signal::at(double t) const {
   };
 
   auto it = std::lower_bound(
-      this->begin(), this->end(), Sample{t, 0.0}, comp_time); // it->time >= t
+      this->begin(), this->end(), Sample{t, 0}, comp_time); // it->time >= t
   if (it->time == t) {
     return *it;
   }
   return Sample{t, it->interpolate(t), it->derivative};
 }
 
-void Signal::push_back(Sample sample) {
+template <typename T, typename V>
+BasicSignalSummary<T, V> BasicSignal<T, V>::summary() const {
+  if (const auto cached = this->summary_cache.load()) {
+    return *cached;
+  }
+
+  auto out = BasicSignalSummary<T, V>{};
+  for (size_t i = 0; i < this->size(); i++) {
+    const auto& s = this->data()[i];
+    if (s.value <= out.min) {
+      out.min    = s.value;
+      out.argmin = i;
+    }
+    if (s.value >= out.max) {
+      out.max    = s.value;
+      out.argmax = i;
+    }
+    if (i > 0) {
+      const auto& prev = this->data()[i - 1];
+      out.nondecreasing &= s.value >= prev.value;
+      out.nonincreasing &= s.value <= prev.value;
+    }
+  }
+
+  if (this->size() > 2) {
+    // Allow for rounding errors in floating-point timestamps.
+    const auto dt  = static_cast<double>(this->data()[1].time - this->front().time);
+    const auto tol = std::numeric_limits<double>::epsilon() * 16 *
+                     std::max(std::abs(static_cast<double>(this->front().time)),
+                              std::abs(static_cast<double>(this->back().time)));
+    for (size_t i = 2; i < this->size() && out.uniform; i++) {
+      const auto dt_i =
+          static_cast<double>(this->data()[i].time - this->data()[i - 1].time);
+      out.uniform = std::abs(dt_i - dt) <= tol;
+    }
+  }
+
+  this->summary_cache.store(std::make_shared<const BasicSignalSummary<T, V>>(out));
+  return out;
+}
+
+template <typename T, typename V>
+std::shared_ptr<const BasicRangeIndex<T, V>> BasicSignal<T, V>::range_index() const {
+  if (auto cached = this->index_cache.load()) {
+    return cached;
+  }
+  auto index = std::make_shared<const BasicRangeIndex<T, V>>(*this);
+  this->index_cache.store(index);
+  return index;
+}
+
+template <typename T, typename V>
+void BasicSignal<T, V>::make_owned() {
+  if (this->borrowed) {
+    this->samples.assign(this->begin(), this->end());
+    this->borrowed      = nullptr;
+    this->borrowed_size = 0;
+  }
+}
+
+template <typename T, typename V>
+void BasicSignal<T, V>::push_back(Sample sample) {
+  this->make_owned();
+  this->invalidate_cache();
   if (!this->samples.empty()) {
     if (sample.time <= this->end_time()) {
       throw std::invalid_argument(fmt::format(
@@ -42,18 +111,22 @@ void Signal::push_back(Sample sample) {
     const auto v = this->samples.back().value;
     auto& last   = this->samples.back();
 
-    last.derivative = (sample.value - v) / (sample.time - t);
+    last.derivative = (this->interp == Interpolation::Step)
+                          ? V{0}
+                          : (sample.value - v) / static_cast<V>(sample.time - t);
   }
-  this->samples.push_back(Sample{sample.time, sample.value, 0.0});
+  this->samples.push_back(Sample{sample.time, sample.value, 0});
 }
 
-void Signal::push_back(double time, double value) {
-  this->push_back(Sample{time, value, 0.0});
+template <typename T, typename V>
+void BasicSignal<T, V>::push_back(T time, V value) {
+  this->push_back(Sample{time, value, 0});
 }
 
-SignalPtr Signal::simplify() const {
-  auto sig = std::make_shared<Signal>();
-  for (const auto& s : this->samples) {
+template <typename T, typename V>
+BasicSignalPtr<T, V> BasicSignal<T, V>::simplify() const {
+  auto sig = std::make_shared<BasicSignal>(this->interp);
+  for (const auto& s : *this) {
     const auto [t, v, d] = s;
     if ((sig->empty()) ||
         (sig->back().interpolate(t) != v || sig->back().derivative != d)) {
@@ -66,78 +139,239 @@ SignalPtr Signal::simplify() const {
   return sig;
 }
 
-SignalPtr Signal::resize(double start, double end, double fill) const {
-  auto sig = std::make_shared<Signal>();
+template <typename T, typename V>
+BasicSignalPtr<T, V> BasicSignal<T, V>::simplify(V epsilon) const {
+  auto sig = std::make_shared<BasicSignal>(*this);
+  sig->simplify_inplace(epsilon);
+  return sig;
+}
 
-  // Check if begin_time > start, then add filled value
-  if (this->begin_time() > start) {
-    sig->push_back(Sample{start, fill, 0.0});
-  }
-
-  // Truncate the discard all samples where sample.time < start
-  for (auto i = this->begin(); i != this->end(); i++) {
-    const double t = i->time;
-    // If current sample is timed below start, ...
-    if (std::next(i) != this->end() && std::next(i)->time > start) {
-      // and next sample is timed after `start`, append an intermediate value
-      sig->push_back(Sample{start, i->interpolate(start)});
-    } else if (start <= t && t <= end) {
-      // If the samples are within the desired time range, keep the samples.
-      sig->push_back(*i);
-    } else if (t > end) {
-      // If we are out of the range, ...
-      if (i != this->begin() && std::prev(i)->time < end) {
-        // and the previous sample is within the range, interpolate from the last.
-        sig->push_back(Sample{end, std::prev(i)->interpolate(end)});
+template <typename T, typename V>
+void BasicSignal<T, V>::simplify_inplace(V epsilon) {
+  if (epsilon < 0) {
+    throw std::invalid_argument(
+        fmt::format("Simplification tolerance must be non-negative, got {}", epsilon));
+  }
+  if (this->size() <= 2) {
+    return;
+  }
+  this->make_owned();
+  this->invalidate_cache();
+
+  // The output samples are written to the front of `samples`. Each output sample
+  // replaces an input sample that has already been read, so the compression can be
+  // done in place.
+  auto& xs = this->samples;
+  size_t m = 0;
+  const auto emit = [&xs, &m](T t, V v) { xs[m++] = Sample{t, v, 0}; };
+
+  if (this->interp == Interpolation::Step) {
+    // Each output step covers a run of samples whose values lie in a band of width
+    // 2 * epsilon, and takes the value at the middle of the band.
+    T start = xs.front().time;
+    V lo = xs.front().value, hi = xs.front().value;
+    for (size_t i = 1; i < xs.size(); i++) {
+      const auto [t, v, d] = xs[i];
+      if (std::max(hi, v) - std::min(lo, v) > 2 * epsilon) {
+        emit(start, lo + (hi - lo) / 2);
+        start = t;
+        lo = hi = v;
       } else {
-        // TODO(anand): Does it make sense to terminate early?
-        break;
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
       }
     }
+    const T end = xs.back().time;
+    emit(start, lo + (hi - lo) / 2);
+    if (start != end) {
+      emit(end, lo + (hi - lo) / 2);
+    }
+    xs.resize(m);
+    return;
   }
 
+  // Swing filter: the current segment starts at the anchor (ta, va), and [lo, hi] is
+  // the range of slopes for which the segment stays within epsilon of every sample
+  // covered so far. When a sample makes the range empty, the segment is ended at the
+  // previous sample, which becomes the next anchor. The anchors are within epsilon of
+  // the signal, and the error is linear between samples, so the bound holds everywhere.
+  T ta = xs.front().time;
+  V va = xs.front().value;
+  V lo = -std::numeric_limits<V>::infinity();
+  V hi = std::numeric_limits<V>::infinity();
+  emit(ta, va);
+  for (size_t i = 1; i < xs.size(); i++) {
+    const auto [t, v, d] = xs[i];
+    const T prev         = xs[i - 1].time;
+
+    auto dt      = static_cast<V>(t - ta);
+    const V lo_i = (v - epsilon - va) / dt;
+    const V hi_i = (v + epsilon - va) / dt;
+    if (std::max(lo, lo_i) > std::min(hi, hi_i)) {
+      va = va + (lo + (hi - lo) / 2) * static_cast<V>(prev - ta);
+      ta = prev;
+      emit(ta, va);
+
+      dt = static_cast<V>(t - ta);
+      lo = (v - epsilon - va) / dt;
+      hi = (v + epsilon - va) / dt;
+    } else {
+      lo = std::max(lo, lo_i);
+      hi = std::min(hi, hi_i);
+    }
+  }
+  const T end = xs.back().time;
+  emit(end, va + (lo + (hi - lo) / 2) * static_cast<V>(end - ta));
+  xs.resize(m);
+
+  for (size_t k = 0; k + 1 < xs.size(); k++) {
+    xs[k].derivative =
+        (xs[k + 1].value - xs[k].value) / static_cast<V>(xs[k + 1].time - xs[k].time);
+  }
+}
+
+template <typename T, typename V>
+void BasicSignal<T, V>::affine_inplace(V scale, V offset) {
+  this->make_owned();
+  this->invalidate_cache();
+  for (auto& s : this->samples) {
+    s.value      = scale * s.value + offset;
+    s.derivative = scale * s.derivative;
+  }
+}
+
+template <typename T, typename V>
+void BasicSignal<T, V>::shift_inplace(T dt) {
+  // Shifting the signal does not change the summary, but the range index is looked
+  // up by time.
+  this->make_owned();
+  this->index_cache.store(nullptr);
+  for (auto& s : this->samples) { s.time += dt; }
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> BasicSignal<T, V>::resize(T start, T end, V fill) const {
+  auto sig = std::make_shared<BasicSignal>(this->interp);
+  if (end < start) {
+    return sig;
+  } else if (this->empty() || end < this->begin_time() || start > this->end_time()) {
+    sig->push_back(Sample{start, fill, 0});
+    if (start < end) {
+      sig->push_back(Sample{end, fill, 0});
+    }
+    return sig;
+  }
+
+  // Fill the time before the start of the signal, ...
+  if (this->begin_time() > start) {
+    sig->push_back(Sample{start, fill, 0});
+  }
+  // keep the samples within [start, end], interpolated at the ends, ...
+  const auto body = this->slice(start, end);
+  sig->samples.reserve(sig->size() + body->size() + 1);
+  for (const auto& s : *body) { sig->push_back(s); }
+  // and hold the last value until `end`.
+  if (this->end_time() < end) {
+    sig->push_back(Sample{end, sig->back().value, 0});
+  }
   return sig;
 }
 
-SignalPtr Signal::shift(double dt) const {
-  auto sig = std::make_shared<Signal>(this->samples);
-  for (auto& s : sig->samples) { s.time += dt; }
+template <typename T, typename V>
+BasicSignalPtr<T, V> BasicSignal<T, V>::slice(T start, T end) const {
+  auto sig = std::make_shared<BasicSignal>(this->interp);
+  if (this->empty() || end < start || end < this->begin_time() ||
+      start > this->end_time()) {
+    return sig;
+  }
+  start = std::max(start, this->begin_time());
+  end   = std::min(end, this->end_time());
 
+  // The last sample at or before `start`, and the first sample after `end`.
+  constexpr auto comp_time = [](T t, const Sample& a) { return t < a.time; };
+  const auto first =
+      std::prev(std::upper_bound(this->begin(), this->end(), start, comp_time));
+  const auto last = std::upper_bound(first, this->end(), end, comp_time);
+
+  auto& xs = sig->samples;
+  xs.reserve(static_cast<size_t>(last - first) + 1);
+  xs.push_back(Sample{start, first->interpolate(start), first->derivative});
+  for (auto i = std::next(first); i != last; i++) { xs.push_back(*i); }
+  if (xs.back().time < end) {
+    const auto& s = *std::prev(last);
+    xs.push_back(Sample{end, s.interpolate(end), s.derivative});
+  }
   return sig;
 }
 
-SignalPtr Signal::resize_shift(double start, double end, double fill, double dt) const {
+template <typename T, typename V>
+BasicSignalPtr<T, V> BasicSignal<T, V>::linearize() const {
+  if (this->interp == Interpolation::Linear) {
+    return std::make_shared<BasicSignal>(*this);
+  }
+
+  auto sig = std::make_shared<BasicSignal>(Interpolation::Linear);
+  sig->reserve(2 * this->size());
+  for (const auto& s : *this) {
+    if (!sig->empty() && s.value != sig->samples.back().value) {
+      T before = s.time - 1;
+      if constexpr (std::is_floating_point_v<T>) {
+        before = std::nextafter(s.time, -std::numeric_limits<T>::infinity());
+      }
+      if (before > sig->end_time()) {
+        sig->push_back(before, sig->samples.back().value);
+      }
+    }
+    sig->push_back(s.time, s.value);
+  }
+  return sig;
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> BasicSignal<T, V>::shift(T dt) const {
+  auto sig = std::make_shared<BasicSignal>(*this);
+  sig->shift_inplace(dt);
+  return sig;
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V>
+BasicSignal<T, V>::resize_shift(T start, T end, V fill, T dt) const {
   auto out = this->resize(start, end, fill);
-  for (auto& s : out->samples) { s.time += dt; }
+  out->shift_inplace(dt);
   return out;
 }
 
-std::tuple<std::shared_ptr<Signal>, std::shared_ptr<Signal>>
-synchronize(const std::shared_ptr<Signal>& x, const std::shared_ptr<Signal>& y) {
-  const double begin_time = std::max(x->begin_time(), y->begin_time());
+template <typename T, typename V>
+std::tuple<BasicSignalPtr<T, V>, BasicSignalPtr<T, V>>
+synchronize(const BasicSignalPtr<T, V>& x, const BasicSignalPtr<T, V>& y) {
+  using sample_type = BasicSample<T, V>;
+
+  if (x->interpolation() != y->interpolation()) {
+    const auto linear = [](const BasicSignalPtr<T, V>& s) {
+      return (s->interpolation() == Interpolation::Step) ? s->linearize() : s;
+    };
+    return synchronize(linear(x), linear(y));
+  }
+
+  const T begin_time = std::max(x->begin_time(), y->begin_time());
   // const double end_time   = std::min(x->end_time(), y->end_time());
 
   // These will store the new series of Samples, containing a sample for every
   // time instance in x and y, and the time points where they intersect.
-  auto xv = std::vector<Sample>{};
-  auto yv = std::vector<Sample>{};
+  auto xv = std::vector<sample_type>{};
+  auto yv = std::vector<sample_type>{};
 
-  // Iterator to the first element where element.time <= begin_time.
-  // If the iterator begins after begin_time, get the prev (if it exists) and
-  // interpolate from it.
-  constexpr auto comp_time = [](const Sample& a, const Sample& b) -> bool {
+  // Iterators to the first elements where element.time >= begin_time. One of the
+  // signals has a sample at begin_time, and the loop below interpolates the other
+  // one from the sample before it.
+  constexpr auto comp_time = [](const sample_type& a, const sample_type& b) -> bool {
     return a.time < b.time;
   };
-  auto i = std::lower_bound(x->begin(), x->end(), Sample{begin_time, 0.0}, comp_time);
-  if (i->time > begin_time && i != x->begin()) {
-    xv.push_back(Sample{
-        begin_time, std::prev(i)->interpolate(begin_time), std::prev(i)->derivative});
-  }
-  auto j = std::lower_bound(y->begin(), y->end(), Sample{begin_time, 0.0}, comp_time);
-  if (j->time > begin_time && j != y->begin()) {
-    yv.push_back(Sample{
-        begin_time, std::prev(j)->interpolate(begin_time), std::prev(i)->derivative});
-  }
+  auto i =
+      std::lower_bound(x->begin(), x->end(), sample_type{begin_time, 0}, comp_time);
+  auto j =
+      std::lower_bound(y->begin(), y->end(), sample_type{begin_time, 0}, comp_time);
 
   // Now, we have to track the timestamps.
   while (i != x->end() && j != y->end()) {
@@ -150,26 +384,40 @@ synchronize(const std::shared_ptr<Signal>& x, const std::shared_ptr<Signal>& y)
     } else if (i->time < j->time) {
       // Add the current point
       xv.push_back(*i);
-      yv.push_back(Sample{i->time, std::prev(j)->interpolate(i->time)});
+      yv.push_back(sample_type{i->time, std::prev(j)->interpolate(i->time)});
       // TODO: Intercept?
       // We need to "catch up".
       i++;
     } else if (j->time < i->time) {
       yv.push_back(*j);
-      xv.push_back(Sample{j->time, std::prev(i)->interpolate(j->time)});
+      xv.push_back(sample_type{j->time, std::prev(i)->interpolate(j->time)});
       j++;
     }
   }
 
-  if (const double t = xv.back().time; yv.back().time < t) {
-    yv.push_back(Sample{xv.back().time, yv.back().interpolate(t)});
+  if (const T t = xv.back().time; yv.back().time < t) {
+    yv.push_back(sample_type{xv.back().time, yv.back().interpolate(t)});
   }
 
-  if (const double t = yv.back().time; xv.back().time < t) {
-    xv.push_back(Sample{yv.back().time, xv.back().interpolate(t)});
+  if (const T t = yv.back().time; xv.back().time < t) {
+    xv.push_back(sample_type{yv.back().time, xv.back().interpolate(t)});
   }
 
-  return std::make_tuple(std::make_shared<Signal>(xv), std::make_shared<Signal>(yv));
+  return std::make_tuple(
+      std::make_shared<BasicSignal<T, V>>(xv, x->interpolation()),
+      std::make_shared<BasicSignal<T, V>>(yv, y->interpolation()));
 }
 
+#define SIGNALTL_INSTANTIATE_SIGNAL(T, V)                                      \
+  template struct BasicSignal<T, V>;                                           \
+  template std::tuple<BasicSignalPtr<T, V>, BasicSignalPtr<T, V>> synchronize( \
+      const BasicSignalPtr<T, V>&, const BasicSignalPtr<T, V>&);
+
+SIGNALTL_INSTANTIATE_SIGNAL(double, double)
+SIGNALTL_INSTANTIATE_SIGNAL(double, float)
+SIGNALTL_INSTANTIATE_SIGNAL(std::int64_t, double)
+SIGNALTL_INSTANTIATE_SIGNAL(std::int64_t, float)
+
+#undef SIGNALTL_INSTANTIATE_SIGNAL
+
 } // namespace signal_tl::signal
@@ -5,7 +5,9 @@
 
 #include <cmath>       // for isinf
 #include <limits>      // for numeric_limits
+#include <map>         // for map
 #include <memory>      // for shared_ptr
+#include <set>         // for set
 #include <stdexcept>   // for invalid_argument
 #include <string>      // for string, operator==, basic_string
 #include <type_traits> // for remove_reference<>::type
@@ -24,15 +26,21 @@ struct Or;
 struct Always;
 struct Eventually;
 struct Until;
-
-using ConstPtr      = std::shared_ptr<Const>;
-using PredicatePtr  = std::shared_ptr<Predicate>;
-using NotPtr        = std::shared_ptr<Not>;
-using AndPtr        = std::shared_ptr<And>;
-using OrPtr         = std::shared_ptr<Or>;
-using AlwaysPtr     = std::shared_ptr<Always>;
-using EventuallyPtr = std::shared_ptr<Eventually>;
-using UntilPtr      = std::shared_ptr<Until>;
+struct Historically;
+struct Once;
+struct Since;
+
+using ConstPtr        = std::shared_ptr<Const>;
+using PredicatePtr    = std::shared_ptr<Predicate>;
+using NotPtr          = std::shared_ptr<Not>;
+using AndPtr          = std::shared_ptr<And>;
+using OrPtr           = std::shared_ptr<Or>;
+using AlwaysPtr       = std::shared_ptr<Always>;
+using EventuallyPtr   = std::shared_ptr<Eventually>;
+using UntilPtr        = std::shared_ptr<Until>;
+using HistoricallyPtr = std::shared_ptr<Historically>;
+using OncePtr         = std::shared_ptr<Once>;
+using SincePtr        = std::shared_ptr<Since>;
 
 /* Define Syntax Tree */
 
@@ -62,14 +70,30 @@ struct Const {
 /// real-valued signals.
 enum class ComparisonOp { GT, GE, LT, LE };
 
+/// A symbolic parameter of a parametric STL formula.
+///
+/// A parameter can stand for the threshold of a predicate, or for a bound of the
+/// interval of a temporal operator. Use `substitute` to bind parameters to values, or
+/// `semantics::compute_robustness_sweep` to evaluate a formula for many values of its
+/// parameters at once.
+struct Parameter {
+  std::string name;
+};
+
+/// Values assigned to the parameters of a formula, by name.
+using ParameterValues = std::map<std::string, double>;
+
 /// A Predicate AST node.
 ///
 /// It simply holds the expression `x ~ c`, where `x` is some signal identifier, `~` is
-/// a valid comparison operator, and `c` is some constant (double).
+/// a valid comparison operator, and `c` is some constant (double), or a parameter.
 struct Predicate {
   std::string name;
   ComparisonOp op = ComparisonOp::GE;
   double rhs      = 0.0;
+  /// The name of the parameter `c` stands for, if any. `rhs` is then its default
+  /// value.
+  std::string param = {};
 
   // Predicate() = delete;
   Predicate(
@@ -77,9 +101,12 @@ struct Predicate {
       ComparisonOp operation = ComparisonOp::GE,
       double constant_val    = 0.0) :
       name{std::move(ap_name)}, op{operation}, rhs{constant_val} {};
+  Predicate(std::string ap_name, ComparisonOp operation, Parameter parameter) :
+      name{std::move(ap_name)}, op{operation}, param{std::move(parameter.name)} {};
 
   inline bool operator==(const Predicate& other) const {
-    return (name == other.name) && (op == other.op) && (rhs == other.rhs);
+    return (name == other.name) && (op == other.op) && (rhs == other.rhs) &&
+           (param == other.param);
   };
 
   inline bool operator!=(const Predicate& other) const {
@@ -92,7 +119,8 @@ struct Predicate {
 /// - A Boolean constant;
 /// - A Predicate expression;
 /// - A unary Not, or n-ary And/Or; and
-/// - The temporal operators, Always, Eventually, and Until.
+/// - The temporal operators, Always, Eventually, and Until; and
+/// - Their past-time counterparts, Historically, Once, and Since.
 using Expr = std::variant<
     Const,
     Predicate,
@@ -101,7 +129,10 @@ using Expr = std::variant<
     OrPtr,
     AlwaysPtr,
     EventuallyPtr,
-    UntilPtr>;
+    UntilPtr,
+    HistoricallyPtr,
+    OncePtr,
+    SincePtr>;
 using ExprPtr = std::shared_ptr<Expr>;
 
 struct Not {
@@ -154,6 +185,10 @@ struct Interval {
 
   Num low;
   Num high;
+  /// The names of the parameters the bounds stand for, if any. `low` and `high` are
+  /// then their default values.
+  std::string low_param  = {};
+  std::string high_param = {};
 
   Interval() : low{0.0}, high{std::numeric_limits<double>::infinity()} {};
   Interval(unsigned long long int a, unsigned long long int b) : low{a}, high{b} {}
@@ -164,6 +199,24 @@ struct Interval {
       throw std::invalid_argument("Interval [a,b] cannot have b <= a");
     }
   }
+  /// The interval `[a, b]` with a parametric upper bound, which defaults to infinity.
+  Interval(double a, Parameter b) : Interval{} {
+    if (a < 0) {
+      throw std::invalid_argument("Interval cannot have negative values");
+    }
+    low        = a;
+    high_param = std::move(b.name);
+  }
+  /// The interval `[a, b]` with parametric bounds, which default to `[0, inf)`.
+  Interval(Parameter a, Parameter b) : Interval{} {
+    low_param  = std::move(a.name);
+    high_param = std::move(b.name);
+  }
+
+  /// Check if a bound of the interval is a parameter.
+  [[nodiscard]] bool is_parametric() const {
+    return !low_param.empty() || !high_param.empty();
+  }
 
   /// Return the (low, high) pair as `double`s.
   [[nodiscard]] std::pair<double, double> as_double() const {
@@ -231,16 +284,95 @@ struct Until {
       args{std::make_pair(std::move(arg0), std::move(arg1))}, interval{time_interval} {}
 };
 
+/* Past-time Modal Logic */
+
+/// The past-time counterpart of `Always`.
+///
+/// The interval `[a, b]` of a past-time operator refers to the times `[t - b, t - a]`,
+/// so the formula can be decided at `t` from the samples seen so far.
+struct Historically {
+  Expr arg;
+  Interval interval;
+
+  // Historically() = delete;
+  Historically(Expr operand) : arg{std::move(operand)}, interval{} {}
+  Historically(Expr operand, Interval time_interval) :
+      arg(std::move(operand)), interval(time_interval) {}
+};
+
+/// The past-time counterpart of `Eventually`.
+struct Once {
+  Expr arg;
+  Interval interval;
+
+  // Once() = delete;
+  Once(Expr operand) : arg{std::move(operand)}, interval{} {}
+  Once(Expr operand, Interval time_interval) :
+      arg(std::move(operand)), interval(time_interval) {}
+};
+
+/// The past-time counterpart of `Until`: `phi S[a, b] psi` holds at `t` if `psi` held
+/// at some `s` in `[t - b, t - a]`, and `phi` has held since then.
+struct Since {
+  std::pair<Expr, Expr> args;
+  Interval interval;
+
+  // Since() = delete;
+  Since(Expr arg0, Expr arg1) :
+      args{std::make_pair(std::move(arg0), std::move(arg1))}, interval{} {}
+  Since(Expr arg0, Expr arg1, Interval time_interval) :
+      args{std::make_pair(std::move(arg0), std::move(arg1))}, interval{time_interval} {}
+};
+
 Predicate operator>(const Predicate& lhs, const double bound);
 Predicate operator>=(const Predicate& lhs, const double bound);
 Predicate operator<(const Predicate& lhs, const double bound);
 Predicate operator<=(const Predicate& lhs, const double bound);
+Predicate operator>(const Predicate& lhs, const Parameter& bound);
+Predicate operator>=(const Predicate& lhs, const Parameter& bound);
+Predicate operator<(const Predicate& lhs, const Parameter& bound);
+Predicate operator<=(const Predicate& lhs, const Parameter& bound);
 
 Expr operator~(const Expr& e);
 Expr operator&(const Expr& lhs, const Expr& rhs);
 Expr operator|(const Expr& lhs, const Expr& rhs);
 Expr operator>>(const Expr& lhs, const Expr& rhs);
 
+/**
+ * How far into the past and the future of the time a formula is evaluated at its
+ * truth (or robustness) can depend on the trace.
+ *
+ * The horizon of a formula is computed from the intervals of its temporal operators,
+ * and is infinite if the formula has an unbounded temporal operator.
+ */
+struct Horizon {
+  double past   = 0.0;
+  double future = 0.0;
+
+  [[nodiscard]] bool is_bounded() const {
+    return !std::isinf(past) && !std::isinf(future);
+  }
+};
+
+/// Compute the past and future horizon of `phi`.
+///
+/// Parameters are taken at their default values.
+Horizon horizon(const Expr& phi);
+
+/// The names of the parameters in `phi`.
+std::set<std::string> parameters(const Expr& phi);
+
+/**
+ * Bind the parameters of `phi` to `values`.
+ *
+ * Parameters that are not in `values` are bound to their default values, so the
+ * resulting formula has no parameters.
+ *
+ * @throws std::invalid_argument if an interval bound is bound to a negative value, or
+ * the upper bound of an interval to a value less than its lower bound.
+ */
+Expr substitute(const Expr& phi, const ParameterValues& values);
+
 } // namespace ast
 
 using ast::Expr;
@@ -261,6 +393,12 @@ Expr Eventually(Expr arg);
 Expr Eventually(Expr arg, ast::Interval interval);
 Expr Until(Expr arg1, Expr arg2);
 Expr Until(Expr arg1, Expr arg2, ast::Interval interval);
+Expr Historically(Expr arg);
+Expr Historically(Expr arg, ast::Interval interval);
+Expr Once(Expr arg);
+Expr Once(Expr arg, ast::Interval interval);
+Expr Since(Expr arg1, Expr arg2);
+Expr Since(Expr arg1, Expr arg2, ast::Interval interval);
 
 } // namespace signal_tl
 
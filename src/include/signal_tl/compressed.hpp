@@ -0,0 +1,155 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_COMPRESSED_HPP
+#define SIGNAL_TEMPORAL_LOGIC_COMPRESSED_HPP
+
+#include "signal_tl/signal.hpp"
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <vector>  // for vector
+
+namespace signal_tl::signal {
+
+/**
+ * Append-only, compressed storage for long signals.
+ *
+ * The samples are stored in blocks of (at most) `block_size` samples. Each block keeps
+ * its first sample verbatim, and encodes the rest of its samples in a bit stream
+ * (Gorilla-style): timestamps as the delta-of-delta of their bit patterns, and values
+ * as the XOR with the previous value. Regularly sampled, slowly changing signals take a
+ * few bits per sample instead of the 24 bytes of a `Sample`. Derivatives are not
+ * stored, and are recomputed when a block is decoded.
+ *
+ * The blocks are decoded one at a time, either sequentially (`for_each_block`), or
+ * through the index of block start times (`at`, `find_block`, `decompress(start,
+ * end)`).
+ */
+struct CompressedSignal {
+  static constexpr size_t default_block_size = 1024;
+
+ private:
+  struct Block {
+    double begin_time  = 0.0;
+    double end_time    = 0.0;
+    double first_value = 0.0;
+    size_t size        = 0;
+    std::vector<std::uint64_t> words;
+    size_t n_bits = 0;
+  };
+
+  /// State of the encoder for the last block.
+  struct Encoder {
+    std::uint64_t time_bits  = 0;
+    std::uint64_t delta      = 0;
+    std::uint64_t value_bits = 0;
+    unsigned leading         = 0;
+    unsigned trailing        = 0;
+  };
+
+  std::vector<Block> blocks;
+  std::vector<double> block_times; // Begin time of each block, for lookups.
+  Encoder encoder;
+  size_t block_size;
+  size_t n_samples     = 0;
+  Interpolation interp = Interpolation::Linear;
+
+ public:
+  explicit CompressedSignal(
+      Interpolation interpolation = Interpolation::Linear,
+      size_t samples_per_block    = default_block_size);
+
+  /**
+   * Compress the samples of `sig`.
+   */
+  explicit CompressedSignal(
+      const Signal& sig,
+      size_t samples_per_block = default_block_size);
+
+  /**
+   * Add a sample to the back of the signal.
+   *
+   * @throws std::invalid_argument if `time` is not after the end of the signal.
+   */
+  void push_back(double time, double value);
+
+  [[nodiscard]] Interpolation interpolation() const {
+    return this->interp;
+  }
+
+  [[nodiscard]] size_t size() const {
+    return this->n_samples;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return this->n_samples == 0;
+  }
+
+  [[nodiscard]] double begin_time() const {
+    return (this->empty()) ? 0.0 : this->blocks.front().begin_time;
+  }
+
+  [[nodiscard]] double end_time() const {
+    return (this->empty()) ? 0.0 : this->blocks.back().end_time;
+  }
+
+  [[nodiscard]] size_t num_blocks() const {
+    return this->blocks.size();
+  }
+
+  /**
+   * Approximate number of bytes used to store the signal.
+   */
+  [[nodiscard]] size_t memory_usage() const;
+
+  /**
+   * Get the index of the block containing the time point `t`, i.e., the last block
+   * that begins at or before `t` (or the first block if `t` is before the signal).
+   */
+  [[nodiscard]] size_t find_block(double t) const;
+
+  /**
+   * Decode the samples (with derivatives) of the `i`-th block into `out`, replacing
+   * its contents.
+   */
+  void decode_block(size_t i, std::vector<Sample>& out) const;
+
+  /**
+   * Call `fn(const std::vector<Sample>&)` with the decoded samples of each block, in
+   * order. A single buffer is reused for all the blocks.
+   */
+  template <typename Fn>
+  void for_each_block(Fn&& fn) const {
+    auto buffer = std::vector<Sample>{};
+    buffer.reserve(this->block_size);
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+      this->decode_block(i, buffer);
+      fn(static_cast<const std::vector<Sample>&>(buffer));
+    }
+  }
+
+  /**
+   * Get the value of the signal at time `t`.
+   *
+   * Only the block containing `t` is decoded.
+   *
+   * @throws std::out_of_range if `t` is outside the domain of the signal.
+   */
+  [[nodiscard]] Sample at(double t) const;
+
+  /**
+   * Decompress the whole signal.
+   */
+  [[nodiscard]] SignalPtr decompress() const;
+
+  /**
+   * Decompress the blocks overlapping with `[start, end]`.
+   *
+   * The output covers (at least) `[start, end]` restricted to the domain of the signal.
+   */
+  [[nodiscard]] SignalPtr decompress(double start, double end) const;
+};
+
+} // namespace signal_tl::signal
+
+#endif
@@ -53,10 +53,25 @@ struct fmt::formatter<signal_tl::ast::Predicate>
         op = "<";
         break;
     }
+    if (!e.param.empty()) {
+      return format_to(ctx.out(), "({} {} {})", e.name, op, e.param);
+    }
     return format_to(ctx.out(), "({} {} {})", e.name, op, e.rhs);
   }
 };
 
+template <>
+struct fmt::formatter<signal_tl::ast::Interval>
+    : signal_tl::ast::formatter<signal_tl::ast::Interval> {
+  template <typename FormatContext>
+  auto format(const signal_tl::ast::Interval& e, FormatContext& ctx) {
+    const auto [a, b] = e.as_double();
+    const auto low    = (e.low_param.empty()) ? fmt::to_string(a) : e.low_param;
+    const auto high   = (e.high_param.empty()) ? fmt::to_string(b) : e.high_param;
+    return format_to(ctx.out(), "[{},{}]", low, high);
+  }
+};
+
 template <>
 struct fmt::formatter<signal_tl::ast::Not>
     : signal_tl::ast::formatter<signal_tl::ast::Not> {
@@ -89,7 +104,10 @@ struct fmt::formatter<signal_tl::ast::Always>
     : signal_tl::ast::formatter<signal_tl::ast::Always> {
   template <typename FormatContext>
   auto format(const signal_tl::ast::Always& e, FormatContext& ctx) {
-    if (e.interval.has_value()) {
+    if (e.interval.is_parametric()) {
+      return format_to(ctx.out(), "G{} {}", e.interval, e.arg);
+    }
+    if (!e.interval.is_zero_to_inf()) {
       const auto [a, b] = e.interval.as_double();
       if (std::isinf(b)) {
         return format_to(ctx.out(), "G[{}, int) {}", a, e.arg);
@@ -105,7 +123,10 @@ struct fmt::formatter<signal_tl::ast::Eventually>
     : signal_tl::ast::formatter<signal_tl::ast::Eventually> {
   template <typename FormatContext>
   auto format(const signal_tl::ast::Eventually& e, FormatContext& ctx) {
-    if (e.interval.has_value()) {
+    if (e.interval.is_parametric()) {
+      return format_to(ctx.out(), "F{} {}", e.interval, e.arg);
+    }
+    if (!e.interval.is_zero_to_inf()) {
       const auto [a, b] = e.interval.as_double();
       if (std::isinf(b)) {
         return format_to(ctx.out(), "F[{}, inf] {}", a, e.arg);
@@ -122,7 +143,10 @@ struct fmt::formatter<signal_tl::ast::Until>
   template <typename FormatContext>
   auto format(const signal_tl::ast::Until& e, FormatContext& ctx) {
     const auto [e1, e2] = e.args;
-    if (e.interval.has_value()) {
+    if (e.interval.is_parametric()) {
+      return format_to(ctx.out(), "{} U{} {}", e1, e.interval, e2);
+    }
+    if (!e.interval.is_zero_to_inf()) {
       const auto [a, b] = e.interval.as_double();
       if (std::isinf(b)) {
         return format_to(ctx.out(), "{} U[{}, inf) {}", e1, a, e2);
@@ -133,6 +157,43 @@ struct fmt::formatter<signal_tl::ast::Until>
   }
 };
 
+template <>
+struct fmt::formatter<signal_tl::ast::Historically>
+    : signal_tl::ast::formatter<signal_tl::ast::Historically> {
+  template <typename FormatContext>
+  auto format(const signal_tl::ast::Historically& e, FormatContext& ctx) {
+    if (!e.interval.is_zero_to_inf()) {
+      return format_to(ctx.out(), "H{} {}", e.interval, e.arg);
+    }
+    return format_to(ctx.out(), "H {}", e.arg);
+  }
+};
+
+template <>
+struct fmt::formatter<signal_tl::ast::Once>
+    : signal_tl::ast::formatter<signal_tl::ast::Once> {
+  template <typename FormatContext>
+  auto format(const signal_tl::ast::Once& e, FormatContext& ctx) {
+    if (!e.interval.is_zero_to_inf()) {
+      return format_to(ctx.out(), "O{} {}", e.interval, e.arg);
+    }
+    return format_to(ctx.out(), "O {}", e.arg);
+  }
+};
+
+template <>
+struct fmt::formatter<signal_tl::ast::Since>
+    : signal_tl::ast::formatter<signal_tl::ast::Since> {
+  template <typename FormatContext>
+  auto format(const signal_tl::ast::Since& e, FormatContext& ctx) {
+    const auto [e1, e2] = e.args;
+    if (!e.interval.is_zero_to_inf()) {
+      return format_to(ctx.out(), "{} S{} {}", e1, e.interval, e2);
+    }
+    return format_to(ctx.out(), "{} S {}", e1, e2);
+  }
+};
+
 inline std::ostream& operator<<(std::ostream& os, const signal_tl::ast::Expr& expr) {
   std::string s = std::visit(
       signal_tl::utils::overloaded{
@@ -166,26 +227,26 @@ struct fmt::formatter<signal_tl::ast::Expr>
   }
 };
 
-template <>
-struct fmt::formatter<signal_tl::signal::Sample> {
+template <typename T, typename V>
+struct fmt::formatter<signal_tl::signal::BasicSample<T, V>> {
   constexpr auto parse(format_parse_context& ctx) {
     return ctx.begin();
   }
 
   template <typename FormatContext>
-  auto format(const signal_tl::signal::Sample& s, FormatContext& ctx) {
+  auto format(const signal_tl::signal::BasicSample<T, V>& s, FormatContext& ctx) {
     return format_to(ctx.out(), "({}, {})", s.time, s.value);
   }
 };
 
-template <>
-struct fmt::formatter<signal_tl::signal::Signal> {
+template <typename T, typename V>
+struct fmt::formatter<signal_tl::signal::BasicSignal<T, V>> {
   constexpr auto parse(format_parse_context& ctx) {
     return ctx.begin();
   }
 
   template <typename FormatContext>
-  auto format(const signal_tl::signal::Signal& s, FormatContext& ctx) {
+  auto format(const signal_tl::signal::BasicSignal<T, V>& s, FormatContext& ctx) {
     return format_to(ctx.out(), "[{}]", fmt::join(s, ", "));
   }
 };
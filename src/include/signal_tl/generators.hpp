@@ -0,0 +1,123 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_GENERATORS_HPP
+#define SIGNAL_TEMPORAL_LOGIC_GENERATORS_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <map>     // for map
+#include <string>  // for string
+#include <vector>  // for vector
+
+/**
+ * Random signals and formulas with controlled shapes, for benchmarks and stress tests.
+ *
+ * Every generator is deterministic given its `seed`, so a workload is reproduced by
+ * its options and seed alone.
+ */
+namespace signal_tl::generators {
+
+/// Options for `random_signal`.
+struct SignalOptions {
+  /// The number of samples.
+  size_t length = 1000;
+  /// The time of the first sample, and the mean time between samples.
+  double begin  = 0.0;
+  double period = 1.0;
+  /// Each sampling time is moved by up to `jitter * period / 2`, uniformly at random.
+  /// Must be in `[0, 1)`, so the times stay increasing.
+  double jitter = 0.0;
+  /// The probability that the signal crosses `0` between two consecutive samples, i.e.,
+  /// the expected number of crossings per sample. Must be in `[0, 1]`.
+  double crossings = 0.1;
+  /// The magnitude of the samples is uniform in `[amplitude / 10, amplitude]`, before
+  /// the noise is added.
+  double amplitude = 1.0;
+  /// The standard deviation of the gaussian noise added to every sample.
+  double noise = 0.0;
+};
+
+/**
+ * Generate a piecewise-linear signal.
+ *
+ * The sign of the samples flips with probability `options.crossings` from one sample
+ * to the next, so the density of the zero crossings (of the noiseless signal) is
+ * controlled directly, independently of the length.
+ *
+ * @throws std::invalid_argument if an option is out of its range.
+ */
+signal::SignalPtr random_signal(const SignalOptions& options, std::uint64_t seed = 0);
+
+/**
+ * Generate a trace with a signal for each of `names`, with the same options.
+ *
+ * The signals are independent (each is generated from its own seed, derived from
+ * `seed`). They are sampled at the same times if `options.jitter` is `0`.
+ */
+signal::Trace random_trace(
+    const std::vector<std::string>& names,
+    const SignalOptions& options,
+    std::uint64_t seed = 0);
+
+/// Options for `random_formula`.
+struct FormulaOptions {
+  /// The signals compared in the predicates.
+  std::vector<std::string> signals = {"x"};
+  /// The maximum depth of the formula: a predicate has depth `1`.
+  size_t depth = 4;
+  /// The probability that a subformula above the maximum depth is a predicate.
+  double leaf_probability = 0.2;
+  /// The maximum number of operands of a conjunction or disjunction (at least `2`).
+  size_t fanout = 3;
+  /// The thresholds of the predicates are uniform in `[min_threshold, max_threshold]`.
+  double min_threshold = 0.0;
+  double max_threshold = 1.0;
+  /// Whether the future-time (`Always`, `Eventually`, `Until`) and the past-time
+  /// (`Historically`, `Once`, `Since`) operators are used.
+  bool future = true;
+  bool past   = false;
+  /// The probability that a temporal operator has a bounded interval, `[a, a + w]`
+  /// with `a` uniform in `[0, max_interval_start]` and `w` exponentially distributed
+  /// with mean `mean_interval_width`. Otherwise, the interval is `[0, inf)`.
+  double bounded_probability = 0.5;
+  double max_interval_start  = 5.0;
+  double mean_interval_width = 10.0;
+};
+
+/**
+ * Generate a formula.
+ *
+ * Each subformula above the maximum depth is a predicate with probability
+ * `options.leaf_probability`, and otherwise a negation, conjunction, disjunction or
+ * one of the enabled temporal operators, chosen uniformly.
+ *
+ * @throws std::invalid_argument if an option is out of its range.
+ */
+ast::Expr random_formula(const FormulaOptions& options, std::uint64_t seed = 0);
+
+/**
+ * Write `phi` in the syntax of the specification files read by `parser::from_string`.
+ *
+ * The specification language has no intervals and only non-negative numbers, so
+ * `phi` can only have unbounded temporal operators and non-negative thresholds:
+ * generate it with `bounded_probability = 0` and `min_threshold >= 0`.
+ *
+ * @throws std::invalid_argument if `phi` cannot be written in the specification
+ * language.
+ */
+std::string to_spec(const ast::Expr& phi);
+
+/**
+ * Write a specification file that asserts each of the named formulas.
+ *
+ * @throws std::invalid_argument if a formula cannot be written in the specification
+ * language (see `to_spec`).
+ */
+std::string to_spec(const std::map<std::string, ast::Expr>& assertions);
+
+} // namespace signal_tl::generators
+
+#endif
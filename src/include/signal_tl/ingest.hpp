@@ -0,0 +1,127 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_INGEST_HPP
+#define SIGNAL_TEMPORAL_LOGIC_INGEST_HPP
+
+#include "signal_tl/online.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/internal/spsc_ring.hpp"
+
+#include <cstddef> // for size_t
+#include <memory>  // for unique_ptr, make_unique, shared_ptr
+#include <vector>  // for vector
+
+namespace signal_tl::semantics {
+
+/**
+ * Lock-free front-end between acquisition threads and an evaluation thread.
+ *
+ * Every producer thread has its own single-producer, single-consumer ring, so pushing
+ * a sample is wait-free and producers never contend with each other or with the
+ * consumer. The evaluation thread drains all the rings in batches, into signals or into
+ * an asynchronous monitor.
+ *
+ * The samples of one producer are drained in the order they were pushed, but the rings
+ * of different producers are drained one after the other. A channel fed by a single
+ * producer in time order can be appended to a signal; otherwise, the `lateness` of a
+ * `BasicAsyncMonitor` absorbs the reordering.
+ */
+template <typename T, typename V>
+class BasicIngestQueue {
+ public:
+  struct Record {
+    size_t channel;
+    T time;
+    V value;
+  };
+
+  /// Create one ring of (at least) `capacity` samples for each of `n_producers`.
+  BasicIngestQueue(size_t n_producers, size_t capacity) {
+    this->rings.reserve(n_producers);
+    for (size_t i = 0; i < n_producers; i++) {
+      this->rings.push_back(std::make_unique<concurrent::SpscRing<Record>>(capacity));
+    }
+    this->pending.resize(n_producers);
+  }
+
+  [[nodiscard]] size_t producers() const {
+    return this->rings.size();
+  }
+
+  /**
+   * Push a sample of `channel` from the thread of `producer`. Only one thread may push
+   * as a given producer.
+   *
+   * @return `false` if the ring of the producer is full, and the sample was not pushed.
+   */
+  bool push(size_t producer, size_t channel, T time, V value) {
+    return this->rings[producer]->try_push(Record{channel, time, value});
+  }
+
+  /**
+   * Call `fn` on every record pushed before the call, from the consumer thread, and
+   * return the number of records.
+   *
+   * The rings are taken in turns, at most `batch` records at a time, so a busy producer
+   * cannot delay the others by more than a batch. Records pushed during the call are
+   * left for the next one, so a producer that keeps up with `fn` cannot keep the
+   * consumer here forever.
+   */
+  template <typename Fn>
+  size_t consume(Fn&& fn, size_t batch = 1024) {
+    if (batch == 0) {
+      batch = 1;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < this->rings.size(); i++) {
+      this->pending[i] = this->rings[i]->size();
+      total += this->pending[i];
+    }
+    for (size_t left = total; left > 0;) {
+      for (size_t i = 0; i < this->rings.size(); i++) {
+        const size_t n = (this->pending[i] < batch) ? this->pending[i] : batch;
+        if (n > 0) {
+          this->rings[i]->consume(fn, n);
+          this->pending[i] -= n;
+          left -= n;
+        }
+      }
+    }
+    return total;
+  }
+
+  /**
+   * Append the records to `signals`, indexed by their channel.
+   *
+   * @throws std::out_of_range if a channel has no signal.
+   * @throws std::invalid_argument if a sample is not after the end of its signal.
+   */
+  size_t drain(std::vector<std::shared_ptr<signal::BasicSignal<T, V>>>& signals) {
+    return this->consume([&signals](const Record& r) {
+      signals.at(r.channel)->push_back(r.time, r.value);
+    });
+  }
+
+  /**
+   * Push the records to `monitor`, indexed by the channels of the monitor. Records that
+   * are dropped by the monitor are counted in `monitor.dropped()`.
+   *
+   * @throws std::out_of_range if the monitor has no such channel.
+   */
+  size_t drain(BasicAsyncMonitor<T, V>& monitor) {
+    return this->consume(
+        [&monitor](const Record& r) { monitor.push(r.channel, r.time, r.value); });
+  }
+
+ private:
+  std::vector<std::unique_ptr<concurrent::SpscRing<Record>>> rings;
+  /// The records of each ring that are left to consume in the current call.
+  std::vector<size_t> pending;
+};
+
+using IngestQueue = BasicIngestQueue<double, double>;
+
+} // namespace signal_tl::semantics
+
+#endif
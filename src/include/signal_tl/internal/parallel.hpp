@@ -0,0 +1,72 @@
+#ifndef SIGNAL_TEMPORAL_LOGIC_PARALLEL_HPP
+#define SIGNAL_TEMPORAL_LOGIC_PARALLEL_HPP
+
+#include <algorithm> // for min
+#include <atomic>    // for atomic
+#include <cstddef>   // for size_t
+#include <exception> // for exception_ptr, current_exception, rethrow_exception
+#include <mutex>     // for mutex, lock_guard
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+namespace signal_tl::parallel {
+
+/**
+ * Number of worker threads to use when `n_threads == 0` is requested.
+ */
+inline size_t default_num_threads() {
+  const size_t n = std::thread::hardware_concurrency();
+  return (n == 0) ? 1 : n;
+}
+
+/**
+ * Call `fn(i)` for every `i` in `[0, n)` using (at most) `n_threads` native threads.
+ *
+ * Work is handed out one index at a time from a shared counter, so uneven per-item
+ * costs are balanced across the threads. If any call throws, the remaining items are
+ * skipped and the first exception is rethrown in the calling thread.
+ */
+template <typename Fn>
+void parallel_for(size_t n, size_t n_threads, Fn&& fn) {
+  if (n_threads == 0) {
+    n_threads = default_num_threads();
+  }
+  n_threads = std::min(n_threads, n);
+
+  if (n_threads <= 1) {
+    for (size_t i = 0; i < n; i++) { fn(i); }
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error = nullptr;
+  std::mutex error_mtx;
+
+  auto worker = [&]() {
+    for (size_t i = next++; i < n && !failed; i = next++) {
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{error_mtx};
+        if (!failed.exchange(true)) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  auto workers = std::vector<std::thread>{};
+  workers.reserve(n_threads - 1);
+  for (size_t k = 1; k < n_threads; k++) { workers.emplace_back(worker); }
+  worker();
+  for (auto& w : workers) { w.join(); }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace signal_tl::parallel
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef SIGNAL_TEMPORAL_LOGIC_SPSC_RING_HPP
+#define SIGNAL_TEMPORAL_LOGIC_SPSC_RING_HPP
+
+#include <atomic>  // for atomic, memory_order_acquire, memory_order_release
+#include <cstddef> // for size_t
+#include <limits>  // for numeric_limits
+#include <vector>  // for vector
+
+namespace signal_tl::concurrent {
+
+/**
+ * Bounded, lock-free queue between one producer thread and one consumer thread.
+ *
+ * The capacity is rounded up to a power of two, so the (unbounded) counters of the
+ * read and write positions wrap around the slots with a mask. Each side owns one
+ * counter and only reads the other one when its cached copy says that the ring is full
+ * (or empty), so in steady state a push and a pop touch no shared cache line but the
+ * slot itself. Neither side ever blocks: `try_push` fails when the ring is full.
+ */
+template <typename E>
+class SpscRing {
+  /// Size of a cache line, to keep the counters of the two sides apart.
+  static constexpr size_t LINE = 64;
+
+  std::vector<E> slots;
+  size_t mask;
+
+  /// Next slot to read, written by the consumer.
+  alignas(LINE) std::atomic<size_t> head{0};
+  /// The consumer's copy of `tail`.
+  size_t cached_tail = 0;
+  /// Next slot to write, written by the producer.
+  alignas(LINE) std::atomic<size_t> tail{0};
+  /// The producer's copy of `head`.
+  size_t cached_head = 0;
+
+ public:
+  explicit SpscRing(size_t min_capacity) {
+    size_t n = 1;
+    while (n < min_capacity) { n <<= 1; }
+    this->slots.resize(n);
+    this->mask = n - 1;
+  }
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  [[nodiscard]] size_t capacity() const {
+    return this->slots.size();
+  }
+
+  /// Number of elements that the consumer can pop, from the consumer thread.
+  [[nodiscard]] size_t size() {
+    this->cached_tail = this->tail.load(std::memory_order_acquire);
+    return this->cached_tail - this->head.load(std::memory_order_relaxed);
+  }
+
+  /// Push `e` from the producer thread, or return `false` if the ring is full.
+  bool try_push(const E& e) {
+    const size_t t = this->tail.load(std::memory_order_relaxed);
+    if (t - this->cached_head == this->slots.size()) {
+      this->cached_head = this->head.load(std::memory_order_acquire);
+      if (t - this->cached_head == this->slots.size()) {
+        return false;
+      }
+    }
+    this->slots[t & this->mask] = e;
+    this->tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop up to `max` elements from the consumer thread, calling `fn` on each of them in
+   * order, and return how many were popped.
+   *
+   * The slots are released to the producer once, after the whole batch. If `fn`
+   * throws, the element it failed on is popped along with the ones before it.
+   */
+  template <typename Fn>
+  size_t consume(Fn&& fn, size_t max = std::numeric_limits<size_t>::max()) {
+    const size_t h = this->head.load(std::memory_order_relaxed);
+    // Only look at the producer's counter if the known elements are not a full batch.
+    if (this->cached_tail - h < max) {
+      this->cached_tail = this->tail.load(std::memory_order_acquire);
+    }
+    const size_t available = this->cached_tail - h;
+    const size_t n         = (available < max) ? available : max;
+
+    size_t i = 0;
+    try {
+      for (; i < n; i++) { fn(this->slots[(h + i) & this->mask]); }
+    } catch (...) {
+      this->head.store(h + i + 1, std::memory_order_release);
+      throw;
+    }
+    if (n > 0) {
+      this->head.store(h + n, std::memory_order_release);
+    }
+    return n;
+  }
+};
+
+} // namespace signal_tl::concurrent
+
+#endif
@@ -0,0 +1,113 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_INTERVAL_SET_HPP
+#define SIGNAL_TEMPORAL_LOGIC_INTERVAL_SET_HPP
+
+#include <cstddef> // for size_t
+#include <cstdint> // for int64_t
+#include <utility> // for pair
+#include <vector>  // for vector
+
+namespace signal_tl::signal {
+
+/**
+ * A set of time points, stored as a sorted list of disjoint closed intervals.
+ *
+ * Intervals that overlap or touch are merged, so the representation of a set is
+ * unique. The set operations are linear in the number of intervals, which is usually
+ * much smaller than the number of samples of the signals the set is computed from.
+ */
+template <typename T>
+class BasicIntervalSet {
+ public:
+  using interval_type  = std::pair<T, T>;
+  using const_iterator = typename std::vector<interval_type>::const_iterator;
+
+ private:
+  std::vector<interval_type> intervals;
+
+ public:
+  BasicIntervalSet() = default;
+
+  /// Create a set from intervals sorted by their start (they may overlap).
+  ///
+  /// @throws std::invalid_argument if the intervals are not sorted, or an interval
+  /// ends before it starts.
+  explicit BasicIntervalSet(const std::vector<interval_type>& sorted);
+
+  /**
+   * Add the interval `[lo, hi]` to the end of the set.
+   *
+   * @throws std::invalid_argument if `hi < lo`, or `lo` is before the start of the
+   * last interval of the set.
+   */
+  void push_back(T lo, T hi);
+
+  [[nodiscard]] size_t size() const {
+    return this->intervals.size();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return this->intervals.empty();
+  }
+
+  [[nodiscard]] const_iterator begin() const {
+    return this->intervals.begin();
+  }
+
+  [[nodiscard]] const_iterator end() const {
+    return this->intervals.end();
+  }
+
+  [[nodiscard]] const interval_type& front() const {
+    return this->intervals.front();
+  }
+
+  [[nodiscard]] const interval_type& back() const {
+    return this->intervals.back();
+  }
+
+  /// Check if the point `t` is in the set.
+  [[nodiscard]] bool contains(T t) const;
+
+  /// The total length of the intervals in the set.
+  [[nodiscard]] T measure() const;
+
+  /// The points in either set.
+  [[nodiscard]] BasicIntervalSet unite(const BasicIntervalSet& other) const;
+
+  /// The points in both sets.
+  [[nodiscard]] BasicIntervalSet intersect(const BasicIntervalSet& other) const;
+
+  /// The closure of the points of `[lo, hi]` that are not in the set.
+  [[nodiscard]] BasicIntervalSet complement(T lo, T hi) const;
+
+  /// The points of the set within `[lo, hi]`.
+  [[nodiscard]] BasicIntervalSet clip(T lo, T hi) const;
+
+  /// The Minkowski sum of the set and `[lo, hi]`, i.e., the points `s + d` for `s` in
+  /// the set and `d` in `[lo, hi]`.
+  [[nodiscard]] BasicIntervalSet minkowski_sum(T lo, T hi) const;
+
+  /// The Minkowski difference of the set and `[lo, hi]`, i.e., the points `t` such
+  /// that `[t + lo, t + hi]` is contained in the set.
+  [[nodiscard]] BasicIntervalSet minkowski_difference(T lo, T hi) const;
+
+  bool operator==(const BasicIntervalSet& other) const {
+    return this->intervals == other.intervals;
+  }
+
+  bool operator!=(const BasicIntervalSet& other) const {
+    return !(*this == other);
+  }
+};
+
+using IntervalSet = BasicIntervalSet<double>;
+
+// The supported time types are instantiated in interval_set.cc.
+extern template class BasicIntervalSet<double>;
+extern template class BasicIntervalSet<std::int64_t>;
+
+} // namespace signal_tl::signal
+
+#endif
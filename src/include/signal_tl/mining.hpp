@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_MINING_HPP
+#define SIGNAL_TEMPORAL_LOGIC_MINING_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <cstddef>  // for size_t
+#include <limits>   // for numeric_limits
+#include <optional> // for optional
+#include <string>   // for string
+#include <vector>   // for vector
+
+namespace signal_tl::semantics {
+
+/// Options for `mine_parameter`.
+struct MiningOptions {
+  /// The range of values searched for the parameter. Every value in the range must be
+  /// a valid value of the parameter (e.g., a non-negative interval bound).
+  double lower = 0.0;
+  double upper = std::numeric_limits<double>::max();
+  /// The search stops once the tightest value is known within this tolerance.
+  double tolerance = 1e-6;
+  /// The time at which the formula is required to hold.
+  double time = 0.0;
+};
+
+/**
+ * Whether the robustness of `phi` increases (`1`) or decreases (`-1`) with the value
+ * of the parameter `param`, or `0` if `phi` does not depend on `param`.
+ *
+ * The robustness of `x >= c` decreases with `c`, the robustness of `F[a, b] x`
+ * increases with `b` and decreases with `a`, the robustness of `G[a, b] x` does the
+ * opposite, and the Boolean operators preserve (or, for negations, flip) the direction
+ * of their operands.
+ *
+ * @throws std::invalid_argument if the robustness of `phi` is not monotonic in
+ * `param`, i.e., `param` appears in places with opposite directions.
+ */
+int monotonicity(const ast::Expr& phi, const std::string& param);
+
+/**
+ * Find the tightest value of the parameter `param` for which `trace` satisfies `phi`.
+ *
+ * The formula holds at `options.time` (its robustness is non-negative) either for all
+ * the values of `param` above some threshold, or for all the values below it (see
+ * `monotonicity`), and this threshold is returned: e.g., the smallest `c` such that
+ * `G[0, T] (x < c)` holds, or the smallest `b` such that `F[0, b] x` holds. Other
+ * parameters of `phi` take their default values.
+ *
+ * If `param` only offsets the robustness of `phi`, i.e., it is the threshold of a
+ * predicate under negations and temporal operators alone, the robustness is evaluated
+ * once and the threshold is computed in closed form. Otherwise, the range of values is
+ * bisected down to `options.tolerance`, and the returned value is on the satisfying
+ * side.
+ *
+ * @returns `std::nullopt` if `phi` does not hold for any value in the range.
+ * @throws std::invalid_argument if `phi` does not depend on `param`, or is not
+ * monotonic in it, or the range of values is empty.
+ */
+template <typename T, typename V>
+std::optional<double> mine_parameter(
+    const ast::Expr& phi,
+    const std::string& param,
+    const signal::BasicTrace<T, V>& trace,
+    const MiningOptions& options = {});
+
+/// Find the tightest value of `param` for which each trace in `traces` satisfies
+/// `phi`, with `mine_parameter`.
+///
+/// The traces are mined concurrently on `n_threads` native threads (`0` uses the
+/// hardware concurrency), and the output is in the same order as `traces`. The value
+/// for which every trace satisfies `phi` is the largest (smallest) of them, if `phi`
+/// is increasing (decreasing) in `param`.
+std::vector<std::optional<double>> mine_parameter_batch(
+    const ast::Expr& phi,
+    const std::string& param,
+    const std::vector<signal::Trace>& traces,
+    const MiningOptions& options = {},
+    size_t n_threads             = 0);
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,186 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_ONLINE_HPP
+#define SIGNAL_TEMPORAL_LOGIC_ONLINE_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/signal.hpp"
+
+#include <cstddef>  // for size_t
+#include <limits>   // for numeric_limits
+#include <map>      // for map
+#include <optional> // for optional
+#include <string>   // for string
+#include <vector>   // for vector
+
+namespace signal_tl::semantics {
+
+/**
+ * Incremental robustness monitor for past-time formulas.
+ *
+ * The monitor is fed the values of the signals at increasing sample times, and returns
+ * the robustness of the formula at each sample as soon as it is given: a formula with
+ * only past-time temporal operators (Historically, Once, and Since) depends on the
+ * samples seen so far, so no verdict waits for the horizon of the formula.
+ *
+ * The signals are taken to hold their value from one sample to the next, and the
+ * formula is evaluated at the sample times only (a discrete-time semantics). The output
+ * is the value of `compute_robustness` over the step signals of the samples fed so
+ * far when the subformulas only change at the samples, e.g. for uniformly sampled
+ * signals whose period divides the bounds of the nested temporal operators. Otherwise,
+ * a nested window can change the value of a subformula between two samples, where the
+ * monitor does not see it.
+ *
+ * Every node of the formula keeps a state of constant size, except for the bounded
+ * temporal operators, which keep monotonic wedges of the samples in their window. An
+ * update takes O(1) amortized time per node of the formula, and the memory is bounded
+ * by the number of samples within the (past) horizon of the formula.
+ */
+template <typename T, typename V>
+class BasicOnlineMonitor {
+ public:
+  /**
+   * Compile `phi` into a monitor. Parameters are taken at their default values.
+   *
+   * @throws std::invalid_argument if `phi` has a future-time operator (Always,
+   * Eventually, or Until).
+   */
+  explicit BasicOnlineMonitor(const ast::Expr& phi);
+
+  BasicOnlineMonitor(BasicOnlineMonitor&& other) noexcept;
+  BasicOnlineMonitor& operator=(BasicOnlineMonitor&& other) noexcept;
+  ~BasicOnlineMonitor();
+
+  /// The names of the signals in the formula, in the order of the values given to
+  /// `update`.
+  [[nodiscard]] const std::vector<std::string>& signals() const {
+    return this->names;
+  }
+
+  /**
+   * Feed the values of the signals at `time`, and return the robustness of the
+   * formula at `time`.
+   *
+   * @throws std::invalid_argument if `time` is not after the time of the last update.
+   * @throws std::out_of_range if `values` does not have a value for every signal.
+   */
+  V update(T time, const std::map<std::string, V>& values);
+
+  /**
+   * Same as `update`, with the values of the signals in the order of `signals()`.
+   *
+   * @throws std::out_of_range if `values` does not have one value per signal.
+   */
+  V update(T time, const std::vector<V>& values);
+
+ private:
+  struct Node;
+
+  /// The nodes of the formula, in post-order: the formula is the last one.
+  std::vector<Node> nodes;
+  std::vector<std::string> names;
+  /// The robustness of each node at the last update.
+  std::vector<V> outputs;
+  /// Scratch space for the values given by name.
+  std::vector<V> inputs;
+  T last_time  = {};
+  bool started = false;
+
+  size_t compile(const ast::Expr& phi);
+};
+
+/**
+ * Online monitor fed by channels that are sampled independently.
+ *
+ * Each signal of the formula is a channel, whose samples can arrive at their own rate
+ * and out of order, as long as they are at most `lateness` behind the latest sample of
+ * the channel. The watermark of a channel is the time up to which it has no more
+ * samples to come: `lateness` before its latest sample, or a time declared with
+ * `heartbeat`. No channel can change the trace before the minimum of the watermarks,
+ * so `poll` evaluates the formula at the sample times up to that safe time, with every
+ * channel holding its latest value, and the samples before it are freed.
+ *
+ * The verdicts start at the first time at which every channel has a sample. A sample
+ * at or before the last time that was evaluated comes too late to be used: it is
+ * dropped, like a second sample at the same time on a channel.
+ */
+template <typename T, typename V>
+class BasicAsyncMonitor {
+ public:
+  using sample_type = signal::BasicSample<T, V>;
+
+  /**
+   * Compile `phi` into a monitor that accepts samples up to `lateness` out of order.
+   *
+   * @throws std::invalid_argument if `phi` has a future-time operator, or if
+   * `lateness` is negative.
+   */
+  explicit BasicAsyncMonitor(const ast::Expr& phi, T lateness = {});
+
+  /// The names of the channels, in the order of their indices.
+  [[nodiscard]] const std::vector<std::string>& signals() const {
+    return this->monitor.signals();
+  }
+
+  /**
+   * Buffer the sample `(time, value)` of the channel `name` or `channel`.
+   *
+   * @return `false` if the sample is dropped, as it comes too late or repeats a time.
+   * @throws std::out_of_range if there is no such channel.
+   */
+  bool push(const std::string& name, T time, V value);
+  bool push(size_t channel, T time, V value);
+
+  /**
+   * Declare that the channel `name` or `channel` has no more samples at or before
+   * `time`, to release a channel that is slower than the others.
+   *
+   * @throws std::out_of_range if there is no such channel.
+   */
+  void heartbeat(const std::string& name, T time);
+  void heartbeat(size_t channel, T time);
+
+  /// The safe time: the minimum of the watermarks of the channels.
+  [[nodiscard]] T watermark() const;
+
+  /// The number of samples that were dropped.
+  [[nodiscard]] size_t dropped() const {
+    return this->n_dropped;
+  }
+
+  /// Evaluate the formula at the sample times up to the safe time, and return the
+  /// robustness at each of them.
+  std::vector<sample_type> poll();
+
+  /// Evaluate the formula at all the buffered sample times, at the end of the streams.
+  std::vector<sample_type> flush();
+
+ private:
+  struct Channel {
+    /// The samples after the last evaluated time, by time.
+    std::map<T, V> pending = {};
+    /// The latest sample that was evaluated.
+    std::optional<V> held = std::nullopt;
+    T watermark           = std::numeric_limits<T>::lowest();
+  };
+
+  BasicOnlineMonitor<T, V> monitor;
+  T lateness;
+  std::vector<Channel> channels;
+  /// The held values of the channels, in the order of `signals()`.
+  std::vector<V> values;
+  size_t n_ready   = 0;
+  size_t n_dropped = 0;
+  /// The last time that was evaluated.
+  std::optional<T> frontier = std::nullopt;
+
+  size_t index_of(const std::string& name) const;
+  std::vector<sample_type> release(T until);
+};
+
+using OnlineMonitor = BasicOnlineMonitor<double, double>;
+using AsyncMonitor  = BasicAsyncMonitor<double, double>;
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_RANGE_INDEX_HPP
+#define SIGNAL_TEMPORAL_LOGIC_RANGE_INDEX_HPP
+
+#include "signal_tl/signal.hpp"
+
+#include <cstddef> // for size_t
+#include <cstdint> // for int64_t
+#include <utility> // for pair
+#include <vector>  // for vector
+
+namespace signal_tl::signal {
+
+/**
+ * Index answering range min/max queries over a signal.
+ *
+ * The index keeps a copy of the samples of the signal, and sparse tables with the
+ * min/max of the values of the samples over every range of `2^k` samples. The extrema
+ * of the signal over a time window are attained either at the ends of the window
+ * (interpolated between samples) or at the samples inside it, so any window is
+ * answered in `O(log n)` time (the binary search for the ends of the window), however
+ * wide it is.
+ *
+ * Building the index takes `O(n log n)` time and memory, which pays off when the same
+ * signal is queried with many different windows. Use `BasicSignal::range_index()` to
+ * build (and cache) the index of a signal.
+ */
+template <typename T, typename V>
+class BasicRangeIndex {
+  using sample_type = BasicSample<T, V>;
+
+  std::vector<sample_type> samples;
+  /// `lo[k][i]` (`hi[k][i]`) is the min (max) value of the samples `[i, i + 2^k)`.
+  std::vector<std::vector<V>> lo;
+  std::vector<std::vector<V>> hi;
+
+  /// The value of the signal at `t`, holding the first (last) value before (after) the
+  /// signal.
+  [[nodiscard]] V value_at(T t) const;
+
+  /// The first sample timed after `start`, and the first sample timed at or after
+  /// `end`, i.e., the samples strictly inside the window.
+  [[nodiscard]] std::pair<size_t, size_t> interior(T start, T end) const;
+
+ public:
+  explicit BasicRangeIndex(const BasicSignal<T, V>& sig);
+
+  [[nodiscard]] size_t size() const {
+    return this->samples.size();
+  }
+
+  /**
+   * The minimum value of the signal over the time window `[start, end]`.
+   *
+   * Before (after) the signal, it takes its first (last) value.
+   */
+  [[nodiscard]] V min(T start, T end) const;
+
+  /**
+   * The maximum value of the signal over the time window `[start, end]`.
+   *
+   * Before (after) the signal, it takes its first (last) value.
+   */
+  [[nodiscard]] V max(T start, T end) const;
+
+  /**
+   * Approximate number of bytes used by the index.
+   */
+  [[nodiscard]] size_t memory_usage() const;
+};
+
+using RangeIndex = BasicRangeIndex<double, double>;
+
+// The supported combinations of time and value types are instantiated in
+// range_index.cc.
+extern template class BasicRangeIndex<double, double>;
+extern template class BasicRangeIndex<double, float>;
+extern template class BasicRangeIndex<std::int64_t, double>;
+extern template class BasicRangeIndex<std::int64_t, float>;
+
+} // namespace signal_tl::signal
+
+#endif
@@ -6,14 +6,127 @@
 #include "signal_tl/ast.hpp"
 #include "signal_tl/signal.hpp"
 
+#include <cstddef>
+#include <limits>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace signal_tl::semantics {
 
-signal::SignalPtr compute_robustness(
+/// Options for `compute_robustness`.
+struct RobustnessOptions {
+  /// Whether the signals in the trace are already synchronized.
+  bool synchronized = false;
+  /// If positive, the predicates and the output of every operator are simplified
+  /// with `Signal::simplify(epsilon)` as they are computed. This trades accuracy for
+  /// speed on long, noisy signals.
+  double epsilon = 0.0;
+  /// The time interval over which the robustness is needed.
+  ///
+  /// Each subformula is only evaluated over the times the robustness over this
+  /// interval depends on, i.e., the interval widened by the windows of the temporal
+  /// operators above it. The output is restricted to this interval (intersected with
+  /// the domain of the trace). For example, the robustness at time `0` of a bounded
+  /// formula only reads the first few samples of the trace, up to its horizon.
+  double query_begin = -std::numeric_limits<double>::infinity();
+  double query_end   = std::numeric_limits<double>::infinity();
+};
+
+/// Diagnostics reported by `compute_robustness`.
+struct RobustnessReport {
+  /// Upper bound on the difference between the computed robustness signal and the
+  /// exact robustness of the input trace, due to simplification.
+  double error_bound = 0.0;
+  /// Estimate (an upper bound) of the peak number of bytes held by intermediate
+  /// signals during the evaluation, excluding the input trace.
+  size_t peak_memory = 0;
+};
+
+/// Compute the robustness signal of `phi` over `trace`.
+///
+/// The computation is done in the time and value types of the signals in the trace,
+/// and is available for `double` or `int64_t` times and `double` or `float` values.
+/// Interval bounds in `phi` are converted to the time type of the trace (and rounded
+/// to the nearest tick for integral time types).
+template <typename T, typename V>
+signal::BasicSignalPtr<T, V> compute_robustness(
+    const ast::Expr& phi,
+    const signal::BasicTrace<T, V>& trace,
+    bool synchronized = false);
+
+/// Compute the robustness signal of `phi` over `trace` with the given options.
+///
+/// The robustness operators (negation, min/max, and their windowed versions) never
+/// increase the (sup-norm) error of their inputs, so each simplification adds at most
+/// `options.epsilon` to the error of the result. Until and Since are evaluated at the
+/// sample points of their operands, which does not have this property, so their
+/// operands are never simplified. The resulting bound is written to `report`, if
+/// given.
+///
+/// @throws std::invalid_argument if the query interval is empty.
+/// @throws std::out_of_range if the query interval does not intersect the trace.
+template <typename T, typename V>
+signal::BasicSignalPtr<T, V> compute_robustness(
+    const ast::Expr& phi,
+    const signal::BasicTrace<T, V>& trace,
+    const RobustnessOptions& options,
+    RobustnessReport* report = nullptr);
+
+/// Compute the robustness of `phi` at the time `t0` only.
+///
+/// This is the value at `t0` of `compute_robustness(phi, trace)`, but the robustness
+/// signals of the Boolean operators are never built: they are evaluated at `t0`
+/// directly, and only the temporal operators are computed (over their horizon). The
+/// children of a conjunction (disjunction) are visited in increasing (decreasing) order
+/// of a bound on their robustness, computed from the extrema of the signals in the
+/// trace, and the rest are skipped once they cannot change the minimum (maximum).
+///
+/// @throws std::out_of_range if `t0` is outside the trace.
+template <typename T, typename V>
+V compute_robustness_at(
+    const ast::Expr& phi,
+    const signal::BasicTrace<T, V>& trace,
+    T t0);
+
+/// Compute the sign (`-1`, `0`, or `1`) of the robustness of `phi` at the time `t0`.
+///
+/// Like `compute_robustness_at`, but a conjunction (disjunction) stops at the first
+/// child that is violated (satisfied), and children whose bounds are on one side of
+/// `0` are decided without being evaluated.
+///
+/// @throws std::out_of_range if `t0` is outside the trace.
+template <typename T, typename V>
+int compute_sign_at(const ast::Expr& phi, const signal::BasicTrace<T, V>& trace, T t0);
+
+/// Compute the robustness signal of the parametric formula `phi` for each assignment
+/// of its parameters in `grid`.
+///
+/// The output is in the same order as `grid`, and the `i`th signal is the robustness
+/// of `ast::substitute(phi, grid[i])`. The signals of the predicates are shared across
+/// the grid (a threshold only offsets them), as are the subformulas whose parameters
+/// take the same values, so a sweep over the thresholds of a formula costs little more
+/// than a single evaluation.
+///
+/// @throws std::invalid_argument if the query interval is empty, or the grid has an
+/// invalid interval.
+/// @throws std::out_of_range if the query interval does not intersect the trace.
+template <typename T, typename V>
+std::vector<signal::BasicSignalPtr<T, V>> compute_robustness_sweep(
+    const ast::Expr& phi,
+    const signal::BasicTrace<T, V>& trace,
+    const std::vector<ast::ParameterValues>& grid,
+    const RobustnessOptions& options = {});
+
+/// Compute the robustness of `phi` over each trace in `traces`.
+///
+/// The traces are evaluated concurrently on `n_threads` native threads (`0` uses the
+/// hardware concurrency), and the output is in the same order as `traces`. The
+/// signals in the traces are only read, so traces may share signals.
+std::vector<signal::SignalPtr> compute_robustness_batch(
     const ast::Expr& phi,
-    const signal::Trace& trace,
+    const std::vector<signal::Trace>& traces,
+    size_t n_threads  = 0,
     bool synchronized = false);
 
 } // namespace signal_tl::semantics
@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_SATISFACTION_HPP
+#define SIGNAL_TEMPORAL_LOGIC_SATISFACTION_HPP
+
+#include "signal_tl/ast.hpp"
+#include "signal_tl/interval_set.hpp"
+#include "signal_tl/signal.hpp"
+
+namespace signal_tl::semantics {
+
+/**
+ * Compute the set of times at which `trace` satisfies `phi`.
+ *
+ * This is the qualitative counterpart of `compute_robustness`: the output is the set of
+ * times at which the robustness of `phi` is non-negative, up to the end points of its
+ * intervals. The intervals are closed. On linear signals the robustness is zero at
+ * their end points, but a step signal that jumps between a satisfying and a violating
+ * value at `t` puts `t` in the set, whatever the sign of the robustness after the
+ * jump. The satisfaction of every subformula is a set of intervals, computed without
+ * building any robustness signal:
+ *
+ * - a predicate holds between the times at which its signal crosses the threshold;
+ * - negation, conjunction, and disjunction are the complement, intersection, and union
+ *   of the sets;
+ * - `F[a, b]` and `G[a, b]` are the Minkowski sum and difference of the set of their
+ *   operand with the window; and
+ * - `phi U[a, b] psi` holds at `t` if `psi` holds at some `s` in `[t + a, t + b]` and
+ *   `phi` holds over `[t, s]` (or `psi` holds at `t`, if `a = 0`); and
+ * - the past-time operators `O`, `H`, and `S` mirror these over `[t - b, t - a]`.
+ *
+ * Like the robustness, the signals are taken to keep their first (last) value before
+ * (after) they are sampled. Whether a subformula holds past the end (or before the
+ * start) of the trace is decided from the last (first) samples, not from its set.
+ *
+ * The size of the output is the number of times the formula switches between
+ * satisfied and violated, which is usually much smaller than the number of samples in
+ * the trace.
+ */
+template <typename T, typename V>
+signal::BasicIntervalSet<T>
+compute_satisfaction(const ast::Expr& phi, const signal::BasicTrace<T, V>& trace);
+
+} // namespace signal_tl::semantics
+
+#endif
@@ -3,44 +3,76 @@
 #ifndef SIGNAL_TEMPORAL_LOGIC_SIGNAL_HPP
 #define SIGNAL_TEMPORAL_LOGIC_SIGNAL_HPP
 
-#include <algorithm>   // for lower_bound
+#include <algorithm>   // for lower_bound, upper_bound
+#include <cmath>       // for llround
 #include <cstddef>     // for size_t
-#include <iterator>    // for next, prev
+#include <cstdint>     // for int64_t
+#include <iterator>    // for next, prev, make_reverse_iterator
+#include <limits>      // for numeric_limits
 #include <map>         // for map
-#include <memory>      // for shared_ptr, allocator_traits<>::value_type
-#include <stdexcept>   // for invalid_argument
+#include <memory>      // for shared_ptr, atomic_load, atomic_store
+#include <stdexcept>   // for invalid_argument, out_of_range
 #include <string>      // for string
 #include <tuple>       // for tuple
-#include <type_traits> // for declval
+#include <type_traits> // for declval, is_integral_v
+#include <utility>     // for move
 #include <vector>      // for vector
 
 namespace signal_tl::signal {
 
-struct Sample {
-  double time;
-  double value;
-  double derivative = 0.0;
+/**
+ * Convert a time point given as a `double` (e.g., an interval bound from a formula, or
+ * an interpolated crossing point) to the time type `T` of a signal.
+ *
+ * Integral time types (e.g., `int64_t` ticks) are rounded to the nearest tick.
+ */
+template <typename T>
+constexpr T time_cast(double t) {
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<T>(std::llround(t));
+  } else {
+    return static_cast<T>(t);
+  }
+}
+
+/**
+ * A sample of a signal with time type `T` and value type `V`.
+ *
+ * The derivative is the slope of the signal (in units of `V` per unit of `T`) from this
+ * sample to the next one.
+ */
+template <typename T, typename V>
+struct BasicSample {
+  using time_type  = T;
+  using value_type = V;
+
+  T time;
+  V value;
+  V derivative = 0;
 
   /**
    * Linear interpolate the Sample (given the derivative) to get the value at time `t`.
    */
-  [[nodiscard]] constexpr double interpolate(double t) const {
-    return value + derivative * (t - time);
+  [[nodiscard]] constexpr V interpolate(T t) const {
+    return value + derivative * static_cast<V>(t - time);
   }
 
   /**
    * Get the time point at which the lines associated with this Sample and the given
    * Sample intersect.
+   *
+   * The intersection is computed relative to the time of this Sample, so large
+   * (integral) timestamps do not lose precision in the value type.
    */
-  [[nodiscard]] constexpr double time_intersect(const Sample& point) const {
-    return (value - point.value + (point.derivative * point.time) -
-            (derivative * time)) /
-           (point.derivative - derivative);
+  [[nodiscard]] constexpr T time_intersect(const BasicSample& point) const {
+    const V gap = point.interpolate(time) - value;
+    const V dt  = gap / (derivative - point.derivative);
+    return time + time_cast<T>(static_cast<double>(dt));
   }
 
-  [[nodiscard]] constexpr double area(double t) const {
+  [[nodiscard]] constexpr V area(T t) const {
     if (t > time) {
-      return (value + this->interpolate(t)) * (t - time) / 2;
+      return (value + this->interpolate(t)) * static_cast<V>(t - time) / 2;
     } else {
       return 0;
     }
@@ -48,61 +80,214 @@ struct Sample {
 
 }; // namespace signal
 
-constexpr bool operator<(const Sample& lhs, const Sample& rhs) {
+template <typename T, typename V>
+constexpr bool operator<(const BasicSample<T, V>& lhs, const BasicSample<T, V>& rhs) {
   return lhs.value < rhs.value;
 }
-constexpr bool operator>(const Sample& lhs, const Sample& rhs) {
+template <typename T, typename V>
+constexpr bool operator>(const BasicSample<T, V>& lhs, const BasicSample<T, V>& rhs) {
   return rhs < lhs;
 }
-constexpr bool operator<=(const Sample& lhs, const Sample& rhs) {
+template <typename T, typename V>
+constexpr bool operator<=(const BasicSample<T, V>& lhs, const BasicSample<T, V>& rhs) {
   return !(lhs > rhs);
 }
-constexpr bool operator>=(const Sample& lhs, const Sample& rhs) {
+template <typename T, typename V>
+constexpr bool operator>=(const BasicSample<T, V>& lhs, const BasicSample<T, V>& rhs) {
   return !(lhs < rhs);
 }
 
-constexpr Sample operator-(const Sample& other) {
+template <typename T, typename V>
+constexpr BasicSample<T, V> operator-(const BasicSample<T, V>& other) {
   return {other.time, -other.value, -other.derivative};
 }
 
 /**
- * Piecewise-linear, right-continuous signal
+ * How the value of a Signal is interpolated between two consecutive samples.
  */
-struct Signal {
+enum class Interpolation {
+  /// The value changes linearly from one sample to the next.
+  Linear,
+  /// The value is held constant until the next sample (zero-order hold).
+  ///
+  /// The derivatives of the samples in such a signal are always 0, and the min/max
+  /// kernels do not need to compute the crossing points of such signals.
+  Step
+};
+
+template <typename T, typename V>
+class BasicRangeIndex;
+
+/**
+ * Summary statistics of the samples of a signal.
+ *
+ * The extrema of a (piecewise-linear or step) signal are always attained at its
+ * samples, so these also summarize the values of the signal in between.
+ */
+template <typename T, typename V>
+struct BasicSignalSummary {
+  V min = std::numeric_limits<V>::infinity();
+  V max = -std::numeric_limits<V>::infinity();
+  /// Index of the last sample with the minimum value.
+  size_t argmin = 0;
+  /// Index of the last sample with the maximum value.
+  size_t argmax = 0;
+  /// Whether the values never decrease (increase) from one sample to the next.
+  bool nondecreasing = true;
+  bool nonincreasing = true;
+  /// Whether the samples are evenly spaced in time.
+  bool uniform = true;
+};
+
+/**
+ * Piecewise-linear, right-continuous signal with time type `T` and value type `V`.
+ *
+ * Use `Signal` for the default `double` times and values. Smaller value types (e.g.,
+ * `float`) halve the memory traffic of the robustness kernels, and integral time types
+ * (e.g., `int64_t` nanosecond ticks) keep timestamps exact. Crossing points between
+ * samples are rounded to the nearest tick in the latter case.
+ *
+ * The samples of a signal are either owned by the signal, or borrowed from some
+ * external, read-only storage (see `BasicSignal(std::shared_ptr<const Sample>,
+ * size_t)`). A signal that borrows its samples copies them into its own storage the
+ * first time it is modified.
+ *
+ * The summary statistics of the samples (see `summary()`) are computed the first time
+ * they are needed, and cached until the signal is modified.
+ */
+template <typename T, typename V>
+struct BasicSignal {
+  using time_type   = T;
+  using value_type  = V;
+  using sample_type = BasicSample<T, V>;
+
  private:
+  using Sample = sample_type;
+
   std::vector<Sample> samples;
 
+  /// If not null, the samples are borrowed from this buffer, and `samples` is unused.
+  std::shared_ptr<const Sample> borrowed = nullptr;
+  size_t borrowed_size                   = 0;
+
+  Interpolation interp = Interpolation::Linear;
+
+  /// Data derived from the samples, computed when it is first needed. The data is
+  /// immutable once computed, and can be shared by copies of the signal, as well as
+  /// read from multiple threads.
+  template <typename Data>
+  struct Cached {
+    std::shared_ptr<const Data> ptr = nullptr;
+
+    Cached() = default;
+    Cached(const Cached& other) : ptr{other.load()} {}
+    Cached& operator=(const Cached& other) {
+      this->store(other.load());
+      return *this;
+    }
+    ~Cached() = default;
+
+    [[nodiscard]] std::shared_ptr<const Data> load() const {
+      return std::atomic_load(&this->ptr);
+    }
+    void store(std::shared_ptr<const Data> data) {
+      std::atomic_store(&this->ptr, std::move(data));
+    }
+  };
+  mutable Cached<BasicSignalSummary<T, V>> summary_cache;
+  mutable Cached<BasicRangeIndex<T, V>> index_cache;
+
+  /// Copy borrowed samples (if any) into storage owned by this signal.
+  void make_owned();
+  /// Drop the cached data, when the samples are modified.
+  void invalidate_cache() {
+    this->summary_cache.store(nullptr);
+    this->index_cache.store(nullptr);
+  }
+
  public:
-  [[nodiscard]] double begin_time() const {
-    return (samples.empty()) ? 0.0 : samples.front().time;
+  /**
+   * Get the interpolation policy of the signal.
+   */
+  [[nodiscard]] Interpolation interpolation() const {
+    return this->interp;
+  }
+
+  [[nodiscard]] T begin_time() const {
+    return (this->empty()) ? T{0} : this->front().time;
   }
 
-  [[nodiscard]] double end_time() const {
-    return (samples.empty()) ? 0.0 : samples.back().time;
+  [[nodiscard]] T end_time() const {
+    return (this->empty()) ? T{0} : this->back().time;
   }
 
-  [[nodiscard]] double interpolate(double t, size_t idx) const {
-    return this->samples.at(idx).interpolate(t);
+  [[nodiscard]] V interpolate(T t, size_t idx) const {
+    return this->at_idx(idx).interpolate(t);
   }
 
-  [[nodiscard]] double time_intersect(const Sample& point, size_t idx) const {
-    return this->samples.at(idx).time_intersect(point);
+  [[nodiscard]] T time_intersect(const Sample& point, size_t idx) const {
+    return this->at_idx(idx).time_intersect(point);
   }
 
-  [[nodiscard]] double area(double t, size_t idx) const {
-    return this->samples.at(idx).area(t);
+  [[nodiscard]] V area(T t, size_t idx) const {
+    return this->at_idx(idx).area(t);
   }
 
   [[nodiscard]] Sample front() const {
-    return this->samples.front();
+    return *this->begin();
   }
 
   [[nodiscard]] Sample back() const {
-    return this->samples.back();
+    return *std::prev(this->end());
   }
 
   [[nodiscard]] Sample at_idx(size_t i) const {
-    return this->samples.at(i);
+    if (i >= this->size()) {
+      throw std::out_of_range("Sample index out of range of the Signal");
+    }
+    return this->data()[i];
+  }
+
+  /**
+   * Get a pointer to the contiguous array of samples backing the signal.
+   */
+  [[nodiscard]] const Sample* data() const {
+    return (this->borrowed) ? this->borrowed.get() : this->samples.data();
+  }
+
+  /**
+   * Get the external buffer the samples are borrowed from, or `nullptr` if the signal
+   * owns its samples.
+   */
+  [[nodiscard]] const std::shared_ptr<const Sample>& borrowed_storage() const {
+    return this->borrowed;
+  }
+
+  /**
+   * Get the summary statistics of the samples: the extrema and where they are attained,
+   * and whether the signal is monotonic or uniformly sampled.
+   *
+   * The summary is computed in one pass over the samples the first time it is needed,
+   * and is then cached until the signal is modified.
+   */
+  [[nodiscard]] BasicSignalSummary<T, V> summary() const;
+
+  /**
+   * Get the range min/max index of the samples (see `BasicRangeIndex`), building it if
+   * needed.
+   *
+   * The index takes `O(n log n)` time and memory to build, and is then cached until
+   * the signal is modified.
+   */
+  [[nodiscard]] std::shared_ptr<const BasicRangeIndex<T, V>> range_index() const;
+
+  /**
+   * Get the range min/max index of the samples if it has already been built, or
+   * `nullptr` otherwise.
+   */
+  [[nodiscard]] std::shared_ptr<const BasicRangeIndex<T, V>>
+  cached_range_index() const {
+    return this->index_cache.load();
   }
 
   /**
@@ -111,44 +296,68 @@ struct Signal {
    * Does a binary search for the given time instance, and interpolates from
    * the closest sample less than `t` if necessary.
    */
-  [[nodiscard]] Sample at(double t) const;
+  [[nodiscard]] Sample at(T t) const;
+
+  /**
+   * Evaluate the signal at each of the time points in `[first, last)`, writing the
+   * values to `out`.
+   *
+   * The time points must be sorted in non-decreasing order, which allows the signal
+   * to be evaluated in a single linear pass. Time points before the start of the
+   * signal get the first value of the signal, and those after the end of the signal
+   * get the last value.
+   */
+  template <typename TimeIter, typename OutIter>
+  OutIter interpolate_at(TimeIter first, TimeIter last, OutIter out) const {
+    if (this->empty()) {
+      return out;
+    }
+    auto it = this->begin();
+    for (; first != last; ++first, ++out) {
+      const auto t = static_cast<T>(*first);
+      while (std::next(it) != this->end() && std::next(it)->time <= t) { ++it; }
+      *out = (t < it->time) ? it->value : it->interpolate(t);
+    }
+    return out;
+  }
+
   /**
    * Get const_iterator to the start of the signal
    */
-  [[nodiscard]] auto begin() const {
-    return this->samples.cbegin();
+  [[nodiscard]] const Sample* begin() const {
+    return this->data();
   }
 
   /**
    * Get const_iterator to the end of the signal
    */
-  [[nodiscard]] auto end() const {
-    return this->samples.cend();
+  [[nodiscard]] const Sample* end() const {
+    return this->data() + this->size();
   }
 
   /**
    * Get const_iterator to the first element of the signal that is timed at or after
    * `s`
    */
-  [[nodiscard]] auto begin_at(double s) const {
+  [[nodiscard]] auto begin_at(T s) const {
     if (this->begin_time() >= s)
       return this->begin();
 
     constexpr auto comp_op = [](const Sample& a, const Sample& b) {
       return a.time < b.time;
     };
-    return std::lower_bound(this->begin(), this->end(), Sample{s, 0.0}, comp_op);
+    return std::lower_bound(this->begin(), this->end(), Sample{s, 0}, comp_op);
   }
 
   /**
    * Get const_iterator to the element after the last element of the signal
    * that is timed at or before `t`
    */
-  [[nodiscard]] auto end_at(double t) const {
+  [[nodiscard]] auto end_at(T t) const {
     if (this->end_time() <= t)
       return this->end();
 
-    auto it = this->end();
+    auto it = std::prev(this->end());
     while (it->time > t) it = std::prev(it);
     // Now we have the pointer to the first element from the back whose .time <= t.
     // So increment by 1 and return
@@ -159,66 +368,152 @@ struct Signal {
    * Get const reverse_iterator to the samples.
    */
   [[nodiscard]] auto rbegin() const {
-    return this->samples.crbegin();
+    return std::make_reverse_iterator(this->end());
   }
 
   /**
    * Get const reverse_iterator to the samples.
    */
   [[nodiscard]] auto rend() const {
-    return this->samples.crend();
+    return std::make_reverse_iterator(this->begin());
   }
 
   [[nodiscard]] size_t size() const {
-    return this->samples.size();
+    return (this->borrowed) ? this->borrowed_size : this->samples.size();
   }
 
   [[nodiscard]] bool empty() const {
-    return this->samples.empty();
+    return this->size() == 0;
+  }
+
+  /**
+   * Reserve storage for at least `n` samples.
+   */
+  void reserve(size_t n) {
+    this->make_owned();
+    this->samples.reserve(n);
   }
 
   /**
    * Add a Sample to the back of the Signal
    */
   void push_back(Sample s);
-  void push_back(double time, double value);
+  void push_back(T time, V value);
 
   /**
    * Remove sampling points where (y, dy) is continuous
    */
-  [[nodiscard]] std::shared_ptr<Signal> simplify() const;
+  [[nodiscard]] std::shared_ptr<BasicSignal> simplify() const;
+  /**
+   * Approximate the signal with fewer samples, such that the value of the output never
+   * differs from the value of this signal by more than `epsilon` at any time.
+   *
+   * The samples of the output are a subset of the time points of this signal. Linear
+   * signals are compressed in a single pass with a swing filter, i.e., a segment is
+   * extended while some line from its start stays within `epsilon` of every sample it
+   * covers. Step signals merge consecutive samples whose values stay within a band of
+   * width `2 * epsilon`.
+   */
+  [[nodiscard]] std::shared_ptr<BasicSignal> simplify(V epsilon) const;
   /**
-   * Restrict/extend the signal to [s,t] with default value v where not defined.
+   * Same as `simplify(epsilon)`, but compresses the samples of this signal in place.
    */
-  [[nodiscard]] std::shared_ptr<Signal>
-  resize(double start, double end, double fill) const;
+  void simplify_inplace(V epsilon);
+  /**
+   * Restrict/extend the signal to [start, end].
+   *
+   * If this signal starts after `start`, the output starts at `start` with the value
+   * `fill`. If it ends before `end`, the output holds its last value until `end`.
+   */
+  [[nodiscard]] std::shared_ptr<BasicSignal> resize(T start, T end, V fill) const;
+  /**
+   * Get the part of the signal over `[start, end]`, intersected with the domain of the
+   * signal.
+   *
+   * The output has samples at `start` and `end` (interpolated if needed), so it takes
+   * the same values as this signal everywhere in the interval.
+   */
+  [[nodiscard]] std::shared_ptr<BasicSignal> slice(T start, T end) const;
+  /**
+   * Get a linear signal that takes the same values as this one.
+   *
+   * A step signal gets an extra sample just before each of its jumps, one
+   * representable time (or tick) earlier, which holds the value before the jump.
+   */
+  [[nodiscard]] std::shared_ptr<BasicSignal> linearize() const;
   /**
    * Shift the signal by dt time units
    */
-  [[nodiscard]] std::shared_ptr<Signal> shift(double dt) const;
+  [[nodiscard]] std::shared_ptr<BasicSignal> shift(T dt) const;
+  /**
+   * Shift the signal by dt time units, in place.
+   */
+  void shift_inplace(T dt);
+  /**
+   * Replace the signal `x(t)` by `scale * x(t) + offset`, in place.
+   */
+  void affine_inplace(V scale, V offset);
 
   /**
    * Resize and shift a signal without creating copies. We use this often, so it makes
    * sense to combine it.
    */
-  [[nodiscard]] std::shared_ptr<Signal>
-  resize_shift(double start, double end, double fill, double dt) const;
+  [[nodiscard]] std::shared_ptr<BasicSignal>
+  resize_shift(T start, T end, V fill, T dt) const;
 
-  Signal() : samples{} {}
+  BasicSignal() : samples{} {}
 
-  Signal(const Signal& other) {
-    this->samples.reserve(other.size());
-    for (const auto& s : other) { this->push_back(s); }
+  /**
+   * Create an empty Signal with the given interpolation policy.
+   */
+  explicit BasicSignal(Interpolation interpolation) :
+      samples{}, interp{interpolation} {}
+
+  /**
+   * Copy a Signal.
+   *
+   * If `other` borrows its samples, the copy borrows the same samples.
+   */
+  BasicSignal(const BasicSignal& other)     = default;
+  BasicSignal(BasicSignal&& other) noexcept = default;
+  BasicSignal& operator=(const BasicSignal& other) = default;
+  BasicSignal& operator=(BasicSignal&& other) noexcept = default;
+  ~BasicSignal()                                       = default;
+
+  /**
+   * Create a Signal that borrows `n` samples from the read-only buffer `storage`,
+   * without copying them.
+   *
+   * The samples must already form a valid signal, i.e., they must be strictly
+   * monotonically increasing in time and have the derivatives set. The buffer is kept
+   * alive by (the copies of) the `shared_ptr` and must not be modified while any
+   * signal borrows from it. Use the aliasing constructor of `std::shared_ptr` to
+   * borrow from memory owned by some other object.
+   */
+  BasicSignal(
+      std::shared_ptr<const Sample> storage,
+      size_t n,
+      Interpolation interpolation = Interpolation::Linear) :
+      samples{},
+      borrowed{std::move(storage)},
+      borrowed_size{n},
+      interp{interpolation} {
+    if (!this->borrowed) {
+      this->borrowed_size = 0;
+    }
   }
 
   /**
    * Create a Signal from a sequence of amples
    */
   template <
-      typename T,
-      typename = decltype(std::begin(std::declval<T>())),
-      typename = decltype(std::end(std::declval<T>()))>
-  Signal(const T& data) {
+      typename Container,
+      typename = decltype(std::begin(std::declval<Container>())),
+      typename = decltype(std::end(std::declval<Container>()))>
+  BasicSignal(
+      const Container& data,
+      Interpolation interpolation = Interpolation::Linear) :
+      interp{interpolation} {
     this->samples.reserve(data.size());
     for (const auto& s : data) { this->push_back(s); }
   }
@@ -226,7 +521,11 @@ struct Signal {
   /**
    * Create a Signal from a sequence of data points and time stamps
    */
-  Signal(const std::vector<double>& points, const std::vector<double>& times) {
+  BasicSignal(
+      const std::vector<V>& points,
+      const std::vector<T>& times,
+      Interpolation interpolation = Interpolation::Linear) :
+      interp{interpolation} {
     if (points.size() != times.size()) {
       throw std::invalid_argument(
           "Number of sample points and time points need to be equal.");
@@ -241,10 +540,10 @@ struct Signal {
    * Create a Signal from the given iterators
    */
   template <
-      typename T,
-      typename TIter = decltype(std::begin(std::declval<T>())),
-      typename       = decltype(std::end(std::declval<T>()))>
-  Signal(TIter&& start, TIter&& end) {
+      typename Container,
+      typename TIter = decltype(std::begin(std::declval<Container>())),
+      typename       = decltype(std::end(std::declval<Container>()))>
+  BasicSignal(TIter&& start, TIter&& end) {
     for (auto i = start; i != end; i++) { this->push_back(*i); }
   }
 };
@@ -255,12 +554,92 @@ struct Signal {
  *
  * The output signals are confined to the time range where both of them are defined,
  * thus can truncate a signal if the other isn't defined there.
+ *
+ * If only one of the signals is a step signal, it is linearized first (see
+ * `BasicSignal::linearize`), so that both outputs are linear.
+ */
+template <typename T, typename V>
+std::tuple<std::shared_ptr<BasicSignal<T, V>>, std::shared_ptr<BasicSignal<T, V>>>
+synchronize(
+    const std::shared_ptr<BasicSignal<T, V>>& x,
+    const std::shared_ptr<BasicSignal<T, V>>& y);
+
+template <typename T, typename V>
+using BasicSignalPtr = std::shared_ptr<BasicSignal<T, V>>;
+
+/**
+ * Get a mutable reference to the signal owned by `sig`, replacing it by a copy first if
+ * it has other owners (copy-on-write).
+ *
+ * This lets the operators reuse the buffers of intermediate signals that nobody else
+ * refers to, while the signals shared with, e.g., a Trace are left untouched.
+ */
+template <typename T, typename V>
+BasicSignal<T, V>& make_mutable(BasicSignalPtr<T, V>& sig) {
+  if (sig.use_count() != 1) {
+    sig = std::make_shared<BasicSignal<T, V>>(*sig);
+  }
+  return *sig;
+}
+
+/**
+ * Get a view of the part of `sig` over `[start, end]`, without copying its samples.
+ *
+ * The view borrows the samples of `sig` (and keeps it alive), from the last sample at
+ * or before `start` to the first sample at or after `end`. It thus takes the same
+ * values as `sig` over the interval, but may extend past it. `sig` must not be
+ * modified while the view is in use. Use `BasicSignal::slice` for a copy restricted
+ * to the interval.
  */
-std::tuple<std::shared_ptr<Signal>, std::shared_ptr<Signal>>
-synchronize(const std::shared_ptr<Signal>& x, const std::shared_ptr<Signal>& y);
+template <typename T, typename V>
+BasicSignalPtr<T, V> slice_view(const BasicSignalPtr<T, V>& sig, T start, T end) {
+  using sample_type = BasicSample<T, V>;
+  if (sig->empty() || end < start) {
+    return std::make_shared<BasicSignal<T, V>>(sig->interpolation());
+  }
+
+  auto first = std::upper_bound(
+      sig->begin(), sig->end(), start, [](T t, const sample_type& a) {
+        return t < a.time;
+      });
+  if (first != sig->begin()) {
+    first = std::prev(first);
+  }
+  auto last = std::lower_bound(first, sig->end(), end, [](const sample_type& a, T t) {
+    return a.time < t;
+  });
+  if (last != sig->end()) {
+    last = std::next(last);
+  }
+
+  const auto n = static_cast<size_t>(last - first);
+  if (n == sig->size()) {
+    return sig;
+  }
+  return std::make_shared<BasicSignal<T, V>>(
+      std::shared_ptr<const sample_type>(sig, first), n, sig->interpolation());
+}
+
+template <typename T, typename V>
+using BasicTrace = std::map<std::string, BasicSignalPtr<T, V>>;
+
+using Sample    = BasicSample<double, double>;
+using Signal    = BasicSignal<double, double>;
+using SignalPtr = BasicSignalPtr<double, double>;
+using Trace     = BasicTrace<double, double>;
+
+// The supported combinations of time and value types are instantiated in signal.cc.
+#define SIGNALTL_DECLARE_SIGNAL(T, V)                                                 \
+  extern template struct BasicSignal<T, V>;                                           \
+  extern template std::tuple<BasicSignalPtr<T, V>, BasicSignalPtr<T, V>> synchronize( \
+      const BasicSignalPtr<T, V>&, const BasicSignalPtr<T, V>&);
+
+SIGNALTL_DECLARE_SIGNAL(double, double)
+SIGNALTL_DECLARE_SIGNAL(double, float)
+SIGNALTL_DECLARE_SIGNAL(std::int64_t, double)
+SIGNALTL_DECLARE_SIGNAL(std::int64_t, float)
 
-using SignalPtr = std::shared_ptr<Signal>;
-using Trace     = std::map<std::string, SignalPtr>;
+#undef SIGNALTL_DECLARE_SIGNAL
 
 } // namespace signal_tl::signal
 
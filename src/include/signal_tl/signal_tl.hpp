@@ -5,8 +5,16 @@
 
 // IWYU pragma: begin_exports
 #include "signal_tl/ast.hpp"
+#include "signal_tl/compressed.hpp"
 #include "signal_tl/exception.hpp"
+#include "signal_tl/generators.hpp"
+#include "signal_tl/ingest.hpp"
+#include "signal_tl/interval_set.hpp"
+#include "signal_tl/mining.hpp"
+#include "signal_tl/online.hpp"
+#include "signal_tl/range_index.hpp"
 #include "signal_tl/robustness.hpp"
+#include "signal_tl/satisfaction.hpp"
 #include "signal_tl/signal.hpp"
 // IWYU pragma: end_exports
 
@@ -379,6 +379,43 @@ struct action<UntilTerm> {
   }
 };
 
+template <>
+struct action<HistoricallyTerm> {
+  static void apply0(GlobalParserState&, ParserState& state) {
+    assert(state.terms.size() == 1);
+    state.result = ::signal_tl::Historically(state.terms.back());
+    state.terms.pop_back();
+    // There should be exactly 0 terms left now.
+    assert(state.terms.empty());
+  }
+};
+
+template <>
+struct action<OnceTerm> {
+  static void apply0(GlobalParserState&, ParserState& state) {
+    assert(state.terms.size() == 1);
+    state.result = ::signal_tl::Once(state.terms.back());
+    state.terms.pop_back();
+    // There should be exactly 0 terms left now.
+    assert(state.terms.empty());
+  }
+};
+
+template <>
+struct action<SinceTerm> {
+  static void apply0(GlobalParserState&, ParserState& state) {
+    // We expect the state to contain exactly 2 terms
+    assert(state.terms.size() == 2);
+    auto rhs = state.terms.back();
+    state.terms.pop_back();
+    auto lhs = state.terms.back();
+    state.terms.pop_back();
+    state.result = ::signal_tl::Since(lhs, rhs);
+    // There should be exactly 0 terms left now.
+    assert(state.terms.empty());
+  }
+};
+
 template <>
 struct action<Term> {
   template <
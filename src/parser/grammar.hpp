@@ -47,6 +47,9 @@ struct KwXor : Keyword<TAO_PEGTL_STRING("xor")> {};
 struct KwAlways : Keyword<TAO_PEGTL_STRING("always")> {};
 struct KwEventually : Keyword<TAO_PEGTL_STRING("eventually")> {};
 struct KwUntil : Keyword<TAO_PEGTL_STRING("until")> {};
+struct KwHistorically : Keyword<TAO_PEGTL_STRING("historically")> {};
+struct KwOnce : Keyword<TAO_PEGTL_STRING("once")> {};
+struct KwSince : Keyword<TAO_PEGTL_STRING("since")> {};
 
 struct KwDefineFormula : Keyword<TAO_PEGTL_STRING("define-formula")> {};
 struct KwAssert : Keyword<TAO_PEGTL_STRING("assert")> {};
@@ -140,6 +143,9 @@ struct XorTerm : peg::if_must<KwXor, BinaryTail> {};
 struct AlwaysTerm : peg::if_must<KwAlways, Term> {};
 struct EventuallyTerm : peg::if_must<KwEventually, Term> {};
 struct UntilTerm : peg::if_must<KwUntil, Term, Term> {};
+struct HistoricallyTerm : peg::if_must<KwHistorically, Term> {};
+struct OnceTerm : peg::if_must<KwOnce, Term> {};
+struct SinceTerm : peg::if_must<KwSince, Term, Term> {};
 
 /// An Expression must be a valid STL formula (without specific functions for
 /// the predicates). So, we will hard code the syntax and we don't have to
@@ -155,6 +161,9 @@ using Expression = peg::sor<
     AlwaysTerm,
     EventuallyTerm,
     UntilTerm,
+    HistoricallyTerm,
+    OnceTerm,
+    SinceTerm,
     Term>;
 
 using TermTail = peg::until<RParen, Expression>;
@@ -0,0 +1,25 @@
+#include "signal_tl/ast.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/internal/parallel.hpp"
+
+#include <cstddef> // for size_t
+#include <vector>  // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+std::vector<SignalPtr> compute_robustness_batch(
+    const ast::Expr& phi,
+    const std::vector<Trace>& traces,
+    size_t n_threads,
+    bool synchronized) {
+  auto out = std::vector<SignalPtr>(traces.size());
+  parallel::parallel_for(traces.size(), n_threads, [&](size_t i) {
+    out[i] = compute_robustness(phi, traces[i], synchronized);
+  });
+  return out;
+}
+
+} // namespace signal_tl::semantics
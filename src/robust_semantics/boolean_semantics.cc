@@ -0,0 +1,344 @@
+#include "signal_tl/ast.hpp"
+#include "signal_tl/interval_set.hpp"
+#include "signal_tl/satisfaction.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/internal/utils.hpp" // for overloaded
+
+#include <algorithm> // for min, max, clamp, all_of, any_of
+#include <cstdint>   // for int64_t
+#include <iterator>  // for next
+#include <limits>    // for numeric_limits
+#include <stdexcept> // for invalid_argument
+#include <utility>   // for pair
+#include <variant>   // for visit
+#include <vector>    // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+template <typename T, typename V>
+struct SatisfactionOp {
+  using Set = BasicIntervalSet<T>;
+
+  /// The time range of the trace.
+  T begin                       = std::numeric_limits<T>::lowest();
+  T end                         = std::numeric_limits<T>::max();
+  const BasicTrace<T, V>* trace = nullptr;
+
+  [[nodiscard]] Set compute(const ast::Expr& phi) const {
+    return std::visit([this](auto&& e) { return (*this)(e); }, phi);
+  }
+
+  /// The set of `phi`, extended to (practically) infinity if `phi` holds at the end of
+  /// the trace: past the end of the trace, the temporal operators see its last value.
+  [[nodiscard]] Set extended(const ast::Expr& phi) const {
+    const T far  = std::numeric_limits<T>::max() / 4;
+    const auto x = this->compute(phi);
+    return (this->holds_at_end(phi)) ? x.unite(Set({{this->end, far}})) : x;
+  }
+
+  /// The set of `phi`, extended to (practically) minus infinity if `phi` holds at the
+  /// start of the trace: before the start, the past-time operators see its first value.
+  [[nodiscard]] Set extended_past(const ast::Expr& phi) const {
+    const T far  = std::numeric_limits<T>::lowest() / 4;
+    const auto x = this->compute(phi);
+    return (this->holds_at_begin(phi)) ? Set({{far, this->begin}}).unite(x) : x;
+  }
+
+  /// Whether the predicate `e` holds for the value `x` of its signal.
+  static bool holds(const ast::Predicate& e, V x) {
+    const auto c     = static_cast<V>(e.rhs);
+    const bool lower = e.op == ast::ComparisonOp::GE || e.op == ast::ComparisonOp::GT;
+    return ((lower) ? x - c : c - x) >= 0;
+  }
+
+  /// Whether the robustness of `phi` is non-negative at the end of the trace.
+  ///
+  /// The sets are closed, so the set of a predicate on a step signal that jumps to a
+  /// violating value at its last sample still contains the end of the trace. The value
+  /// at the end is thus taken from the last samples of the signals instead, through
+  /// the operators whose windows only see the end of the trace from there.
+  [[nodiscard]] bool holds_at_end(const ast::Expr& phi) const;
+  /// Whether the robustness of `phi` is non-negative at the start of the trace.
+  [[nodiscard]] bool holds_at_begin(const ast::Expr& phi) const;
+
+  /// Convert the interval `[a, b]` of a temporal operator to the time type of the
+  /// trace. Windows reaching past the end of the trace only see its end, so the bounds
+  /// are clamped to its length.
+  [[nodiscard]] std::pair<T, T> window(const ast::Interval& interval) const {
+    const auto [a, b]   = interval.as_double();
+    const double length = static_cast<double>(this->end - this->begin);
+    return {time_cast<T>(std::min(a, length)), time_cast<T>(std::min(b, length))};
+  }
+
+  Set operator()(const ast::Const e) const;
+  Set operator()(const ast::Predicate& e) const;
+  Set operator()(const ast::NotPtr& e) const;
+  Set operator()(const ast::AndPtr& e) const;
+  Set operator()(const ast::OrPtr& e) const;
+  Set operator()(const ast::EventuallyPtr& e) const;
+  Set operator()(const ast::AlwaysPtr& e) const;
+  Set operator()(const ast::UntilPtr& e) const;
+  Set operator()(const ast::HistoricallyPtr& e) const;
+  Set operator()(const ast::OncePtr& e) const;
+  Set operator()(const ast::SincePtr& e) const;
+};
+
+template <typename T, typename V>
+bool SatisfactionOp<T, V>::holds_at_end(const ast::Expr& phi) const {
+  const auto all = [this](const std::vector<ast::Expr>& args) {
+    return std::all_of(args.begin(), args.end(), [this](const ast::Expr& arg) {
+      return this->holds_at_end(arg);
+    });
+  };
+  const auto any = [this](const std::vector<ast::Expr>& args) {
+    return std::any_of(args.begin(), args.end(), [this](const ast::Expr& arg) {
+      return this->holds_at_end(arg);
+    });
+  };
+  return std::visit(
+      utils::overloaded{
+          [](const ast::Const e) { return e.value; },
+          [this](const ast::Predicate& e) {
+            return holds(e, this->trace->at(e.name)->back().value);
+          },
+          [this](const ast::NotPtr& e) { return !this->holds_at_end(e->arg); },
+          [&](const ast::AndPtr& e) { return all(e->args); },
+          [&](const ast::OrPtr& e) { return any(e->args); },
+          // The windows of the future-time operators are past the end of the trace.
+          [this](const ast::EventuallyPtr& e) { return this->holds_at_end(e->arg); },
+          [this](const ast::AlwaysPtr& e) { return this->holds_at_end(e->arg); },
+          [this](const ast::UntilPtr& e) {
+            const bool y = this->holds_at_end(e->args.second);
+            return y && (this->window(e->interval).first == 0 ||
+                         this->holds_at_end(e->args.first));
+          },
+          // The windows of the past-time operators are within the trace.
+          [&](const auto& e) { return this->compute(e).contains(this->end); }},
+      phi);
+}
+
+template <typename T, typename V>
+bool SatisfactionOp<T, V>::holds_at_begin(const ast::Expr& phi) const {
+  const auto all = [this](const std::vector<ast::Expr>& args) {
+    return std::all_of(args.begin(), args.end(), [this](const ast::Expr& arg) {
+      return this->holds_at_begin(arg);
+    });
+  };
+  const auto any = [this](const std::vector<ast::Expr>& args) {
+    return std::any_of(args.begin(), args.end(), [this](const ast::Expr& arg) {
+      return this->holds_at_begin(arg);
+    });
+  };
+  return std::visit(
+      utils::overloaded{
+          [](const ast::Const e) { return e.value; },
+          [this](const ast::Predicate& e) {
+            return holds(e, this->trace->at(e.name)->front().value);
+          },
+          [this](const ast::NotPtr& e) { return !this->holds_at_begin(e->arg); },
+          [&](const ast::AndPtr& e) { return all(e->args); },
+          [&](const ast::OrPtr& e) { return any(e->args); },
+          // The windows of the past-time operators are before the start of the trace.
+          [this](const ast::HistoricallyPtr& e) {
+            return this->holds_at_begin(e->arg);
+          },
+          [this](const ast::OncePtr& e) { return this->holds_at_begin(e->arg); },
+          [this](const ast::SincePtr& e) {
+            const bool y = this->holds_at_begin(e->args.second);
+            return y && (this->window(e->interval).first == 0 ||
+                         this->holds_at_begin(e->args.first));
+          },
+          // The windows of the future-time operators are within the trace.
+          [&](const auto& e) { return this->compute(e).contains(this->begin); }},
+      phi);
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::Const e) const {
+  return (e.value) ? Set({{this->begin, this->end}}) : Set{};
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::Predicate& e) const {
+  using sample_type = BasicSample<T, V>;
+
+  const auto& x = this->trace->at(e.name);
+  auto out      = Set{};
+  if (x->empty()) {
+    return out;
+  }
+  const bool lower = e.op == ast::ComparisonOp::GE || e.op == ast::ComparisonOp::GT;
+  const bool step  = x->interpolation() == Interpolation::Step;
+  const auto c     = static_cast<V>(e.rhs);
+  // The robustness of the predicate.
+  const auto rho = [&](const sample_type& s) {
+    return (lower) ? sample_type{s.time, s.value - c, s.derivative}
+                   : sample_type{s.time, c - s.value, -s.derivative};
+  };
+
+  // The predicate holds from `start` while `open`, and it changes between samples
+  // where their robustness changes sign.
+  bool open = rho(*x->begin()).value >= 0;
+  T start   = this->begin;
+  for (auto it = x->begin(); std::next(it) != x->end(); it++) {
+    const auto s    = rho(*it);
+    const auto next = rho(*std::next(it));
+    if (open == (next.value >= 0)) {
+      continue;
+    }
+    const T t = (step) ? next.time
+                       : std::clamp(
+                             s.time_intersect(sample_type{s.time, 0, 0}),
+                             s.time,
+                             next.time);
+    if (open) {
+      out.push_back(start, t);
+    } else {
+      start = t;
+    }
+    open = !open;
+  }
+  if (open) {
+    out.push_back(start, this->end);
+  }
+  return out;
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::NotPtr& e) const {
+  return this->compute(e->arg).complement(this->begin, this->end);
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::AndPtr& e) const {
+  auto out = Set({{this->begin, this->end}});
+  for (const auto& arg : e->args) {
+    out = out.intersect(this->compute(arg));
+    // The conjunction is violated everywhere.
+    if (out.empty()) {
+      break;
+    }
+  }
+  return out;
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::OrPtr& e) const {
+  auto out = Set{};
+  for (const auto& arg : e->args) { out = out.unite(this->compute(arg)); }
+  return out;
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T>
+SatisfactionOp<T, V>::operator()(const ast::EventuallyPtr& e) const {
+  // `t` is in the output if `[t + a, t + b]` meets the set of the operand.
+  const auto [a, b] = this->window(e->interval);
+  const auto x      = this->extended(e->arg);
+  return x.minkowski_sum(-b, -a).clip(this->begin, this->end);
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::AlwaysPtr& e) const {
+  // `t` is in the output if `[t + a, t + b]` is in the set of the operand.
+  const auto [a, b] = this->window(e->interval);
+  const auto x      = this->extended(e->arg);
+  return x.minkowski_difference(a, b).clip(this->begin, this->end);
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::UntilPtr& e) const {
+  const auto [a, b] = this->window(e->interval);
+  const auto x      = this->extended(e->args.first);
+  const auto y      = this->extended(e->args.second);
+
+  // For every part `[p, q]` of `y` within an interval `[l, u]` of `x`, the formula
+  // holds at the times `t` in `[l, u]` for which `[t + a, t + b]` meets `[p, q]`.
+  auto out = Set{};
+  auto i   = x.begin();
+  for (const auto& [p, q] : y.intersect(x)) {
+    while (i->second < p) { i++; }
+    const T lo = std::max(i->first, p - b);
+    const T hi = std::min(i->second, q - a);
+    if (lo <= hi) {
+      out.push_back(lo, hi);
+    }
+  }
+  if (a == 0) {
+    out = out.unite(y);
+  }
+  return out.clip(this->begin, this->end);
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T>
+SatisfactionOp<T, V>::operator()(const ast::HistoricallyPtr& e) const {
+  // `t` is in the output if `[t - b, t - a]` is in the set of the operand.
+  const auto [a, b] = this->window(e->interval);
+  const auto x      = this->extended_past(e->arg);
+  return x.minkowski_difference(-b, -a).clip(this->begin, this->end);
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::OncePtr& e) const {
+  // `t` is in the output if `[t - b, t - a]` meets the set of the operand.
+  const auto [a, b] = this->window(e->interval);
+  const auto x      = this->extended_past(e->arg);
+  return x.minkowski_sum(a, b).clip(this->begin, this->end);
+}
+
+template <typename T, typename V>
+BasicIntervalSet<T> SatisfactionOp<T, V>::operator()(const ast::SincePtr& e) const {
+  const auto [a, b] = this->window(e->interval);
+  const auto x      = this->extended_past(e->args.first);
+  const auto y      = this->extended_past(e->args.second);
+
+  // For every part `[p, q]` of `y` within an interval `[l, u]` of `x`, the formula
+  // holds at the times `t` in `[l, u]` for which `[t - b, t - a]` meets `[p, q]`.
+  auto out = Set{};
+  auto i   = x.begin();
+  for (const auto& [p, q] : y.intersect(x)) {
+    while (i->second < p) { i++; }
+    const T lo = std::max(i->first, p + a);
+    const T hi = std::min(i->second, q + b);
+    if (lo <= hi) {
+      out.push_back(lo, hi);
+    }
+  }
+  if (a == 0) {
+    out = out.unite(y);
+  }
+  return out.clip(this->begin, this->end);
+}
+
+} // namespace
+
+template <typename T, typename V>
+BasicIntervalSet<T>
+compute_satisfaction(const ast::Expr& phi, const BasicTrace<T, V>& trace) {
+  if (trace.empty()) {
+    throw std::invalid_argument("Cannot compute the satisfaction over an empty trace");
+  }
+  auto op = SatisfactionOp<T, V>{
+      std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(), &trace};
+  for (const auto& [name, x] : trace) {
+    op.begin = std::min(op.begin, x->begin_time());
+    op.end   = std::max(op.end, x->end_time());
+  }
+  return op.compute(phi);
+}
+
+template BasicIntervalSet<double>
+compute_satisfaction(const ast::Expr&, const BasicTrace<double, double>&);
+template BasicIntervalSet<double>
+compute_satisfaction(const ast::Expr&, const BasicTrace<double, float>&);
+template BasicIntervalSet<std::int64_t>
+compute_satisfaction(const ast::Expr&, const BasicTrace<std::int64_t, double>&);
+template BasicIntervalSet<std::int64_t>
+compute_satisfaction(const ast::Expr&, const BasicTrace<std::int64_t, float>&);
+
+} // namespace signal_tl::semantics
@@ -1,45 +1,57 @@
 #include "signal_tl/ast.hpp"
 #include "signal_tl/exception.hpp"
+#include "signal_tl/range_index.hpp"
 #include "signal_tl/robustness.hpp"
 #include "signal_tl/signal.hpp"
 
+#include "signal_tl/internal/utils.hpp"
+
 #include "minmax.hpp"
+#include "past.hpp"
 
-#include <algorithm>  // for max, min, transform, for_each
-#include <cassert>    // for assert
-#include <cmath>      // for isinf
-#include <functional> // for negate
-#include <iterator>   // for back_insert_iterator, back_inserter
-#include <limits>     // for numeric_limits
-#include <map>        // for operator!=
-#include <memory>     // for __shared_ptr_access, make_shared
-#include <stdexcept>  // for logic_error
-#include <string>     // for string
-#include <tuple>      // for make_tuple, tuple_element<>::type
-#include <utility>    // for tuple_element<>::type, pair
-#include <variant>    // for visit
-#include <vector>     // for vector
+#include <algorithm>    // for max, min, transform, for_each
+#include <cassert>      // for assert
+#include <cmath>        // for isinf
+#include <cstdint>      // for int64_t
+#include <fmt/format.h> // for format
+#include <iterator>     // for back_insert_iterator, back_inserter
+#include <limits>       // for numeric_limits
+#include <map>          // for operator!=
+#include <memory>       // for __shared_ptr_access, make_shared
+#include <optional>     // for optional, nullopt
+#include <set>          // for set
+#include <stdexcept>    // for logic_error, invalid_argument, out_of_range
+#include <string>       // for string
+#include <tuple>        // for make_tuple, tuple_element<>::type
+#include <utility>      // for tuple_element<>::type, pair
+#include <variant>      // for visit
+#include <vector>       // for vector
 
 namespace signal_tl::semantics {
 using namespace signal;
 using namespace minmax;
 
 namespace {
-constexpr double TOP    = std::numeric_limits<double>::infinity();
-constexpr double BOTTOM = -TOP;
+template <typename V>
+constexpr V TOP = std::numeric_limits<V>::infinity();
+template <typename V>
+constexpr V BOTTOM = -TOP<V>;
 
-SignalPtr compute_until(const SignalPtr& input_x, const SignalPtr& input_y) {
+template <typename T, typename V>
+BasicSignalPtr<T, V> compute_until(
+    const BasicSignalPtr<T, V>& input_x,
+    const BasicSignalPtr<T, V>& input_y) {
   const auto [x, y] = synchronize(input_x, input_y);
   assert(x->size() == y->size());
   assert(x->begin_time() == y->begin_time());
   assert(x->end_time() == y->end_time());
 
-  auto sigstack = std::vector<Sample>();
+  auto sigstack = std::vector<BasicSample<T, V>>();
 
   // TODO(anand): This doesn't handle crossing signals well...
 
-  double prev      = TOP;
-  double max_right = BOTTOM;
+  V prev      = TOP<V>;
+  V max_right = BOTTOM<V>;
 
   for (auto [i, j] = std::make_tuple(x->rbegin(), y->rbegin());
        i != x->rend() && j != y->rend();
@@ -49,21 +61,260 @@ SignalPtr compute_until(const SignalPtr& input_x, const SignalPtr& input_y) {
     sigstack.push_back({i->time, prev});
   }
   std::reverse(sigstack.begin(), sigstack.end());
-  auto out = std::make_shared<Signal>(sigstack);
+  const bool step = x->interpolation() == Interpolation::Step &&
+                    y->interpolation() == Interpolation::Step;
+  auto out = std::make_shared<BasicSignal<T, V>>(
+      sigstack, (step) ? Interpolation::Step : Interpolation::Linear);
   return out;
 }
 
-SignalPtr compute_until(const SignalPtr&, const SignalPtr&, double, double) {
+template <typename T, typename V>
+BasicSignalPtr<T, V>
+compute_until(const BasicSignalPtr<T, V>&, const BasicSignalPtr<T, V>&, T, T) {
   throw not_implemented_error("Bounded compute_until has not been implemented yet.");
 }
 
+/**
+ * Convert the interval `[a, b]` of a temporal operator to the time type of a signal
+ * spanning `length` time units.
+ *
+ * Windows reaching past the end of the signal only see the end of the signal, so `b`
+ * is clamped to `max(a, length)` to keep it representable by integral time types.
+ */
+template <typename T>
+std::pair<T, T> window_cast(double a, double b, T length) {
+  b = std::min(b, std::max(a, static_cast<double>(length)));
+  return {time_cast<T>(a), time_cast<T>(b)};
+}
+
+/**
+ * The windowed max (or min) of `y` over `[t + a, t + b]`, i.e., the robustness of
+ * Eventually (or Always) over `[a, b]` with operand `y`.
+ */
+template <typename T, typename V>
+BasicSignalPtr<T, V>
+compute_window(const BasicSignalPtr<T, V>& y, double a, double b, bool is_max) {
+  const T length = y->end_time() - y->begin_time();
+  if (b - a < 0) {
+    throw std::logic_error(fmt::format(
+        "{} operator: b < a in interval [a,b]", (is_max) ? "Eventually" : "Always"));
+  } else if (b - a == 0) {
+    return y;
+  } else if (a == 0 && b >= static_cast<double>(length)) {
+    return (is_max) ? compute_max_seq(y) : compute_min_seq(y);
+  } else {
+    const auto [ta, tb] = window_cast(a, b, length);
+    return (is_max) ? compute_max_seq(y, ta, tb) : compute_min_seq(y, ta, tb);
+  }
+}
+
+/**
+ * The windowed max (or min) of `y` over `[t - b, t - a]`, i.e., the robustness of Once
+ * (or Historically) over `[a, b]` with operand `y`.
+ *
+ * Windows reaching before the start of the signal only see its first value. The past
+ * window at `t` is the window `[s, s + b - a]` at `s = t - b`, so this is the windowed
+ * max (min) of `y`, padded with its first value over the `b` time units before it
+ * starts, shifted by `b`.
+ */
+template <typename T, typename V>
+BasicSignalPtr<T, V>
+compute_past_window(const BasicSignalPtr<T, V>& y, double a, double b, bool is_max) {
+  const T length = y->end_time() - y->begin_time();
+  if (b - a < 0) {
+    throw std::logic_error(fmt::format(
+        "{} operator: b < a in interval [a,b]", (is_max) ? "Once" : "Historically"));
+  }
+  const auto [ta, tb] = window_cast(a, b, length);
+  if (tb == 0) {
+    return y;
+  }
+
+  auto samples = std::vector<BasicSample<T, V>>{};
+  samples.reserve(y->size() + 1);
+  samples.push_back({y->begin_time() - tb, y->front().value, 0});
+  samples.insert(samples.end(), y->begin(), y->end());
+  const auto padded = std::make_shared<BasicSignal<T, V>>(samples, y->interpolation());
+
+  const auto z = compute_window(padded, 0.0, static_cast<double>(tb - ta), is_max);
+
+  // Shifting by `tb` can round nearby times to the same time, in which case the later
+  // sample (whose derivative holds after that time) is kept.
+  auto shifted = std::vector<BasicSample<T, V>>{};
+  shifted.reserve(z->size());
+  for (const auto& s : *z) {
+    const T t = s.time + tb;
+    if (!shifted.empty() && t <= shifted.back().time) {
+      shifted.back() = {shifted.back().time, s.value, s.derivative};
+    } else {
+      shifted.push_back({t, s.value, s.derivative});
+    }
+  }
+  return std::make_shared<BasicSignal<T, V>>(shifted, y->interpolation())
+      ->slice(y->begin_time(), y->end_time());
+}
+
+/**
+ * The robustness of `x S[a, b] y`, evaluated at the (synchronized) sample points of
+ * the operands with `past::SinceWindow`.
+ *
+ * This is exact for step signals. Like `compute_until`, linear signals are only
+ * evaluated at their sample points, so crossings between samples are missed.
+ */
+template <typename T, typename V>
+BasicSignalPtr<T, V> compute_since(
+    const BasicSignalPtr<T, V>& input_x,
+    const BasicSignalPtr<T, V>& input_y,
+    double a,
+    double b) {
+  const auto [x, y] = synchronize(input_x, input_y);
+  assert(x->size() == y->size());
+
+  const T length      = x->end_time() - x->begin_time();
+  const auto [ta, tb] = window_cast(a, b, length);
+  auto window = past::SinceWindow<T, V>{ta, tb, b < static_cast<double>(length)};
+  const bool step = x->interpolation() == Interpolation::Step &&
+                    y->interpolation() == Interpolation::Step;
+  auto out = std::make_shared<BasicSignal<T, V>>(
+      (step) ? Interpolation::Step : Interpolation::Linear);
+  out->reserve(x->size());
+  for (auto [i, j] = std::make_tuple(x->begin(), y->begin()); i != x->end();
+       i++, j++) {
+    out->push_back(i->time, window.update(i->time, i->value, j->value));
+  }
+  return out;
+}
+
+/**
+ * Bytes held by the intermediate signals during an evaluation.
+ */
+struct MemoryStats {
+  size_t live = 0;
+  size_t peak = 0;
+
+  /// Account for an operator producing `out` while its inputs are still live, and then
+  /// releasing `released` bytes of inputs.
+  void replace(size_t released, size_t out) {
+    peak = std::max(peak, live + out);
+    live = live + out - released;
+  }
+};
+
+template <typename T, typename V>
+size_t bytes_of(const BasicSignalPtr<T, V>& sig) {
+  return sig->size() * sizeof(BasicSample<T, V>);
+}
+
+/**
+ * The number of intermediate signals that need to be live at the same time to evaluate
+ * `phi` (its Sethi-Ullman number), when the children of every node are evaluated in
+ * the order given by `evaluation_order`.
+ */
+size_t register_need(const ast::Expr& phi);
+
+/**
+ * The order in which to evaluate `args` to minimize the number of live intermediates.
+ *
+ * An n-ary min/max folds its children into a running envelope, so only the first child
+ * is evaluated without another live signal. Evaluating the child with the largest
+ * need first thus minimizes the need of the node.
+ */
+std::vector<std::pair<size_t, const ast::Expr*>>
+evaluation_order(const std::vector<const ast::Expr*>& args) {
+  auto order = std::vector<std::pair<size_t, const ast::Expr*>>{};
+  order.reserve(args.size());
+  for (const auto* arg : args) { order.emplace_back(register_need(*arg), arg); }
+  std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+    return a.first > b.first;
+  });
+  return order;
+}
+
+size_t fold_need(const std::vector<const ast::Expr*>& args) {
+  const auto order = evaluation_order(args);
+  size_t need      = 1;
+  for (const auto& [i, arg] : utils::enumerate(order)) {
+    need = std::max(need, arg.first + ((i == 0) ? 0 : 1));
+  }
+  return need;
+}
+
+size_t register_need(const ast::Expr& phi) {
+  const auto pointers = [](const std::vector<ast::Expr>& args) {
+    auto out = std::vector<const ast::Expr*>{};
+    for (const auto& arg : args) { out.push_back(&arg); }
+    return out;
+  };
+  return std::visit(
+      utils::overloaded{
+          [](const ast::Const&) -> size_t { return 1; },
+          [](const ast::Predicate&) -> size_t { return 1; },
+          [](const ast::NotPtr& e) { return register_need(e->arg); },
+          [&](const ast::AndPtr& e) { return fold_need(pointers(e->args)); },
+          [&](const ast::OrPtr& e) { return fold_need(pointers(e->args)); },
+          [](const ast::EventuallyPtr& e) { return register_need(e->arg); },
+          [](const ast::AlwaysPtr& e) { return register_need(e->arg); },
+          [](const ast::UntilPtr& e) {
+            return fold_need({&e->args.first, &e->args.second});
+          },
+          [](const ast::HistoricallyPtr& e) { return register_need(e->arg); },
+          [](const ast::OncePtr& e) { return register_need(e->arg); },
+          [](const ast::SincePtr& e) {
+            return fold_need({&e->args.first, &e->args.second});
+          }},
+      phi);
+}
+
+template <typename T, typename V>
 struct RobustnessOp {
-  double min_time = 0.0;
-  double max_time = std::numeric_limits<double>::infinity();
-  Trace trace     = {};
+  using SignalPtr = BasicSignalPtr<T, V>;
+
+  T min_time = std::numeric_limits<T>::lowest();
+  T max_time = std::numeric_limits<T>::max();
+  /// The time range over which the output of the current node is needed.
+  T begin                       = min_time;
+  T end                         = max_time;
+  const BasicTrace<T, V>* trace = nullptr;
+  /// Tolerance used to simplify the output of every node (0 disables it).
+  V epsilon = 0;
+  /// Accounting of the memory held by intermediate signals.
+  MemoryStats* stats = nullptr;
 
   RobustnessOp() = default;
 
+  /// The same operator, computing the output of a node over `[lo, hi]` (within the
+  /// trace).
+  [[nodiscard]] RobustnessOp over(T lo, T hi) const {
+    auto op  = *this;
+    op.begin = std::max(lo, this->min_time);
+    op.end   = std::min(hi, this->max_time);
+    return op;
+  }
+
+  /// The same operator, without simplification.
+  [[nodiscard]] RobustnessOp exact() const {
+    auto op    = *this;
+    op.epsilon = 0;
+    return op;
+  }
+
+  /// The time `t + b`, saturated at the end of the trace.
+  [[nodiscard]] T after(T t, double b) const {
+    return (b >= static_cast<double>(this->max_time - t)) ? this->max_time
+                                                          : t + time_cast<T>(b);
+  }
+
+  /// The time `t - b`, saturated at the start of the trace.
+  [[nodiscard]] T before(T t, double b) const {
+    return (b >= static_cast<double>(t - this->min_time)) ? this->min_time
+                                                          : t - time_cast<T>(b);
+  }
+
+  /// Compute the element-wise min/max of `args`, evaluating them in the order of their
+  /// register need, and releasing each of them once it is folded into the envelope.
+  template <typename Fold>
+  SignalPtr fold(const std::vector<const ast::Expr*>& args, Fold&& fold_fn) const;
+
   SignalPtr operator()(const ast::Const e) const;
   SignalPtr operator()(const ast::Predicate& e) const;
   SignalPtr operator()(const ast::NotPtr& e) const;
@@ -72,20 +323,91 @@ struct RobustnessOp {
   SignalPtr operator()(const ast::EventuallyPtr& e) const;
   SignalPtr operator()(const ast::AlwaysPtr& e) const;
   SignalPtr operator()(const ast::UntilPtr& e) const;
+  SignalPtr operator()(const ast::HistoricallyPtr& e) const;
+  SignalPtr operator()(const ast::OncePtr& e) const;
+  SignalPtr operator()(const ast::SincePtr& e) const;
 };
 
-SignalPtr compute(const ast::Expr& phi, const RobustnessOp& rob) {
-  return std::visit([&](auto&& e) { return rob(e); }, phi);
+template <typename T, typename V>
+BasicSignalPtr<T, V> compute(const ast::Expr& phi, const RobustnessOp<T, V>& rob) {
+  const size_t live = rob.stats->live;
+  auto out          = std::visit([&](auto&& e) { return rob(e); }, phi);
+  if (rob.epsilon > 0 && !std::holds_alternative<ast::Const>(phi)) {
+    make_mutable(out).simplify_inplace(rob.epsilon);
+  }
+  // The children of the node are released, and its output is now live.
+  rob.stats->replace(rob.stats->live - live, bytes_of(out));
+  return out;
 }
 
-} // namespace
+template <typename T, typename V>
+template <typename Fold>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::fold(
+    const std::vector<const ast::Expr*>& args,
+    Fold&& fold_fn) const {
+  SignalPtr out = nullptr;
+  for (const auto& [need, arg] : evaluation_order(args)) {
+    auto y = compute(*arg, *this);
+    if (out == nullptr) {
+      out = std::move(y);
+      continue;
+    }
+    auto next = fold_fn(out, y);
+    this->stats->replace(bytes_of(out) + bytes_of(y), bytes_of(next));
+    out = std::move(next);
+  }
+  return out;
+}
+
+/**
+ * Bound on the error of the robustness of `phi` when the output of every non-constant
+ * node is simplified with tolerance `epsilon`.
+ *
+ * Negation and the (windowed) min/max never increase the error of their inputs, so
+ * each of them only adds its own `epsilon`. Until and Since are evaluated at the sample
+ * points of their operands, so simplifying the operands can change their output by
+ * more than `epsilon`: their operands are computed exactly, and only their output is
+ * simplified.
+ */
+double error_bound(const ast::Expr& phi, double epsilon) {
+  const auto max_of = [epsilon](const std::vector<ast::Expr>& args) {
+    double out = 0.0;
+    for (const auto& arg : args) { out = std::max(out, error_bound(arg, epsilon)); }
+    return out;
+  };
+  const double children = std::visit(
+      utils::overloaded{
+          [](const ast::Const&) { return -1.0; },
+          [](const ast::Predicate&) { return 0.0; },
+          [&](const ast::NotPtr& e) { return error_bound(e->arg, epsilon); },
+          [&](const ast::AndPtr& e) { return max_of(e->args); },
+          [&](const ast::OrPtr& e) { return max_of(e->args); },
+          [&](const ast::EventuallyPtr& e) { return error_bound(e->arg, epsilon); },
+          [&](const ast::AlwaysPtr& e) { return error_bound(e->arg, epsilon); },
+          [](const ast::UntilPtr&) { return 0.0; },
+          [&](const ast::HistoricallyPtr& e) { return error_bound(e->arg, epsilon); },
+          [&](const ast::OncePtr& e) { return error_bound(e->arg, epsilon); },
+          [](const ast::SincePtr&) { return 0.0; }},
+      phi);
+  // Constants are exact.
+  return (children < 0) ? 0.0 : children + epsilon;
+}
 
-SignalPtr compute_robustness(const ast::Expr& phi, const signal::Trace& trace, bool) {
+/**
+ * Set up the evaluation of a formula with horizon `h` over `trace`, and call `fn` with
+ * the robustness operator for the query interval in `options`.
+ */
+template <typename T, typename V, typename Fn>
+auto evaluate(
+    const ast::Horizon& h,
+    const BasicTrace<T, V>& trace,
+    const RobustnessOptions& options,
+    Fn&& fn) {
   // Compute the start and end of the trace.
   struct MinMaxTime {
-    double begin{TOP};
-    double end{BOTTOM};
-    void operator()(const std::pair<std::string, SignalPtr>& entry) {
+    T begin{std::numeric_limits<T>::max()};
+    T end{std::numeric_limits<T>::lowest()};
+    void operator()(const std::pair<std::string, BasicSignalPtr<T, V>>& entry) {
       auto s = entry.second;
       begin  = std::min(begin, s->begin_time());
       end    = std::max(end, s->end_time());
@@ -94,121 +416,771 @@ SignalPtr compute_robustness(const ast::Expr& phi, const signal::Trace& trace, b
 
   const MinMaxTime minmaxtime =
       std::for_each(trace.cbegin(), trace.cend(), MinMaxTime{});
-  double min_time = minmaxtime.begin;
-  double max_time = minmaxtime.end;
+  T min_time = minmaxtime.begin;
+  T max_time = minmaxtime.end;
+
+  if (options.query_begin > options.query_end) {
+    throw std::invalid_argument(fmt::format(
+        "Query interval [{}, {}] is empty", options.query_begin, options.query_end));
+  }
+  if (options.query_end < static_cast<double>(min_time) ||
+      options.query_begin > static_cast<double>(max_time)) {
+    throw std::out_of_range(fmt::format(
+        "Query interval [{}, {}] does not intersect the trace",
+        options.query_begin,
+        options.query_end));
+  }
+  const auto query_begin = std::max(options.query_begin, static_cast<double>(min_time));
+  const auto query_end   = std::min(options.query_end, static_cast<double>(max_time));
+
+  // If the formula is bounded, only the samples within its horizon around the query
+  // are read, so the evaluation works on views of those parts of the trace.
+  auto sliced       = BasicTrace<T, V>{};
+  const auto* input = &trace;
+  if (h.is_bounded()) {
+    const auto lo =
+        time_cast<T>(std::max(query_begin - h.past, static_cast<double>(min_time)));
+    const auto hi =
+        time_cast<T>(std::min(query_end + h.future, static_cast<double>(max_time)));
+    for (const auto& [name, x] : trace) { sliced.emplace(name, slice_view(x, lo, hi)); }
+    input = &sliced;
+  }
 
-  auto rob = RobustnessOp{min_time, max_time, trace};
+  auto stats     = MemoryStats{};
+  const auto rob = RobustnessOp<T, V>{
+      min_time,
+      max_time,
+      time_cast<T>(query_begin),
+      time_cast<T>(query_end),
+      input,
+      static_cast<V>(std::max(options.epsilon, 0.0)),
+      &stats};
 
-  SignalPtr out = compute(phi, rob);
+  return fn(rob);
+}
 
+/**
+ * Set up the evaluation of `phi` over `trace`, and call `fn` with the robustness
+ * operator for the query interval in `options`.
+ */
+template <typename T, typename V, typename Fn>
+auto evaluate(
+    const ast::Expr& phi,
+    const BasicTrace<T, V>& trace,
+    const RobustnessOptions& options,
+    Fn&& fn) {
+  return evaluate(ast::horizon(phi), trace, options, std::forward<Fn>(fn));
+}
+
+/**
+ * Evaluates the robustness of formulas at a single time point `t`.
+ *
+ * The Boolean operators are evaluated at `t` directly, and only the temporal operators
+ * compute robustness signals (over their horizon, with `RobustnessOp`). The children
+ * of And/Or nodes are visited in the order of bounds on their robustness, computed
+ * from the (cached) extrema of the signals in the trace, and skipped once the bounds
+ * show that they cannot change the result.
+ *
+ * The windowed min/max of a predicate is answered by the range index of its signal,
+ * if the index has already been built (see `Signal::range_index()`).
+ */
+template <typename T, typename V>
+struct ScalarOp {
+  const RobustnessOp<T, V>& rob;
+  T t;
+  /// The trace, before it is sliced to the horizon of the formula.
+  const BasicTrace<T, V>* source;
+
+  /// Lower and upper bounds on the robustness of `phi` over the trace.
+  std::pair<V, V> bounds(const ast::Expr& phi) const;
+  /// The robustness of `phi` at `t`.
+  V value(const ast::Expr& phi) const;
+  /// The sign (-1, 0, or 1) of the robustness of `phi` at `t`.
+  int sign(const ast::Expr& phi) const;
+
+ private:
+  /// Children of a node, with the bounds on their robustness (multiplied by `dir`),
+  /// sorted by the lower bound.
+  std::vector<std::tuple<V, V, const ast::Expr*>>
+  ordered(const std::vector<ast::Expr>& args, int dir) const;
+  /// The minimum over `args` of `dir` times their robustness at `t`.
+  V min_of(const std::vector<ast::Expr>& args, int dir) const;
+  /// The minimum over `args` of `dir` times the sign of their robustness at `t`.
+  int min_sign_of(const std::vector<ast::Expr>& args, int dir) const;
+  /// The robustness at `t` of the temporal operator `phi`, whose output is the windowed
+  /// max (or min) of `arg`.
+  V windowed(
+      const ast::Expr& phi,
+      const ast::Expr& arg,
+      const ast::Interval& interval,
+      bool is_max) const;
+};
+
+template <typename T, typename V>
+std::pair<V, V> ScalarOp<T, V>::bounds(const ast::Expr& phi) const {
+  const auto fold = [this](const std::vector<ast::Expr>& args, int dir) {
+    const auto order = this->ordered(args, dir);
+    V lo = TOP<V>, hi = TOP<V>;
+    for (const auto& [l, h, arg] : order) {
+      lo = std::min(lo, l);
+      hi = std::min(hi, h);
+    }
+    return (dir > 0) ? std::make_pair(lo, hi) : std::make_pair(-hi, -lo);
+  };
+  return std::visit(
+      utils::overloaded{
+          [](const ast::Const& e) {
+            const V val = (e.value) ? TOP<V> : BOTTOM<V>;
+            return std::make_pair(val, val);
+          },
+          [this](const ast::Predicate& e) {
+            const auto summary = this->rob.trace->at(e.name)->summary();
+            const V lo = summary.min, hi = summary.max;
+            const auto c = static_cast<V>(e.rhs);
+            const bool lower =
+                e.op == ast::ComparisonOp::GE || e.op == ast::ComparisonOp::GT;
+            return (lower) ? std::make_pair(lo - c, hi - c)
+                           : std::make_pair(c - hi, c - lo);
+          },
+          [this](const ast::NotPtr& e) {
+            const auto [lo, hi] = this->bounds(e->arg);
+            return std::make_pair(-hi, -lo);
+          },
+          [&](const ast::AndPtr& e) { return fold(e->args, 1); },
+          [&](const ast::OrPtr& e) { return fold(e->args, -1); },
+          // The windowed min/max of a signal stays within the bounds of the signal.
+          [this](const ast::EventuallyPtr& e) { return this->bounds(e->arg); },
+          [this](const ast::AlwaysPtr& e) { return this->bounds(e->arg); },
+          [this](const ast::UntilPtr& e) {
+            const auto [lo1, hi1] = this->bounds(e->args.first);
+            const auto [lo2, hi2] = this->bounds(e->args.second);
+            return std::make_pair(
+                std::min({lo1, lo2, -hi2}), std::max({hi1, hi2, -lo2}));
+          },
+          [this](const ast::HistoricallyPtr& e) { return this->bounds(e->arg); },
+          [this](const ast::OncePtr& e) { return this->bounds(e->arg); },
+          // The robustness is the min of values of the operands, below that of `psi`.
+          [this](const ast::SincePtr& e) {
+            const auto lo1        = this->bounds(e->args.first).first;
+            const auto [lo2, hi2] = this->bounds(e->args.second);
+            return std::make_pair(std::min(lo1, lo2), hi2);
+          }},
+      phi);
+}
+
+template <typename T, typename V>
+std::vector<std::tuple<V, V, const ast::Expr*>>
+ScalarOp<T, V>::ordered(const std::vector<ast::Expr>& args, int dir) const {
+  auto out = std::vector<std::tuple<V, V, const ast::Expr*>>{};
+  out.reserve(args.size());
+  for (const auto& arg : args) {
+    const auto [lo, hi] = this->bounds(arg);
+    if (dir > 0) {
+      out.emplace_back(lo, hi, &arg);
+    } else {
+      out.emplace_back(-hi, -lo, &arg);
+    }
+  }
+  std::stable_sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+    return std::get<0>(a) < std::get<0>(b);
+  });
   return out;
 }
 
-SignalPtr RobustnessOp::operator()(const ast::Const e) const {
-  const double val = (e.value) ? static_cast<double>(TOP) : static_cast<double>(BOTTOM);
-  auto samples     = std::vector<Sample>{{min_time, val, 0.0}, {max_time, val, 0.0}};
-  return std::make_shared<Signal>(samples);
-}
-
-SignalPtr RobustnessOp::operator()(const ast::Predicate& e) const {
-  const auto& x = trace.at(e.name);
-  auto y        = std::make_shared<Signal>();
-  for (const auto& sample : *x) {
-    const double t = sample.time;
-    const double v = sample.value;
-    switch (e.op) {
-      case ast::ComparisonOp::GE:
-      case ast::ComparisonOp::GT:
-        y->push_back(t, v - e.rhs);
-        break;
-      case ast::ComparisonOp::LE:
-      case ast::ComparisonOp::LT:
-        y->push_back(t, e.rhs - v);
-        break;
+template <typename T, typename V>
+V ScalarOp<T, V>::min_of(const std::vector<ast::Expr>& args, int dir) const {
+  V out = TOP<V>;
+  for (const auto& [lo, hi, arg] : this->ordered(args, dir)) {
+    // The remaining children are no smaller than this bound.
+    if (lo >= out) {
+      break;
     }
+    out = std::min(out, static_cast<V>(dir) * this->value(*arg));
   }
-  return y;
+  return out;
+}
+
+template <typename T, typename V>
+int ScalarOp<T, V>::min_sign_of(const std::vector<ast::Expr>& args, int dir) const {
+  const auto order = this->ordered(args, dir);
+  for (const auto& [lo, hi, arg] : order) {
+    if (hi < 0) {
+      return -1;
+    }
+  }
+  int out = 1;
+  for (const auto& [lo, hi, arg] : order) {
+    // The remaining children are all positive.
+    if (lo > 0) {
+      break;
+    }
+    out = std::min(out, dir * this->sign(*arg));
+    if (out < 0) {
+      return out;
+    }
+  }
+  return out;
+}
+
+template <typename T, typename V>
+V ScalarOp<T, V>::value(const ast::Expr& phi) const {
+  const auto at_t = [this](const BasicSignalPtr<T, V>& x) {
+    V out = 0;
+    x->interpolate_at(&this->t, &this->t + 1, &out);
+    return out;
+  };
+  return std::visit(
+      utils::overloaded{
+          [](const ast::Const& e) { return (e.value) ? TOP<V> : BOTTOM<V>; },
+          [&](const ast::Predicate& e) {
+            const V x = at_t(this->rob.trace->at(e.name));
+            const auto c = static_cast<V>(e.rhs);
+            const bool lower =
+                e.op == ast::ComparisonOp::GE || e.op == ast::ComparisonOp::GT;
+            return (lower) ? x - c : c - x;
+          },
+          [this](const ast::NotPtr& e) { return -this->value(e->arg); },
+          [this](const ast::AndPtr& e) { return this->min_of(e->args, 1); },
+          [this](const ast::OrPtr& e) { return -this->min_of(e->args, -1); },
+          [&](const ast::EventuallyPtr& e) {
+            return this->windowed(phi, e->arg, e->interval, true);
+          },
+          [&](const ast::AlwaysPtr& e) {
+            return this->windowed(phi, e->arg, e->interval, false);
+          },
+          // The other temporal operators are computed over their horizon from `t`.
+          [&](const auto&) {
+            return at_t(compute(phi, this->rob.over(this->t, this->t)));
+          }},
+      phi);
+}
+
+template <typename T, typename V>
+V ScalarOp<T, V>::windowed(
+    const ast::Expr& phi,
+    const ast::Expr& arg,
+    const ast::Interval& interval,
+    bool is_max) const {
+  const auto [a, b] = interval.as_double();
+  const auto* pred  = std::get_if<ast::Predicate>(&arg);
+  const auto index =
+      (pred != nullptr) ? this->source->at(pred->name)->cached_range_index() : nullptr;
+  if (index == nullptr || b - a <= 0) {
+    V out = 0;
+    const auto y = compute(phi, this->rob.over(this->t, this->t));
+    y->interpolate_at(&this->t, &this->t + 1, &out);
+    return out;
+  }
+
+  const T start = (interval.is_zero_to_inf()) ? this->t : this->rob.after(this->t, a);
+  const T end   = this->rob.after(this->t, b);
+  const auto c  = static_cast<V>(pred->rhs);
+  if (pred->op == ast::ComparisonOp::GE || pred->op == ast::ComparisonOp::GT) {
+    return (is_max) ? index->max(start, end) - c : index->min(start, end) - c;
+  }
+  return (is_max) ? c - index->min(start, end) : c - index->max(start, end);
 }
 
-SignalPtr RobustnessOp::operator()(const ast::NotPtr& e) const {
-  auto x   = compute(e->arg, *this);
-  auto vec = std::vector<Sample>{};
-  vec.reserve(x->size());
-  std::transform(x->begin(), x->end(), std::back_inserter(vec), std::negate<>());
-  return std::make_shared<Signal>(vec);
+template <typename T, typename V>
+int ScalarOp<T, V>::sign(const ast::Expr& phi) const {
+  return std::visit(
+      utils::overloaded{
+          [this](const ast::NotPtr& e) { return -this->sign(e->arg); },
+          [this](const ast::AndPtr& e) { return this->min_sign_of(e->args, 1); },
+          [this](const ast::OrPtr& e) { return -this->min_sign_of(e->args, -1); },
+          [&](const auto&) {
+            const V val = this->value(phi);
+            return (val > 0) ? 1 : ((val < 0) ? -1 : 0);
+          }},
+      phi);
 }
 
-SignalPtr RobustnessOp::operator()(const ast::AndPtr& e) const {
-  auto ys = std::vector<SignalPtr>{};
-  ys.reserve(e->args.size());
-  std::transform(
-      e->args.begin(), e->args.end(), std::back_inserter(ys), [this](const auto arg) {
-        return compute(arg, *this);
-      });
-  assert(ys.size() == e->args.size());
-  return compute_elementwise_min(ys);
+/**
+ * Evaluates a parametric formula for many values of its parameters.
+ *
+ * The robustness of a node is split into a signal, and a constant offset: a predicate
+ * `x >= c` is the signal `x` offset by `-c`, and the negation and the windowed min/max
+ * commute with offsets. The signal of a node thus only depends on some of the
+ * parameters of its subformula, and is cached by the values of those. The predicates,
+ * the temporal operators above them, and the subformulas whose parameters do not vary
+ * are computed once for the whole grid.
+ */
+template <typename T, typename V>
+struct SweepOp {
+  using SignalPtr = BasicSignalPtr<T, V>;
+  using Key       = std::pair<const ast::Expr*, std::vector<std::optional<double>>>;
+
+  /// Computes every node over the whole (sliced) trace, so that the cached signals do
+  /// not depend on the windows above them.
+  RobustnessOp<T, V> rob;
+  /// The parameters the signal of each node depends on.
+  std::map<const ast::Expr*, std::vector<std::string>> depends;
+  std::map<Key, SignalPtr> cache;
+  /// The current values of the parameters.
+  const ast::ParameterValues* values = nullptr;
+
+  SweepOp(const RobustnessOp<T, V>& op, const ast::Expr& phi);
+
+  /// The robustness of `phi` for the current values of the parameters.
+  SignalPtr robustness(const ast::Expr& phi);
+
+ private:
+  /// Record the parameters the signals of `phi` and its children depend on, and return
+  /// the parameters that only change the offset of `phi`.
+  std::set<std::string> collect(const ast::Expr& phi);
+  /// The current value of the parameter `name`, or `default_value` if `name` is empty
+  /// or not given a value.
+  [[nodiscard]] double value_of(const std::string& name, double default_value) const;
+  /// The robustness of `phi` minus its offset.
+  SignalPtr signal_of(const ast::Expr& phi);
+  [[nodiscard]] V offset_of(const ast::Expr& phi) const;
+};
+
+template <typename T, typename V>
+SweepOp<T, V>::SweepOp(const RobustnessOp<T, V>& op, const ast::Expr& phi) {
+  T lo = op.max_time, hi = op.min_time;
+  for (const auto& [name, x] : *op.trace) {
+    lo = std::min(lo, x->begin_time());
+    hi = std::max(hi, x->end_time());
+  }
+  this->rob = op.over(lo, hi);
+  this->collect(phi);
 }
 
-SignalPtr RobustnessOp::operator()(const ast::OrPtr& e) const {
-  auto ys = std::vector<SignalPtr>{};
-  ys.reserve(e->args.size());
-  std::transform(
-      e->args.begin(), e->args.end(), std::back_inserter(ys), [this](const auto arg) {
-        return compute(arg, *this);
-      });
-  assert(ys.size() == e->args.size());
-  return compute_elementwise_max(ys);
+template <typename T, typename V>
+std::set<std::string> SweepOp<T, V>::collect(const ast::Expr& phi) {
+  auto deps    = std::set<std::string>{};
+  auto offsets = std::set<std::string>{};
+  // The signal of a negation or a windowed min/max is that of its operand, and the
+  // other operators depend on the full robustness of their operands.
+  const auto unary = [&](const ast::Expr& arg) {
+    offsets         = this->collect(arg);
+    const auto& sub = this->depends.at(&arg);
+    deps.insert(sub.begin(), sub.end());
+  };
+  const auto nary = [&](const ast::Expr& arg) {
+    deps.merge(this->collect(arg));
+    const auto& sub = this->depends.at(&arg);
+    deps.insert(sub.begin(), sub.end());
+  };
+  const auto window = [&](const ast::Interval& interval) {
+    for (const auto& name : {interval.low_param, interval.high_param}) {
+      if (!name.empty()) {
+        deps.insert(name);
+      }
+    }
+  };
+
+  std::visit(
+      utils::overloaded{
+          [](const ast::Const&) {},
+          [&](const ast::Predicate& e) {
+            if (!e.param.empty()) {
+              offsets.insert(e.param);
+            }
+          },
+          [&](const ast::NotPtr& e) { unary(e->arg); },
+          [&](const ast::AndPtr& e) {
+            for (const auto& arg : e->args) { nary(arg); }
+          },
+          [&](const ast::OrPtr& e) {
+            for (const auto& arg : e->args) { nary(arg); }
+          },
+          [&](const ast::EventuallyPtr& e) {
+            unary(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::AlwaysPtr& e) {
+            unary(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::UntilPtr& e) {
+            nary(e->args.first);
+            nary(e->args.second);
+            window(e->interval);
+          },
+          [&](const ast::HistoricallyPtr& e) {
+            unary(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::OncePtr& e) {
+            unary(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::SincePtr& e) {
+            nary(e->args.first);
+            nary(e->args.second);
+            window(e->interval);
+          }},
+      phi);
+  this->depends[&phi] = std::vector<std::string>(deps.begin(), deps.end());
+  return offsets;
 }
 
-SignalPtr RobustnessOp::operator()(const ast::EventuallyPtr& e) const {
-  auto y = compute(e->arg, *this);
-  if (!e->interval.has_value()) {
-    return compute_max_seq(y);
+template <typename T, typename V>
+double SweepOp<T, V>::value_of(const std::string& name, double default_value) const {
+  if (name.empty()) {
+    return default_value;
   }
+  const auto it = this->values->find(name);
+  return (it == this->values->end()) ? default_value : it->second;
+}
 
-  const auto [a, b] = e->interval.as_double();
-  if (b - a < 0) {
-    throw std::logic_error("Eventually operator: b < a in interval [a,b]");
-  } else if (b - a == 0) {
-    return y;
-  } else if (b - a >= y->end_time() - y->begin_time()) {
-    return compute_max_seq(y);
-  } else {
-    return compute_max_seq(y, a, b);
+template <typename T, typename V>
+V SweepOp<T, V>::offset_of(const ast::Expr& phi) const {
+  return std::visit(
+      utils::overloaded{
+          [this](const ast::Predicate& e) -> V {
+            if (e.param.empty()) {
+              return 0;
+            }
+            const auto c = static_cast<V>(this->value_of(e.param, e.rhs));
+            const bool lower =
+                e.op == ast::ComparisonOp::GE || e.op == ast::ComparisonOp::GT;
+            return (lower) ? -c : c;
+          },
+          [this](const ast::NotPtr& e) { return -this->offset_of(e->arg); },
+          [this](const ast::EventuallyPtr& e) { return this->offset_of(e->arg); },
+          [this](const ast::AlwaysPtr& e) { return this->offset_of(e->arg); },
+          [this](const ast::HistoricallyPtr& e) { return this->offset_of(e->arg); },
+          [this](const ast::OncePtr& e) { return this->offset_of(e->arg); },
+          [](const auto&) -> V { return 0; }},
+      phi);
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> SweepOp<T, V>::robustness(const ast::Expr& phi) {
+  auto out     = this->signal_of(phi);
+  const V diff = this->offset_of(phi);
+  if (diff != 0) {
+    make_mutable(out).affine_inplace(1, diff);
   }
+  return out;
 }
 
-SignalPtr RobustnessOp::operator()(const ast::AlwaysPtr& e) const {
-  auto y = compute(e->arg, *this);
-  if (!e->interval.has_value()) {
-    return compute_min_seq(y);
+template <typename T, typename V>
+BasicSignalPtr<T, V> SweepOp<T, V>::signal_of(const ast::Expr& phi) {
+  auto key = Key{&phi, {}};
+  for (const auto& name : this->depends.at(&phi)) {
+    const auto it = this->values->find(name);
+    key.second.push_back(
+        (it == this->values->end()) ? std::nullopt : std::optional{it->second});
+  }
+  if (const auto it = this->cache.find(key); it != this->cache.end()) {
+    return it->second;
   }
 
-  const auto [a, b] = e->interval.as_double();
-  if (b - a < 0) {
-    throw std::logic_error("Always operator: b < a in interval [a,b]");
-  } else if (b - a == 0) {
-    return y;
-  } else if (b - a >= y->end_time() - y->begin_time()) {
-    return compute_min_seq(y);
-  } else {
-    return compute_min_seq(y, a, b);
+  const auto window = [this](const ast::Interval& interval) {
+    const auto [a, b] = interval.as_double();
+    return std::make_pair(
+        this->value_of(interval.low_param, a), this->value_of(interval.high_param, b));
+  };
+  const auto fold = [this](const std::vector<ast::Expr>& args, auto&& fold_fn) {
+    SignalPtr out = nullptr;
+    for (const auto& arg : args) {
+      auto y = this->robustness(arg);
+      out    = (out == nullptr) ? std::move(y) : fold_fn(out, y);
+    }
+    return out;
+  };
+
+  SignalPtr out = std::visit(
+      utils::overloaded{
+          [this](const ast::Const& e) { return this->rob(e); },
+          [this](const ast::Predicate& e) {
+            // The threshold of a parametric predicate is its offset.
+            return (e.param.empty()) ? this->rob(e)
+                                     : this->rob(ast::Predicate{e.name, e.op, 0.0});
+          },
+          [this](const ast::NotPtr& e) {
+            auto y = this->signal_of(e->arg);
+            make_mutable(y).affine_inplace(-1, 0);
+            return y;
+          },
+          [&](const ast::AndPtr& e) {
+            return fold(e->args, [](const SignalPtr& x, const SignalPtr& y) {
+              return compute_elementwise_min(x, y);
+            });
+          },
+          [&](const ast::OrPtr& e) {
+            return fold(e->args, [](const SignalPtr& x, const SignalPtr& y) {
+              return compute_elementwise_max(x, y);
+            });
+          },
+          [&](const ast::EventuallyPtr& e) {
+            const auto [a, b] = window(e->interval);
+            return compute_window(this->signal_of(e->arg), a, b, true);
+          },
+          [&](const ast::AlwaysPtr& e) {
+            const auto [a, b] = window(e->interval);
+            return compute_window(this->signal_of(e->arg), a, b, false);
+          },
+          [&](const ast::UntilPtr& e) {
+            const auto [a, b] = window(e->interval);
+            auto y1           = this->robustness(e->args.first);
+            auto y2           = this->robustness(e->args.second);
+            if (std::isinf(b) && a == 0) {
+              return compute_until(y1, y2);
+            }
+            return compute_until(y1, y2, time_cast<T>(a), time_cast<T>(b));
+          },
+          [&](const ast::HistoricallyPtr& e) {
+            const auto [a, b] = window(e->interval);
+            return compute_past_window(this->signal_of(e->arg), a, b, false);
+          },
+          [&](const ast::OncePtr& e) {
+            const auto [a, b] = window(e->interval);
+            return compute_past_window(this->signal_of(e->arg), a, b, true);
+          },
+          [&](const ast::SincePtr& e) {
+            const auto [a, b] = window(e->interval);
+            auto y1           = this->robustness(e->args.first);
+            auto y2           = this->robustness(e->args.second);
+            return compute_since(y1, y2, a, b);
+          }},
+      phi);
+  if (this->rob.epsilon > 0 && !std::holds_alternative<ast::Const>(phi)) {
+    make_mutable(out).simplify_inplace(this->rob.epsilon);
   }
+  this->cache.emplace(std::move(key), out);
+  return out;
 }
 
-SignalPtr RobustnessOp::operator()(const ast::UntilPtr& e) const {
-  auto y1 = compute(e->args.first, *this);
-  auto y2 = compute(e->args.second, *this);
-  if (!e->interval.has_value()) {
-    return compute_until(y1, y2);
+} // namespace
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> compute_robustness(
+    const ast::Expr& phi,
+    const BasicTrace<T, V>& trace,
+    bool synchronized) {
+  return compute_robustness(phi, trace, RobustnessOptions{synchronized});
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> compute_robustness(
+    const ast::Expr& phi,
+    const BasicTrace<T, V>& trace,
+    const RobustnessOptions& options,
+    RobustnessReport* report) {
+  return evaluate(phi, trace, options, [&](const RobustnessOp<T, V>& rob) {
+    BasicSignalPtr<T, V> out = compute(phi, rob);
+    if (out->begin_time() < rob.begin || out->end_time() > rob.end) {
+      out = out->slice(rob.begin, rob.end);
+    }
+    if (report != nullptr) {
+      report->error_bound = (rob.epsilon > 0) ? error_bound(phi, rob.epsilon) : 0.0;
+      report->peak_memory = rob.stats->peak;
+    }
+    return out;
+  });
+}
+
+template <typename T, typename V>
+V compute_robustness_at(const ast::Expr& phi, const BasicTrace<T, V>& trace, T t0) {
+  auto options        = RobustnessOptions{};
+  options.query_begin = static_cast<double>(t0);
+  options.query_end   = static_cast<double>(t0);
+  return evaluate(phi, trace, options, [&](const RobustnessOp<T, V>& rob) {
+    return ScalarOp<T, V>{rob, rob.begin, &trace}.value(phi);
+  });
+}
+
+template <typename T, typename V>
+int compute_sign_at(const ast::Expr& phi, const BasicTrace<T, V>& trace, T t0) {
+  auto options        = RobustnessOptions{};
+  options.query_begin = static_cast<double>(t0);
+  options.query_end   = static_cast<double>(t0);
+  return evaluate(phi, trace, options, [&](const RobustnessOp<T, V>& rob) {
+    return ScalarOp<T, V>{rob, rob.begin, &trace}.sign(phi);
+  });
+}
+
+template <typename T, typename V>
+std::vector<BasicSignalPtr<T, V>> compute_robustness_sweep(
+    const ast::Expr& phi,
+    const BasicTrace<T, V>& trace,
+    const std::vector<ast::ParameterValues>& grid,
+    const RobustnessOptions& options) {
+  // The trace is sliced to the largest horizon of the formula over the grid. This also
+  // checks that the values of the interval bounds are valid.
+  auto h = ast::Horizon{};
+  for (const auto& values : grid) {
+    const auto hv = ast::horizon(ast::substitute(phi, values));
+    h.past        = std::max(h.past, hv.past);
+    h.future      = std::max(h.future, hv.future);
+  }
+
+  return evaluate(h, trace, options, [&](const RobustnessOp<T, V>& rob) {
+    auto sweep = SweepOp<T, V>{rob, phi};
+    auto out   = std::vector<BasicSignalPtr<T, V>>{};
+    out.reserve(grid.size());
+    for (const auto& values : grid) {
+      sweep.values = &values;
+      auto y       = sweep.robustness(phi);
+      if (y->begin_time() < rob.begin || y->end_time() > rob.end) {
+        y = y->slice(rob.begin, rob.end);
+      }
+      out.push_back(std::move(y));
+    }
+    return out;
+  });
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::Const e) const {
+  const V val  = (e.value) ? TOP<V> : BOTTOM<V>;
+  auto samples = std::vector<BasicSample<T, V>>{{begin, val, 0}};
+  if (end > begin) {
+    samples.push_back({end, val, 0});
+  }
+  return std::make_shared<BasicSignal<T, V>>(samples, Interpolation::Step);
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::Predicate& e) const {
+  // The signal is shared with the trace, so this copies the part of it that is needed
+  // once.
+  auto y       = slice_view(trace->at(e.name), begin, end);
+  const auto c = static_cast<V>(e.rhs);
+  switch (e.op) {
+    case ast::ComparisonOp::GE:
+    case ast::ComparisonOp::GT:
+      make_mutable(y).affine_inplace(1, -c);
+      break;
+    case ast::ComparisonOp::LE:
+    case ast::ComparisonOp::LT:
+      make_mutable(y).affine_inplace(-1, c);
+      break;
   }
+  return y;
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::NotPtr& e) const {
+  auto x = compute(e->arg, *this);
+  make_mutable(x).affine_inplace(-1, 0);
+  return x;
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::AndPtr& e) const {
+  if (e->args.empty()) {
+    return compute_elementwise_min(std::vector<SignalPtr>{});
+  }
+  auto args = std::vector<const ast::Expr*>{};
+  for (const auto& arg : e->args) { args.push_back(&arg); }
+  return this->fold(args, [](const SignalPtr& x, const SignalPtr& y) {
+    return compute_elementwise_min(x, y);
+  });
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::OrPtr& e) const {
+  if (e->args.empty()) {
+    return compute_elementwise_max(std::vector<SignalPtr>{});
+  }
+  auto args = std::vector<const ast::Expr*>{};
+  for (const auto& arg : e->args) { args.push_back(&arg); }
+  return this->fold(args, [](const SignalPtr& x, const SignalPtr& y) {
+    return compute_elementwise_max(x, y);
+  });
+}
 
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::EventuallyPtr& e) const {
+  // The output at `t` depends on the input over `[t + a, t + b]`.
   const auto [a, b] = e->interval.as_double();
+  auto y            = compute(e->arg, this->over(begin, this->after(end, b)));
+  return compute_window(y, a, b, true);
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::AlwaysPtr& e) const {
+  // The output at `t` depends on the input over `[t + a, t + b]`.
+  const auto [a, b] = e->interval.as_double();
+  auto y            = compute(e->arg, this->over(begin, this->after(end, b)));
+  return compute_window(y, a, b, false);
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::UntilPtr& e) const {
+  // The output at `t` depends on the operands over `[t, t + b]`. Evaluate the operand
+  // with the larger register need first. The operands are not simplified, see
+  // `error_bound`.
+  const auto [a, b] = e->interval.as_double();
+  const auto op     = this->over(begin, this->after(end, b)).exact();
+  auto y1 = SignalPtr{}, y2 = SignalPtr{};
+  if (register_need(e->args.first) >= register_need(e->args.second)) {
+    y1 = compute(e->args.first, op);
+    y2 = compute(e->args.second, op);
+  } else {
+    y2 = compute(e->args.second, op);
+    y1 = compute(e->args.first, op);
+  }
+  if (e->interval.is_zero_to_inf()) {
+    return compute_until(y1, y2);
+  }
+
   if (std::isinf(b) && a == 0) {
     return compute_until(y1, y2);
   } else {
-    return compute_until(y1, y2, a, b);
+    return compute_until(y1, y2, time_cast<T>(a), time_cast<T>(b));
   }
 }
 
+template <typename T, typename V>
+BasicSignalPtr<T, V>
+RobustnessOp<T, V>::operator()(const ast::HistoricallyPtr& e) const {
+  // The output at `t` depends on the input over `[t - b, t - a]`.
+  const auto [a, b] = e->interval.as_double();
+  auto y            = compute(e->arg, this->over(this->before(begin, b), end));
+  return compute_past_window(y, a, b, false);
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::OncePtr& e) const {
+  // The output at `t` depends on the input over `[t - b, t - a]`.
+  const auto [a, b] = e->interval.as_double();
+  auto y            = compute(e->arg, this->over(this->before(begin, b), end));
+  return compute_past_window(y, a, b, true);
+}
+
+template <typename T, typename V>
+BasicSignalPtr<T, V> RobustnessOp<T, V>::operator()(const ast::SincePtr& e) const {
+  // The output at `t` depends on the operands over `[t - b, t]`. Evaluate the operand
+  // with the larger register need first. The operands are not simplified, see
+  // `error_bound`.
+  const auto [a, b] = e->interval.as_double();
+  const auto op     = this->over(this->before(begin, b), end).exact();
+  auto y1 = SignalPtr{}, y2 = SignalPtr{};
+  if (register_need(e->args.first) >= register_need(e->args.second)) {
+    y1 = compute(e->args.first, op);
+    y2 = compute(e->args.second, op);
+  } else {
+    y2 = compute(e->args.second, op);
+    y1 = compute(e->args.first, op);
+  }
+  return compute_since(y1, y2, a, b);
+}
+
+#define SIGNALTL_INSTANTIATE_ROBUSTNESS(T, V)                                       \
+  template BasicSignalPtr<T, V> compute_robustness<T, V>(                           \
+      const ast::Expr&, const BasicTrace<T, V>&, bool);                             \
+  template BasicSignalPtr<T, V> compute_robustness<T, V>(                           \
+      const ast::Expr&, const BasicTrace<T, V>&, const RobustnessOptions&,          \
+      RobustnessReport*);                                                           \
+  template V compute_robustness_at<T, V>(                                           \
+      const ast::Expr&, const BasicTrace<T, V>&, T);                                \
+  template int compute_sign_at<T, V>(const ast::Expr&, const BasicTrace<T, V>&, T); \
+  template std::vector<BasicSignalPtr<T, V>> compute_robustness_sweep<T, V>(        \
+      const ast::Expr&, const BasicTrace<T, V>&,                                    \
+      const std::vector<ast::ParameterValues>&, const RobustnessOptions&);
+
+SIGNALTL_INSTANTIATE_ROBUSTNESS(double, double)
+SIGNALTL_INSTANTIATE_ROBUSTNESS(double, float)
+SIGNALTL_INSTANTIATE_ROBUSTNESS(std::int64_t, double)
+SIGNALTL_INSTANTIATE_ROBUSTNESS(std::int64_t, float)
+
+#undef SIGNALTL_INSTANTIATE_ROBUSTNESS
+
 } // namespace signal_tl::semantics
@@ -0,0 +1,292 @@
+#include "signal_tl/mining.hpp"
+#include "signal_tl/ast.hpp"
+#include "signal_tl/robustness.hpp"
+#include "signal_tl/signal.hpp"
+
+#include "signal_tl/internal/parallel.hpp"
+#include "signal_tl/internal/utils.hpp"
+
+#include <algorithm>    // for min, max
+#include <cmath>        // for abs
+#include <cstdint>      // for int64_t
+#include <fmt/format.h> // for format
+#include <limits>       // for numeric_limits
+#include <optional>     // for optional, nullopt
+#include <stdexcept>    // for invalid_argument
+#include <string>       // for string
+#include <utility>      // for pair
+#include <variant>      // for visit
+#include <vector>       // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+namespace {
+
+/// Combine the directions of two occurrences of `param`.
+int combine(int lhs, int rhs, const std::string& param) {
+  if (lhs == 0) {
+    return rhs;
+  } else if (rhs == 0 || lhs == rhs) {
+    return lhs;
+  }
+  throw std::invalid_argument(fmt::format(
+      "The robustness of the formula is not monotonic in the parameter {}", param));
+}
+
+/// Check if `param` only offsets the robustness of `phi`.
+bool is_offset(const ast::Expr& phi, const std::string& param) {
+  const auto in = [&param](const ast::Interval& interval) {
+    return interval.low_param == param || interval.high_param == param;
+  };
+  return std::visit(
+      utils::overloaded{
+          [&](const ast::Predicate& e) { return e.param == param; },
+          [&](const ast::NotPtr& e) { return is_offset(e->arg, param); },
+          [&](const ast::EventuallyPtr& e) {
+            return !in(e->interval) && is_offset(e->arg, param);
+          },
+          [&](const ast::AlwaysPtr& e) {
+            return !in(e->interval) && is_offset(e->arg, param);
+          },
+          [&](const ast::HistoricallyPtr& e) {
+            return !in(e->interval) && is_offset(e->arg, param);
+          },
+          [&](const ast::OncePtr& e) {
+            return !in(e->interval) && is_offset(e->arg, param);
+          },
+          [](const auto&) { return false; }},
+      phi);
+}
+
+/**
+ * Extend `range` with the values of `param` at which the robustness of `phi` can
+ * change sign.
+ *
+ * The robustness at a time point is a min/max of (windows of) the values of the
+ * predicates, so it can only be zero where one of them is. A predicate on `x` with a
+ * parametric threshold is zero for values between the extrema of `x`, and the windows
+ * of the temporal operators stop changing once they are longer than the trace.
+ */
+template <typename T, typename V>
+void crossing_range(
+    const ast::Expr& phi,
+    const std::string& param,
+    const BasicTrace<T, V>& trace,
+    double duration,
+    std::pair<double, double>& range) {
+  const auto extend = [&range](double lo, double hi) {
+    range.first  = std::min(range.first, lo);
+    range.second = std::max(range.second, hi);
+  };
+  const auto window = [&](const ast::Interval& interval) {
+    if (interval.low_param == param || interval.high_param == param) {
+      extend(0.0, duration);
+    }
+  };
+  const auto all = [&](const ast::Expr& arg) {
+    crossing_range(arg, param, trace, duration, range);
+  };
+
+  std::visit(
+      utils::overloaded{
+          [](const ast::Const&) {},
+          [&](const ast::Predicate& e) {
+            if (e.param == param) {
+              const auto summary = trace.at(e.name)->summary();
+              extend(
+                  static_cast<double>(summary.min), static_cast<double>(summary.max));
+            }
+          },
+          [&](const ast::NotPtr& e) { all(e->arg); },
+          [&](const ast::AndPtr& e) {
+            for (const auto& arg : e->args) { all(arg); }
+          },
+          [&](const ast::OrPtr& e) {
+            for (const auto& arg : e->args) { all(arg); }
+          },
+          [&](const ast::EventuallyPtr& e) {
+            all(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::AlwaysPtr& e) {
+            all(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::UntilPtr& e) {
+            all(e->args.first);
+            all(e->args.second);
+            window(e->interval);
+          },
+          [&](const ast::HistoricallyPtr& e) {
+            all(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::OncePtr& e) {
+            all(e->arg);
+            window(e->interval);
+          },
+          [&](const ast::SincePtr& e) {
+            all(e->args.first);
+            all(e->args.second);
+            window(e->interval);
+          }},
+      phi);
+}
+
+} // namespace
+
+int monotonicity(const ast::Expr& phi, const std::string& param) {
+  // Widening the window of a max (min) increases (decreases) its value.
+  const auto window = [&param](const ast::Interval& interval, int dir) {
+    int out = 0;
+    if (interval.low_param == param) {
+      out = combine(out, -dir, param);
+    }
+    if (interval.high_param == param) {
+      out = combine(out, dir, param);
+    }
+    return out;
+  };
+  const auto all = [&param](const std::vector<ast::Expr>& args) {
+    int out = 0;
+    for (const auto& arg : args) {
+      out = combine(out, monotonicity(arg, param), param);
+    }
+    return out;
+  };
+
+  return std::visit(
+      utils::overloaded{
+          [](const ast::Const&) { return 0; },
+          [&](const ast::Predicate& e) {
+            if (e.param != param) {
+              return 0;
+            }
+            const bool lower =
+                e.op == ast::ComparisonOp::GE || e.op == ast::ComparisonOp::GT;
+            return (lower) ? -1 : 1;
+          },
+          [&](const ast::NotPtr& e) { return -monotonicity(e->arg, param); },
+          [&](const ast::AndPtr& e) { return all(e->args); },
+          [&](const ast::OrPtr& e) { return all(e->args); },
+          [&](const ast::EventuallyPtr& e) {
+            return combine(monotonicity(e->arg, param), window(e->interval, 1), param);
+          },
+          [&](const ast::AlwaysPtr& e) {
+            return combine(monotonicity(e->arg, param), window(e->interval, -1), param);
+          },
+          [&](const ast::UntilPtr& e) {
+            return combine(
+                all({e->args.first, e->args.second}), window(e->interval, 1), param);
+          },
+          [&](const ast::HistoricallyPtr& e) {
+            return combine(monotonicity(e->arg, param), window(e->interval, -1), param);
+          },
+          [&](const ast::OncePtr& e) {
+            return combine(monotonicity(e->arg, param), window(e->interval, 1), param);
+          },
+          [&](const ast::SincePtr& e) {
+            return combine(
+                all({e->args.first, e->args.second}), window(e->interval, 1), param);
+          }},
+      phi);
+}
+
+template <typename T, typename V>
+std::optional<double> mine_parameter(
+    const ast::Expr& phi,
+    const std::string& param,
+    const BasicTrace<T, V>& trace,
+    const MiningOptions& options) {
+  if (options.lower > options.upper) {
+    throw std::invalid_argument(fmt::format(
+        "Search range [{}, {}] is empty", options.lower, options.upper));
+  }
+  const int dir = monotonicity(phi, param);
+  if (dir == 0) {
+    throw std::invalid_argument(
+        fmt::format("The formula does not depend on the parameter {}", param));
+  }
+
+  const T t0            = time_cast<T>(options.time);
+  const auto robustness = [&](double value) {
+    const auto psi = ast::substitute(phi, {{param, value}});
+    return static_cast<double>(compute_robustness_at(psi, trace, t0));
+  };
+
+  // The robustness is `r + dir * (value - p)`, so it is zero at `p - dir * r`.
+  if (is_offset(phi, param)) {
+    const double p         = std::clamp(0.0, options.lower, options.upper);
+    const double threshold = p - dir * robustness(p);
+    if ((dir > 0) ? threshold > options.upper : threshold < options.lower) {
+      return std::nullopt;
+    }
+    return std::clamp(threshold, options.lower, options.upper);
+  }
+
+  // The formula holds for the values on the `dir` side of the threshold.
+  double good = (dir > 0) ? options.upper : options.lower;
+  double bad  = (dir > 0) ? options.lower : options.upper;
+  if (robustness(good) < 0) {
+    return std::nullopt;
+  } else if (robustness(bad) >= 0) {
+    return bad;
+  }
+
+  // The threshold is among the values at which the robustness can change sign, a much
+  // smaller range to bisect in general.
+  const double inf = std::numeric_limits<double>::infinity();
+  auto range       = std::make_pair(inf, -inf);
+  T begin = std::numeric_limits<T>::max(), end = std::numeric_limits<T>::lowest();
+  for (const auto& [name, x] : trace) {
+    begin = std::min(begin, x->begin_time());
+    end   = std::max(end, x->end_time());
+  }
+  crossing_range(phi, param, trace, static_cast<double>(end - begin), range);
+  if (range.first <= range.second) {
+    good = std::clamp(good, range.first, range.second);
+    bad  = std::clamp(bad, range.first, range.second);
+  }
+
+  while (std::abs(good - bad) > options.tolerance) {
+    const double mid = bad + (good - bad) / 2;
+    // The bracket cannot be split any further.
+    if (mid == bad || mid == good) {
+      break;
+    }
+    if (robustness(mid) >= 0) {
+      good = mid;
+    } else {
+      bad = mid;
+    }
+  }
+  return good;
+}
+
+std::vector<std::optional<double>> mine_parameter_batch(
+    const ast::Expr& phi,
+    const std::string& param,
+    const std::vector<Trace>& traces,
+    const MiningOptions& options,
+    size_t n_threads) {
+  auto out = std::vector<std::optional<double>>(traces.size());
+  parallel::parallel_for(traces.size(), n_threads, [&](size_t i) {
+    out[i] = mine_parameter(phi, param, traces[i], options);
+  });
+  return out;
+}
+
+#define SIGNALTL_INSTANTIATE_MINING(T, V)                                           \
+  template std::optional<double> mine_parameter<T, V>(                              \
+      const ast::Expr&, const std::string&, const BasicTrace<T, V>&,                \
+      const MiningOptions&);
+
+SIGNALTL_INSTANTIATE_MINING(double, double)
+SIGNALTL_INSTANTIATE_MINING(double, float)
+SIGNALTL_INSTANTIATE_MINING(std::int64_t, double)
+SIGNALTL_INSTANTIATE_MINING(std::int64_t, float)
+
+#undef SIGNALTL_INSTANTIATE_MINING
+
+} // namespace signal_tl::semantics
@@ -2,28 +2,119 @@
 #include "mono_wedge.h" // for mono_wedge_update
 
 #include <algorithm>  // for max, reverse
+#include <cstdint>    // for int64_t
 #include <deque>      // for _Deque_iterator, deque, operator-
 #include <functional> // for greater_equal, less_equal
-#include <iterator>   // for prev, next, begin
+#include <iterator>   // for prev, next, begin, make_reverse_iterator
 #include <limits>     // for numeric_limits
 #include <memory>     // for __shared_ptr_access, make_shared
 #include <numeric>    // for accumulate
 #include <tuple>      // for make_tuple, tuple_element<>::type
 #include <utility>    // for tuple_element<>::type
+#include <vector>     // for vector
 
 #include <cassert> // for assert
 
 namespace signal_tl::minmax {
 using namespace signal;
 
-template <typename Compare>
-SignalPtr compute_minmax_pair(
-    const SignalPtr& input_x,
-    const SignalPtr& input_y,
+namespace {
+
+template <typename T, typename V>
+bool is_step(const SignalPtr<T, V>& x) {
+  return x->interpolation() == Interpolation::Step;
+}
+
+/**
+ * Get the time points `t` at which the window `[t + a, t + b]` starts or stops
+ * overlapping with some sample of `x`, i.e., the (sorted) time points `t_i - b` and
+ * `t_i - a`, restricted to the domain of the signal.
+ *
+ * The first and the last time points are the start and the end of the signal.
+ */
+template <typename T, typename V>
+std::vector<T> window_event_times(const SignalPtr<T, V>& x, T a, T b) {
+  const auto begin_time = x->begin_time();
+  const auto end_time   = x->end_time();
+
+  auto times = std::vector<T>{};
+  times.reserve(2 * x->size() + 2);
+  times.push_back(begin_time);
+
+  auto i = x->begin(), j = x->begin();
+  while (i != x->end() || j != x->end()) {
+    T t = 0;
+    if (j == x->end() || (i != x->end() && i->time - b <= j->time - a)) {
+      t = (i++)->time - b;
+    } else {
+      t = (j++)->time - a;
+    }
+    if (t > times.back() && t < end_time) {
+      times.push_back(t);
+    }
+  }
+  if (times.back() < end_time) {
+    times.push_back(end_time);
+  }
+  return times;
+}
+
+/**
+ * Windowed min/max for step signals.
+ *
+ * A step signal is constant on every `[t_i, t_{i+1})`, so the min/max over the window
+ * `[t + a, t + b]` only changes when `t + b` reaches a sample, or `t + a` leaves one.
+ * We generate exactly these time points and slide a monotonic wedge over the samples.
+ * No crossing points need to be computed.
+ */
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V>
+compute_step_minmax_seq(const SignalPtr<T, V>& x, T a, T b, Compare comp) {
+  const auto end_time = x->end_time();
+  const auto times    = window_event_times(x, a, b);
+
+  auto z      = std::make_shared<BasicSignal<T, V>>(Interpolation::Step);
+  auto window = std::deque<BasicSample<T, V>>{};
+  auto next   = x->begin(); // First sample not yet in the window.
+  auto first  = x->begin(); // Sample whose segment contains the start of the window.
+  for (const T t : times) {
+    // Add samples timed at or before the end of the window. The test is written as in
+    // `window_event_times`, so that a sample enters the window at its own event time.
+    for (; next != x->end() && next->time - b <= t; next++) {
+      mono_wedge::mono_wedge_update(window, *next, comp);
+    }
+    // Remove samples whose segments end at or before the start of the window.
+    while (std::next(first) != x->end() && std::next(first)->time - a <= t) { first++; }
+    while (window.size() > 1 && window.front().time < first->time) {
+      window.pop_front();
+    }
+
+    const V value = (window.empty()) ? x->back().value : window.front().value;
+    if (z->empty() || z->back().value != value) {
+      z->push_back(t, value);
+    }
+  }
+  if (z->end_time() < end_time) {
+    z->push_back(end_time, z->back().value);
+  }
+  return z;
+}
+
+} // namespace
+
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_pair(
+    const SignalPtr<T, V>& input_x,
+    const SignalPtr<T, V>& input_y,
     Compare comp,
     bool synchronized) {
-  const auto [x, y] = (synchronized) ? std::make_tuple(input_x, input_y)
-                                     : synchronize(input_x, input_y);
+  using sample_type = BasicSample<T, V>;
+
+  // Mixed step and linear signals are linearized by `synchronize`, which adds samples.
+  const bool same_interp = input_x->interpolation() == input_y->interpolation();
+  const auto [x, y]      = (synchronized && same_interp)
+                               ? std::make_tuple(input_x, input_y)
+                               : synchronize(input_x, input_y);
   assert(x->size() == y->size());
   assert(x->begin_time() == y->begin_time());
 
@@ -33,27 +124,31 @@ SignalPtr compute_minmax_pair(
   enum struct Chosen { X, Y, NONE };
   Chosen last_chosen = Chosen::NONE;
 
-  auto out = std::make_shared<Signal>();
+  // Step signals are constant between samples, so they can only cross at the
+  // (synchronized) sample points.
+  const bool step = is_step(x) && is_step(y);
+  auto out = std::make_shared<BasicSignal<T, V>>(
+      (step) ? Interpolation::Step : Interpolation::Linear);
 
   for (auto [i, j] = std::make_tuple(x->begin(), y->begin());
        i != x->end() && j != y->end();
        i++, j++) {
     if (comp(*i, *j)) {
-      if (last_chosen == Chosen::Y) {
-        double intercept_time = std::prev(j)->time_intersect(*std::prev(i));
+      if (!step && last_chosen == Chosen::Y) {
+        const T intercept_time = std::prev(j)->time_intersect(*std::prev(i));
         if (intercept_time > out->end_time() && intercept_time != i->time) {
           out->push_back(
-              Sample{intercept_time, std::prev(j)->interpolate(intercept_time)});
+              sample_type{intercept_time, std::prev(j)->interpolate(intercept_time)});
         }
       }
       out->push_back(*i);
       last_chosen = Chosen::X;
     } else {
-      if (last_chosen == Chosen::X) {
-        double intercept_time = std::prev(i)->time_intersect(*std::prev(j));
+      if (!step && last_chosen == Chosen::X) {
+        const T intercept_time = std::prev(i)->time_intersect(*std::prev(j));
         if (intercept_time > out->end_time() && intercept_time != j->time) {
           out->push_back(
-              Sample{intercept_time, std::prev(i)->interpolate(intercept_time)});
+              sample_type{intercept_time, std::prev(i)->interpolate(intercept_time)});
         }
       }
       out->push_back(*j);
@@ -64,12 +159,14 @@ SignalPtr compute_minmax_pair(
   return out;
 }
 
-template <typename Compare>
-SignalPtr
-compute_minmax_pair(const std::vector<SignalPtr>& xs, Compare comp, bool synchronized) {
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_pair(
+    const std::vector<SignalPtr<T, V>>& xs,
+    Compare comp,
+    bool synchronized) {
   if (xs.empty()) {
-    auto out = std::make_shared<Signal>();
-    out->push_back(0, -std::numeric_limits<double>::infinity());
+    auto out = std::make_shared<BasicSignal<T, V>>();
+    out->push_back(0, -std::numeric_limits<V>::infinity());
     return out;
   } else if (xs.size() == 1) {
     return xs.at(0);
@@ -78,104 +175,214 @@ compute_minmax_pair(const std::vector<SignalPtr>& xs, Compare comp, bool synchro
   }
 
   // TODO(anand): Parallel execution policy?
-  SignalPtr out = std::accumulate(
+  SignalPtr<T, V> out = std::accumulate(
       std::next(xs.cbegin()),
       xs.cend(),
       xs.at(0),
-      [&comp, &synchronized](const SignalPtr a, const SignalPtr b) {
+      [&comp, &synchronized](const SignalPtr<T, V> a, const SignalPtr<T, V> b) {
         return compute_minmax_pair(a, b, comp, synchronized);
       });
   return out;
 }
 
-template <typename Compare>
-SignalPtr compute_minmax_seq(const SignalPtr& x, Compare comp) {
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_seq(const SignalPtr<T, V>& x, Compare comp) {
+  using sample_type = BasicSample<T, V>;
+
+  // The optimum over the suffix of a monotonic signal that gets worse over time is the
+  // signal itself. Otherwise, it is the global optimum up to the last sample attaining
+  // it, and only the samples after that need to be scanned.
+  const auto summary = x->summary();
+  const bool is_max  = comp(sample_type{0, 1}, sample_type{0, 0});
+  if ((is_max) ? summary.nonincreasing : summary.nondecreasing) {
+    return x;
+  }
+  const auto first = x->begin() + ((is_max) ? summary.argmax : summary.argmin);
+
   auto opt = x->back();
-  auto z   = std::vector<Sample>{};
-  z.reserve(2 * x->size());
+  auto z   = std::vector<sample_type>{};
+  z.reserve(2 * static_cast<size_t>(x->end() - first) + 1);
   z.push_back(x->back());
 
-  for (auto i = std::next(x->rbegin()); i != x->rend(); i++) {
+  for (auto i = std::next(x->rbegin()); i != std::make_reverse_iterator(first); i++) {
+    // If a linear segment starts at a new optimum, and ends strictly worse than the
+    // current optimum, it crosses the current optimum within the segment.
+    const auto& next = *std::prev(i);
+    if (!is_step(x) && comp(*i, opt) && !comp(next, opt) && i->derivative != 0) {
+      const T t = i->time + time_cast<T>((opt.value - i->value) / i->derivative);
+      if (t > i->time && t < next.time) {
+        z.push_back({t, opt.value});
+      }
+    }
     opt = (comp(*i, opt)) ? *i : opt;
     z.push_back({i->time, opt.value});
   }
+  // Before the global optimum, the output is constant.
+  if (first != x->begin()) {
+    z.push_back({x->begin_time(), opt.value});
+  }
 
   std::reverse(z.begin(), z.end());
-  return std::make_shared<Signal>(z);
+  return std::make_shared<BasicSignal<T, V>>(z, x->interpolation());
 }
 
-template <typename Compare>
-SignalPtr compute_minmax_seq(const SignalPtr& x, double a, double b, Compare comp) {
-  const auto width      = b - a;
-  const auto begin_time = x->begin_time();
-  const auto end_time   = x->end_time();
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_seq(
+    const SignalPtr<T, V>& x,
+    identity_t<T> a,
+    identity_t<T> b,
+    Compare comp) {
+  using sample_type = BasicSample<T, V>;
+  if (is_step(x)) {
+    return compute_step_minmax_seq(x, a, b, comp);
+  }
 
-  auto x_ = (a == 0)
-                ? x
-                : x->resize_shift(
-                      begin_time + width, end_time + width, x->back().value, -width);
+  const auto end_time = x->end_time();
+  const auto times    = window_event_times(x, a, b);
 
-  auto z       = std::make_shared<Signal>();
-  auto samples = std::deque<Sample>{x_->begin(), x_->end()};
-  auto window  = std::deque<Sample>{};
+  // Pick the better of two values (w.r.t. comp).
+  const auto best = [&comp](V u, V v) {
+    return (comp(sample_type{0, u}, sample_type{0, v})) ? u : v;
+  };
 
-  auto i = std::begin(samples);
-  // -- Read in values in [0, width)
-  for (; i->time < x->begin_time() + width; i++) {
-    mono_wedge::mono_wedge_update(window, *i, comp);
-  }
+  // Evaluate the signal at the time `s`, where `s` is never smaller than the previous
+  // time the cursor was used with. The signal holds its last value after it ends.
+  const auto eval = [&x, end_time](const sample_type*& cursor, T s) {
+    while (std::next(cursor) != x->end() && std::next(cursor)->time <= s) { cursor++; }
+    return (s >= end_time) ? x->back().value : cursor->interpolate(s);
+  };
+
+  auto z        = std::make_shared<BasicSignal<T, V>>();
+  auto interior = std::deque<sample_type>{};
+  auto next     = x->begin(); // First sample that hasn't entered the window.
+  auto left     = x->begin(); // Cursor for the start of the window.
+  auto right    = x->begin(); // Cursor for the end of the window.
 
-  // -- Stream in the rest of the signal.
-  for (; i != samples.end(); i++) {
-    if (i->time - a > window.front().time) {
-      // Add the sample for time M.front + a
-      i = samples.insert(
-          i,
-          Sample{
-              window.front().time + a,
-              std::prev(i)->interpolate(window.front().time + a),
-              0.0});
+  // Between two consecutive event times, the samples strictly inside the window don't
+  // change, and the values at the ends of the window are linear in `t`. The output is
+  // thus the envelope of two lines and a constant, whose breakpoints are the pairwise
+  // crossings of the three.
+  for (size_t k = 0; k + 1 < times.size(); k++) {
+    const T t0 = times[k], t1 = times[k + 1];
+    // As in the step kernel, use the same expressions as for the event times.
+    for (; next != x->end() && next->time - b <= t0; next++) {
+      mono_wedge::mono_wedge_update(interior, *next, comp);
+    }
+    while (!interior.empty() && interior.front().time - a <= t0) {
+      interior.pop_front();
+    }
+
+    const V l0 = eval(left, t0 + a), l1 = eval(left, t1 + a);
+    const V r0 = eval(right, t0 + b), r1 = eval(right, t1 + b);
+    const bool has_m = !interior.empty();
+    const V m        = (has_m) ? interior.front().value : V{0};
+
+    const auto value_at = [&](double lambda) {
+      const auto l = static_cast<V>(l0 + lambda * (l1 - l0));
+      const auto r = static_cast<V>(r0 + lambda * (r1 - r0));
+      return (has_m) ? best(best(l, r), m) : best(l, r);
+    };
+
+    auto lambdas = std::vector<double>{0.0};
+    // Add the crossing of the lines (f0, f1) and (g0, g1), if it is in (0, 1).
+    const auto add_crossing = [&lambdas](V f0, V f1, V g0, V g1) {
+      const double d0 = f0 - g0, d1 = f1 - g1;
+      if ((d0 < 0 && d1 > 0) || (d0 > 0 && d1 < 0)) {
+        lambdas.push_back(d0 / (d0 - d1));
+      }
+    };
+    add_crossing(l0, l1, r0, r1);
+    if (has_m) {
+      add_crossing(l0, l1, m, m);
+      add_crossing(r0, r1, m, m);
+    }
+    std::sort(lambdas.begin(), lambdas.end());
+
+    for (const double lambda : lambdas) {
+      const T t = t0 + time_cast<T>(lambda * static_cast<double>(t1 - t0));
+      if (z->empty() || t > z->end_time()) {
+        z->push_back(t, value_at(lambda));
+      }
     }
-    mono_wedge::mono_wedge_update(window, *i, comp);
-    while (window.front().time <= i->time - a) { window.pop_front(); }
-    z->push_back(i->time, i->value);
+  }
+
+  // At the end of the signal, the window only sees the last value of the signal.
+  if (z->empty() || z->end_time() < end_time) {
+    z->push_back(end_time, x->back().value);
   }
 
   return z->simplify();
 }
 
-SignalPtr
-compute_elementwise_min(const SignalPtr& x, const SignalPtr& y, bool synchronized) {
+template <typename T, typename V>
+SignalPtr<T, V> compute_elementwise_min(
+    const SignalPtr<T, V>& x,
+    const SignalPtr<T, V>& y,
+    bool synchronized) {
   return compute_minmax_pair(x, y, std::less_equal<>(), synchronized);
 }
 
-SignalPtr
-compute_elementwise_max(const SignalPtr& x, const SignalPtr& y, bool synchronized) {
+template <typename T, typename V>
+SignalPtr<T, V> compute_elementwise_max(
+    const SignalPtr<T, V>& x,
+    const SignalPtr<T, V>& y,
+    bool synchronized) {
   return compute_minmax_pair(x, y, std::greater_equal<>(), synchronized);
 }
 
-SignalPtr compute_elementwise_min(const std::vector<SignalPtr>& xs, bool synchronized) {
+template <typename T, typename V>
+SignalPtr<T, V>
+compute_elementwise_min(const std::vector<SignalPtr<T, V>>& xs, bool synchronized) {
   return compute_minmax_pair(xs, std::less_equal<>(), synchronized);
 }
 
-SignalPtr compute_elementwise_max(const std::vector<SignalPtr>& xs, bool synchronized) {
+template <typename T, typename V>
+SignalPtr<T, V>
+compute_elementwise_max(const std::vector<SignalPtr<T, V>>& xs, bool synchronized) {
   return compute_minmax_pair(xs, std::greater_equal<>(), synchronized);
 }
 
-SignalPtr compute_max_seq(const SignalPtr& x) {
+template <typename T, typename V>
+SignalPtr<T, V> compute_max_seq(const SignalPtr<T, V>& x) {
   return compute_minmax_seq(x, std::greater_equal<>());
 }
 
-SignalPtr compute_min_seq(const SignalPtr& x) {
+template <typename T, typename V>
+SignalPtr<T, V> compute_min_seq(const SignalPtr<T, V>& x) {
   return compute_minmax_seq(x, std::less_equal<>());
 }
 
-SignalPtr compute_max_seq(const SignalPtr& x, double a, double b) {
+template <typename T, typename V>
+SignalPtr<T, V>
+compute_max_seq(const SignalPtr<T, V>& x, identity_t<T> a, identity_t<T> b) {
   return compute_minmax_seq(x, a, b, std::greater_equal<>());
 }
 
-SignalPtr compute_min_seq(const SignalPtr& x, double a, double b) {
+template <typename T, typename V>
+SignalPtr<T, V>
+compute_min_seq(const SignalPtr<T, V>& x, identity_t<T> a, identity_t<T> b) {
   return compute_minmax_seq(x, a, b, std::less_equal<>());
 }
 
+#define SIGNALTL_INSTANTIATE_MINMAX(T, V)                                 \
+  template SignalPtr<T, V> compute_elementwise_min(                       \
+      const SignalPtr<T, V>&, const SignalPtr<T, V>&, bool);              \
+  template SignalPtr<T, V> compute_elementwise_max(                       \
+      const SignalPtr<T, V>&, const SignalPtr<T, V>&, bool);              \
+  template SignalPtr<T, V> compute_elementwise_min(                       \
+      const std::vector<SignalPtr<T, V>>&, bool);                         \
+  template SignalPtr<T, V> compute_elementwise_max(                       \
+      const std::vector<SignalPtr<T, V>>&, bool);                         \
+  template SignalPtr<T, V> compute_max_seq(const SignalPtr<T, V>&);       \
+  template SignalPtr<T, V> compute_min_seq(const SignalPtr<T, V>&);       \
+  template SignalPtr<T, V> compute_max_seq(const SignalPtr<T, V>&, T, T); \
+  template SignalPtr<T, V> compute_min_seq(const SignalPtr<T, V>&, T, T);
+
+SIGNALTL_INSTANTIATE_MINMAX(double, double)
+SIGNALTL_INSTANTIATE_MINMAX(double, float)
+SIGNALTL_INSTANTIATE_MINMAX(std::int64_t, double)
+SIGNALTL_INSTANTIATE_MINMAX(std::int64_t, float)
+
+#undef SIGNALTL_INSTANTIATE_MINMAX
+
 } // namespace signal_tl::minmax
@@ -5,67 +5,96 @@
 
 #include <vector>
 
+/**
+ * The min/max kernels are templated on the time type `T` and the value type `V` of the
+ * signals, and are instantiated (in minmax.cc) for the same combinations as
+ * `signal::BasicSignal`.
+ */
 namespace signal_tl::minmax {
 
+template <typename T, typename V>
+using SignalPtr = signal::BasicSignalPtr<T, V>;
+
+/// Used to keep the time arguments of the kernels out of template argument deduction.
+template <typename T>
+struct identity {
+  using type = T;
+};
+template <typename T>
+using identity_t = typename identity<T>::type;
+
 /**
  * Compute the element-wise minimum/maximum (depending on value of Compare) between
  * two signals.
  */
-template <typename Compare>
-signal::SignalPtr compute_minmax_pair(
-    const signal::SignalPtr& input_x,
-    const signal::SignalPtr& input_y,
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_pair(
+    const SignalPtr<T, V>& input_x,
+    const SignalPtr<T, V>& input_y,
     Compare comp,
     bool synchronized = false);
 
-signal::SignalPtr compute_elementwise_min(
-    const signal::SignalPtr& x,
-    const signal::SignalPtr& y,
+template <typename T, typename V>
+SignalPtr<T, V> compute_elementwise_min(
+    const SignalPtr<T, V>& x,
+    const SignalPtr<T, V>& y,
     bool synchronized = false);
 
-signal::SignalPtr compute_elementwise_max(
-    const signal::SignalPtr& x,
-    const signal::SignalPtr& y,
+template <typename T, typename V>
+SignalPtr<T, V> compute_elementwise_max(
+    const SignalPtr<T, V>& x,
+    const SignalPtr<T, V>& y,
     bool synchronized = false);
 
 /**
  * Compute the element-wise minimum/maximum (depending on value of Compare) between
  * multiple signals.
  */
-template <typename Compare>
-signal::SignalPtr compute_minmax_pair(
-    const std::vector<signal::SignalPtr>& xs,
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_pair(
+    const std::vector<SignalPtr<T, V>>& xs,
     Compare comp,
     bool synchronized = false);
 
-signal::SignalPtr compute_elementwise_min(
-    const std::vector<signal::SignalPtr>& xs,
+template <typename T, typename V>
+SignalPtr<T, V> compute_elementwise_min(
+    const std::vector<SignalPtr<T, V>>& xs,
     bool synchronized = false);
 
-signal::SignalPtr compute_elementwise_max(
-    const std::vector<signal::SignalPtr>& xs,
+template <typename T, typename V>
+SignalPtr<T, V> compute_elementwise_max(
+    const std::vector<SignalPtr<T, V>>& xs,
     bool synchronized = false);
 
 /**
  * Compute the rolling min/max of a signal, i.e., at time t, the min/max value is the
  * sample with min/max value in the window [t, t + inf).
  */
-template <typename Compare>
-signal::SignalPtr compute_minmax_seq(const signal::SignalPtr& x, Compare comp);
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_seq(const SignalPtr<T, V>& x, Compare comp);
 
-signal::SignalPtr compute_max_seq(const signal::SignalPtr& x);
-signal::SignalPtr compute_min_seq(const signal::SignalPtr& x);
+template <typename T, typename V>
+SignalPtr<T, V> compute_max_seq(const SignalPtr<T, V>& x);
+template <typename T, typename V>
+SignalPtr<T, V> compute_min_seq(const SignalPtr<T, V>& x);
 
 /**
  * Compute the windowed min/max of a signal, i.e., at time t, the min/max value is the
  * sample with min/max value in the window [t + a, t + b].
  */
-template <typename Compare>
-signal::SignalPtr
-compute_minmax_seq(const signal::SignalPtr& x, double a, double b, Compare comp);
+template <typename T, typename V, typename Compare>
+SignalPtr<T, V> compute_minmax_seq(
+    const SignalPtr<T, V>& x,
+    identity_t<T> a,
+    identity_t<T> b,
+    Compare comp);
 
-signal::SignalPtr compute_max_seq(const signal::SignalPtr& x, double a, double b);
-signal::SignalPtr compute_min_seq(const signal::SignalPtr& x, double a, double b);
+template <typename T, typename V>
+SignalPtr<T, V>
+compute_max_seq(const SignalPtr<T, V>& x, identity_t<T> a, identity_t<T> b);
+template <typename T, typename V>
+SignalPtr<T, V>
+compute_min_seq(const SignalPtr<T, V>& x, identity_t<T> a, identity_t<T> b);
 
 } // namespace signal_tl::minmax
 
@@ -0,0 +1,345 @@
+#include "signal_tl/online.hpp"
+#include "signal_tl/ast.hpp"
+
+#include "signal_tl/internal/utils.hpp"
+
+#include "past.hpp"
+
+#include <algorithm>    // for min, max
+#include <cmath>        // for isinf
+#include <cstdint>      // for int64_t
+#include <fmt/format.h> // for format
+#include <limits>       // for numeric_limits
+#include <map>          // for map
+#include <optional>     // for optional
+#include <set>          // for set
+#include <stdexcept>    // for invalid_argument, out_of_range
+#include <string>       // for string
+#include <utility>      // for move
+#include <variant>      // for visit
+#include <vector>       // for vector
+
+namespace signal_tl::semantics {
+using namespace signal;
+
+template <typename T, typename V>
+struct BasicOnlineMonitor<T, V>::Node {
+  enum class Kind { Const, Predicate, Not, And, Or, Historically, Once, Since };
+
+  Kind kind = Kind::Const;
+  /// The value of a constant, or the threshold of a predicate.
+  V value = 0;
+  /// Whether a predicate is a lower bound on its signal.
+  bool lower = true;
+  /// The index of the signal of a predicate.
+  size_t signal = 0;
+  /// The indices of the operands.
+  std::vector<size_t> args = {};
+  /// The state of a temporal operator.
+  std::optional<past::SinceWindow<T, V>> window = std::nullopt;
+};
+
+template <typename T, typename V>
+BasicOnlineMonitor<T, V>::BasicOnlineMonitor(const ast::Expr& phi) {
+  const auto psi = (ast::parameters(phi).empty()) ? phi : ast::substitute(phi, {});
+  // Number the signals in a fixed order, before the predicates refer to them.
+  auto seen          = std::set<std::string>{};
+  const auto collect = [&seen](const ast::Expr& e, const auto& self) -> void {
+    std::visit(
+        utils::overloaded{
+            [](const ast::Const&) {},
+            [&](const ast::Predicate& p) { seen.insert(p.name); },
+            [&](const ast::NotPtr& p) { self(p->arg, self); },
+            [&](const ast::AndPtr& p) {
+              for (const auto& arg : p->args) { self(arg, self); }
+            },
+            [&](const ast::OrPtr& p) {
+              for (const auto& arg : p->args) { self(arg, self); }
+            },
+            [&](const ast::HistoricallyPtr& p) { self(p->arg, self); },
+            [&](const ast::OncePtr& p) { self(p->arg, self); },
+            [&](const ast::SincePtr& p) {
+              self(p->args.first, self);
+              self(p->args.second, self);
+            },
+            [](const auto&) {
+              throw std::invalid_argument(
+                  "The online monitor only supports past-time temporal operators");
+            }},
+        e);
+  };
+  collect(psi, collect);
+  this->names = std::vector<std::string>(seen.begin(), seen.end());
+  this->inputs.resize(this->names.size());
+
+  this->compile(psi);
+  this->outputs.resize(this->nodes.size());
+}
+
+template <typename T, typename V>
+BasicOnlineMonitor<T, V>::BasicOnlineMonitor(BasicOnlineMonitor&&) noexcept = default;
+template <typename T, typename V>
+BasicOnlineMonitor<T, V>&
+BasicOnlineMonitor<T, V>::operator=(BasicOnlineMonitor&&) noexcept = default;
+template <typename T, typename V>
+BasicOnlineMonitor<T, V>::~BasicOnlineMonitor() = default;
+
+template <typename T, typename V>
+size_t BasicOnlineMonitor<T, V>::compile(const ast::Expr& phi) {
+  using Kind = typename Node::Kind;
+
+  auto node = Node{};
+  // The window of a temporal operator, in the time type of the monitor.
+  const auto window = [](const ast::Interval& interval) {
+    const auto [a, b]  = interval.as_double();
+    const bool bounded = !std::isinf(b);
+    return past::SinceWindow<T, V>{
+        time_cast<T>(a), (bounded) ? time_cast<T>(b) : T{}, bounded};
+  };
+  const auto all = [this](const std::vector<ast::Expr>& args) {
+    auto out = std::vector<size_t>{};
+    out.reserve(args.size());
+    for (const auto& arg : args) { out.push_back(this->compile(arg)); }
+    return out;
+  };
+
+  std::visit(
+      utils::overloaded{
+          [&](const ast::Const& e) {
+            node.kind  = Kind::Const;
+            node.value = (e.value) ? std::numeric_limits<V>::infinity()
+                                   : -std::numeric_limits<V>::infinity();
+          },
+          [&](const ast::Predicate& e) {
+            const auto it =
+                std::lower_bound(this->names.begin(), this->names.end(), e.name);
+            const bool lower =
+                e.op == ast::ComparisonOp::GE || e.op == ast::ComparisonOp::GT;
+            node.kind   = Kind::Predicate;
+            node.value  = static_cast<V>(e.rhs);
+            node.lower  = lower;
+            node.signal = static_cast<size_t>(it - this->names.begin());
+          },
+          [&](const ast::NotPtr& e) {
+            node.kind = Kind::Not;
+            node.args = {this->compile(e->arg)};
+          },
+          [&](const ast::AndPtr& e) {
+            node.kind = Kind::And;
+            node.args = all(e->args);
+          },
+          [&](const ast::OrPtr& e) {
+            node.kind = Kind::Or;
+            node.args = all(e->args);
+          },
+          [&](const ast::HistoricallyPtr& e) {
+            node.kind   = Kind::Historically;
+            node.args   = {this->compile(e->arg)};
+            node.window = window(e->interval);
+          },
+          [&](const ast::OncePtr& e) {
+            node.kind   = Kind::Once;
+            node.args   = {this->compile(e->arg)};
+            node.window = window(e->interval);
+          },
+          [&](const ast::SincePtr& e) {
+            node.kind   = Kind::Since;
+            node.args   = {this->compile(e->args.first), this->compile(e->args.second)};
+            node.window = window(e->interval);
+          },
+          // Future-time operators are rejected before compiling.
+          [](const auto&) {}},
+      phi);
+  this->nodes.push_back(std::move(node));
+  return this->nodes.size() - 1;
+}
+
+template <typename T, typename V>
+V BasicOnlineMonitor<T, V>::update(T time, const std::map<std::string, V>& values) {
+  for (size_t i = 0; i < this->names.size(); i++) {
+    const auto it = values.find(this->names[i]);
+    if (it == values.end()) {
+      throw std::out_of_range(
+          fmt::format("No value given for the signal {}", this->names[i]));
+    }
+    this->inputs[i] = it->second;
+  }
+  return this->update(time, this->inputs);
+}
+
+template <typename T, typename V>
+V BasicOnlineMonitor<T, V>::update(T time, const std::vector<V>& values) {
+  using Kind      = typename Node::Kind;
+  constexpr V TOP = std::numeric_limits<V>::infinity();
+
+  if (this->started && time <= this->last_time) {
+    throw std::invalid_argument(fmt::format(
+        "Trying to update the monitor at time {}, at or before its last update at {}",
+        time,
+        this->last_time));
+  } else if (values.size() != this->names.size()) {
+    throw std::out_of_range(fmt::format(
+        "Expected {} values, one for each signal, got {}",
+        this->names.size(),
+        values.size()));
+  }
+  this->started   = true;
+  this->last_time = time;
+
+  // The operands of a node come before it.
+  auto& out = this->outputs;
+  for (size_t i = 0; i < this->nodes.size(); i++) {
+    auto& node = this->nodes[i];
+    switch (node.kind) {
+      case Kind::Const:
+        out[i] = node.value;
+        break;
+      case Kind::Predicate: {
+        const V x = values[node.signal];
+        out[i]    = (node.lower) ? x - node.value : node.value - x;
+        break;
+      }
+      case Kind::Not:
+        out[i] = -out[node.args[0]];
+        break;
+      case Kind::And:
+        out[i] = TOP;
+        for (const auto arg : node.args) { out[i] = std::min(out[i], out[arg]); }
+        break;
+      case Kind::Or:
+        out[i] = -TOP;
+        for (const auto arg : node.args) { out[i] = std::max(out[i], out[arg]); }
+        break;
+      // `O psi` is `true S psi`, and `H phi` is `~O ~phi`.
+      case Kind::Historically:
+        out[i] = -node.window->update(time, TOP, -out[node.args[0]]);
+        break;
+      case Kind::Once:
+        out[i] = node.window->update(time, TOP, out[node.args[0]]);
+        break;
+      case Kind::Since:
+        out[i] = node.window->update(time, out[node.args[0]], out[node.args[1]]);
+        break;
+    }
+  }
+  return out.back();
+}
+
+template <typename T, typename V>
+BasicAsyncMonitor<T, V>::BasicAsyncMonitor(const ast::Expr& phi, T max_lateness) :
+    monitor{phi}, lateness{max_lateness} {
+  if (max_lateness < T{}) {
+    throw std::invalid_argument("The lateness of the samples cannot be negative");
+  }
+  this->channels.resize(this->monitor.signals().size());
+  this->values.resize(this->channels.size());
+}
+
+template <typename T, typename V>
+size_t BasicAsyncMonitor<T, V>::index_of(const std::string& name) const {
+  const auto& names = this->monitor.signals();
+  const auto it     = std::lower_bound(names.begin(), names.end(), name);
+  if (it == names.end() || *it != name) {
+    throw std::out_of_range(fmt::format("No channel named {} in the formula", name));
+  }
+  return static_cast<size_t>(it - names.begin());
+}
+
+template <typename T, typename V>
+bool BasicAsyncMonitor<T, V>::push(const std::string& name, T time, V value) {
+  return this->push(this->index_of(name), time, value);
+}
+
+template <typename T, typename V>
+bool BasicAsyncMonitor<T, V>::push(size_t channel, T time, V value) {
+  auto& ch = this->channels.at(channel);
+  if (this->frontier.has_value() && time <= *this->frontier) {
+    this->n_dropped++;
+    return false;
+  } else if (!ch.pending.emplace(time, value).second) {
+    this->n_dropped++;
+    return false;
+  }
+  // The watermark only moves forward, also when a late sample arrives.
+  if (time - this->lateness > ch.watermark) {
+    ch.watermark = time - this->lateness;
+  }
+  return true;
+}
+
+template <typename T, typename V>
+void BasicAsyncMonitor<T, V>::heartbeat(const std::string& name, T time) {
+  this->heartbeat(this->index_of(name), time);
+}
+
+template <typename T, typename V>
+void BasicAsyncMonitor<T, V>::heartbeat(size_t channel, T time) {
+  auto& ch     = this->channels.at(channel);
+  ch.watermark = std::max(ch.watermark, time);
+}
+
+template <typename T, typename V>
+T BasicAsyncMonitor<T, V>::watermark() const {
+  T out = std::numeric_limits<T>::max();
+  for (const auto& ch : this->channels) { out = std::min(out, ch.watermark); }
+  return out;
+}
+
+template <typename T, typename V>
+std::vector<typename BasicAsyncMonitor<T, V>::sample_type>
+BasicAsyncMonitor<T, V>::poll() {
+  return this->release(this->watermark());
+}
+
+template <typename T, typename V>
+std::vector<typename BasicAsyncMonitor<T, V>::sample_type>
+BasicAsyncMonitor<T, V>::flush() {
+  return this->release(std::numeric_limits<T>::max());
+}
+
+template <typename T, typename V>
+std::vector<typename BasicAsyncMonitor<T, V>::sample_type>
+BasicAsyncMonitor<T, V>::release(T until) {
+  auto out = std::vector<sample_type>{};
+  while (true) {
+    // The earliest pending time, merged over the channels.
+    auto next = std::optional<T>{};
+    for (const auto& ch : this->channels) {
+      if (!ch.pending.empty() && ch.pending.begin()->first <= until &&
+          (!next.has_value() || ch.pending.begin()->first < *next)) {
+        next = ch.pending.begin()->first;
+      }
+    }
+    if (!next.has_value()) {
+      break;
+    }
+
+    for (size_t i = 0; i < this->channels.size(); i++) {
+      auto& ch = this->channels[i];
+      if (ch.pending.empty() || ch.pending.begin()->first != *next) {
+        continue;
+      }
+      this->n_ready += (ch.held.has_value()) ? 0 : 1;
+      ch.held         = ch.pending.begin()->second;
+      this->values[i] = *ch.held;
+      ch.pending.erase(ch.pending.begin());
+    }
+    this->frontier = next;
+    if (this->n_ready == this->channels.size()) {
+      out.push_back(sample_type{*next, this->monitor.update(*next, this->values)});
+    }
+  }
+  return out;
+}
+
+template class BasicOnlineMonitor<double, double>;
+template class BasicOnlineMonitor<double, float>;
+template class BasicOnlineMonitor<std::int64_t, double>;
+template class BasicOnlineMonitor<std::int64_t, float>;
+
+template class BasicAsyncMonitor<double, double>;
+template class BasicAsyncMonitor<double, float>;
+template class BasicAsyncMonitor<std::int64_t, double>;
+template class BasicAsyncMonitor<std::int64_t, float>;
+
+} // namespace signal_tl::semantics
@@ -0,0 +1,102 @@
+#ifndef SIGNAL_TEMPORAL_LOGIC_PAST_HPP
+#define SIGNAL_TEMPORAL_LOGIC_PAST_HPP
+
+#include "signal_tl/signal.hpp"
+
+#include "mono_wedge.h" // for mono_wedge_update
+
+#include <algorithm>  // for min
+#include <deque>      // for deque
+#include <functional> // for less, greater
+#include <limits>     // for numeric_limits
+
+/**
+ * Incremental kernels for the past-time operators, shared by the robustness engine
+ * and the online monitor.
+ */
+namespace signal_tl::past {
+
+/**
+ * The robustness of `phi S[a, b] psi`, computed one sample at a time.
+ *
+ * The operands are taken to hold their value from one sample to the next (as step
+ * signals), so at the sample `t_k` the robustness is the max of
+ * `min(psi_j, phi_j, ..., phi_k)` over the samples `j` whose segment
+ * `[t_j, t_{j+1})` meets the window `[t_k - b, t_k - a]`. Windows that start before the
+ * first sample see the first sample, like the windows of the future-time operators
+ * see the last sample of a signal after it ends. `Once` is `true S psi`, and
+ * `Historically` is its dual.
+ *
+ * Every new value of `phi` caps all the candidates in the window, so the candidates
+ * above it collapse into one. With the monotonic wedges over the window and over `phi`,
+ * every sample is pushed to and popped from each deque at most once: an update takes
+ * O(1) amortized time, and the state holds at most the samples of the last `b` time
+ * units (a single candidate if the window is unbounded).
+ */
+template <typename T, typename V>
+class SinceWindow {
+  using sample_type = signal::BasicSample<T, V>;
+
+  /// Expiry time of the candidate of the latest sample, whose segment has not ended.
+  static constexpr T OPEN = std::numeric_limits<T>::max();
+
+  T a;
+  T b;
+  bool bounded;
+  /// Samples of `psi` that have not entered the window yet.
+  std::deque<sample_type> pending;
+  /// Min-wedge of `phi` since the first pending sample.
+  std::deque<sample_type> lhs;
+  /// Max-wedge of the candidates in the window. The time of a candidate is the end of
+  /// the segment of its sample, when it leaves the window.
+  std::deque<sample_type> window;
+  bool started = false;
+
+ public:
+  /// The window `[a, b]`, where `b` is ignored if the window is unbounded.
+  SinceWindow(T lo, T hi, bool is_bounded) : a{lo}, b{hi}, bounded{is_bounded} {}
+
+  /// Push the values of the operands at time `t`, and return the robustness at `t`.
+  V update(T t, V phi, V psi) {
+    // The segment of the latest sample ends now.
+    if (!this->window.empty() && this->window.back().time == OPEN) {
+      this->window.back().time = t;
+    }
+    // Every candidate is capped by `phi`, so the ones above it become one.
+    if (!this->window.empty() && this->window.front().value > phi) {
+      T last = this->window.front().time;
+      while (!this->window.empty() && this->window.front().value > phi) {
+        last = this->window.front().time;
+        this->window.pop_front();
+      }
+      this->window.push_front(sample_type{last, phi});
+    }
+    mono_wedge::mono_wedge_update(this->lhs, sample_type{t, phi}, std::less<>());
+    this->pending.push_back(sample_type{t, psi});
+
+    // The first sample is in every window that starts before it.
+    while (!this->pending.empty() &&
+           (!this->started || this->pending.front().time <= t - this->a)) {
+      const auto s = this->pending.front();
+      this->pending.pop_front();
+      this->started = true;
+      while (this->lhs.front().time < s.time) { this->lhs.pop_front(); }
+
+      const auto expiry = (this->pending.empty()) ? OPEN : this->pending.front().time;
+      const V value     = std::min(s.value, this->lhs.front().value);
+      // In an unbounded window, a candidate never leaves, and caps the later ones.
+      if (this->bounded || this->window.empty() || this->window.back().value < value) {
+        mono_wedge::mono_wedge_update(
+            this->window, sample_type{expiry, value}, std::greater<>());
+      }
+    }
+    if (this->bounded) {
+      while (this->window.front().time <= t - this->b) { this->window.pop_front(); }
+    }
+    return this->window.front().value;
+  }
+};
+
+} // namespace signal_tl::past
+
+#endif
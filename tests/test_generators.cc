@@ -0,0 +1,163 @@
+#include "signal_tl/fmt.hpp"        // for formatter<Expr>
+#include "signal_tl/generators.hpp" // for random_signal, random_formula, to_spec
+#include "signal_tl/signal_tl.hpp"
+
+#include "signal_tl/internal/utils.hpp" // for overloaded
+
+#include <catch2/catch.hpp> // for Approx, operator""_catch_sr, SourceLineInfo
+
+#include <algorithm> // for max
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <stdexcept> // for invalid_argument
+#include <string>    // for string
+#include <variant>   // for visit
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+namespace gen = signal_tl::generators;
+
+namespace {
+
+/// The depth of `phi`, where a predicate has depth 1.
+size_t depth(const stl::ast::Expr& phi) {
+  return std::visit(
+      stl::utils::overloaded{
+          [](const stl::ast::Const&) -> size_t { return 1; },
+          [](const stl::ast::Predicate&) -> size_t { return 1; },
+          [](const stl::ast::NotPtr& e) { return 1 + depth(e->arg); },
+          [](const stl::ast::AndPtr& e) {
+            size_t d = 0;
+            for (const auto& arg : e->args) { d = std::max(d, depth(arg)); }
+            return 1 + d;
+          },
+          [](const stl::ast::OrPtr& e) {
+            size_t d = 0;
+            for (const auto& arg : e->args) { d = std::max(d, depth(arg)); }
+            return 1 + d;
+          },
+          [](const stl::ast::UntilPtr& e) {
+            return 1 + std::max(depth(e->args.first), depth(e->args.second));
+          },
+          [](const stl::ast::SincePtr& e) {
+            return 1 + std::max(depth(e->args.first), depth(e->args.second));
+          },
+          [](const auto& e) { return 1 + depth(e->arg); }},
+      phi);
+}
+
+bool same_samples(const stl::signal::SignalPtr& x, const stl::signal::SignalPtr& y) {
+  if (x->size() != y->size()) {
+    return false;
+  }
+  for (size_t i = 0; i < x->size(); i++) {
+    const auto a = x->at_idx(i);
+    const auto b = y->at_idx(i);
+    if (a.time != b.time || a.value != b.value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("Random signals have the requested shape", "[generators][signal]") {
+  auto options      = gen::SignalOptions{};
+  options.length    = 5000;
+  options.begin     = 2.0;
+  options.period    = 0.5;
+  options.jitter    = 0.5;
+  options.crossings = 0.2;
+
+  const auto x = gen::random_signal(options, 42);
+  REQUIRE(x->size() == 5000);
+  REQUIRE(x->begin_time() == Approx(2.0).margin(0.125));
+  for (size_t i = 1; i < x->size(); i++) {
+    REQUIRE(x->at_idx(i).time > x->at_idx(i - 1).time);
+  }
+
+  SECTION("The density of the zero crossings follows the options") {
+    size_t crossings = 0;
+    for (size_t i = 1; i < x->size(); i++) {
+      if ((x->at_idx(i).value > 0) != (x->at_idx(i - 1).value > 0)) {
+        crossings++;
+      }
+    }
+    REQUIRE(crossings / 5000.0 == Approx(0.2).margin(0.03));
+  }
+
+  SECTION("The same seed gives the same signal") {
+    const auto y = gen::random_signal(options, 42);
+    const auto z = gen::random_signal(options, 43);
+    REQUIRE(same_samples(x, y));
+    REQUIRE_FALSE(same_samples(x, z));
+  }
+
+  SECTION("Options out of range are rejected") {
+    options.jitter = 1.0;
+    REQUIRE_THROWS_AS(gen::random_signal(options), std::invalid_argument);
+    options.jitter    = 0.0;
+    options.crossings = 1.5;
+    REQUIRE_THROWS_AS(gen::random_signal(options), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Random traces have independent signals", "[generators][signal]") {
+  auto options   = gen::SignalOptions{};
+  options.length = 100;
+
+  const auto trace = gen::random_trace({"x", "y", "z"}, options, 7);
+  REQUIRE(trace.size() == 3);
+  REQUIRE(trace.at("x")->size() == 100);
+  REQUIRE_FALSE(same_samples(trace.at("x"), trace.at("y")));
+  // Without jitter, the signals are sampled at the same times.
+  REQUIRE(trace.at("x")->end_time() == trace.at("z")->end_time());
+}
+
+TEST_CASE("Random formulas have the requested shape", "[generators][formula]") {
+  auto options    = gen::FormulaOptions{};
+  options.signals = {"x", "y"};
+  options.depth   = 5;
+  options.past    = true;
+
+  for (std::uint64_t seed = 0; seed < 50; seed++) {
+    const auto phi = gen::random_formula(options, seed);
+    REQUIRE(depth(phi) <= 5);
+    REQUIRE(fmt::to_string(gen::random_formula(options, seed)) == fmt::to_string(phi));
+  }
+
+  SECTION("Formulas of depth 1 are predicates") {
+    options.depth  = 1;
+    const auto phi = gen::random_formula(options, 3);
+    REQUIRE(std::holds_alternative<stl::ast::Predicate>(phi));
+  }
+
+  SECTION("Options out of range are rejected") {
+    options.fanout = 1;
+    REQUIRE_THROWS_AS(gen::random_formula(options), std::invalid_argument);
+    options.fanout  = 3;
+    options.signals = {};
+    REQUIRE_THROWS_AS(gen::random_formula(options), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Formulas are written as specifications", "[generators][spec]") {
+  const auto x = stl::Predicate("x");
+  const auto y = stl::Predicate("y");
+
+  REQUIRE(gen::to_spec(x > 0.5) == "(> x 0.5)");
+  REQUIRE(
+      gen::to_spec(stl::Always(stl::And({x > 0.5, ~(y <= 2), x < 1}))) ==
+      "(always (and (> x 0.5) (not (<= y 2)) (< x 1)))");
+  REQUIRE(
+      gen::to_spec({{"a", stl::Until(x >= 1, stl::Once(y > 0))}, {"b", x < 0}}) ==
+      "(assert a (until (>= x 1) (once (> y 0))))\n"
+      "(assert b (< x 0))\n");
+
+  SECTION("Formulas outside of the specification language are rejected") {
+    REQUIRE_THROWS_AS(
+        gen::to_spec(stl::Eventually(x > 0, {0.0, 1.0})), std::invalid_argument);
+    REQUIRE_THROWS_AS(gen::to_spec(x > -1), std::invalid_argument);
+  }
+}
@@ -0,0 +1,173 @@
+#include "signal_tl/ingest.hpp" // for IngestQueue, AsyncMonitor
+#include "signal_tl/signal_tl.hpp"
+
+#include "signal_tl/internal/spsc_ring.hpp" // for SpscRing
+
+#include <catch2/catch.hpp> // for Approx, operator""_catch_sr, SourceLineInfo
+
+#include <atomic>    // for atomic
+#include <cstddef>   // for size_t
+#include <memory>    // for make_shared, shared_ptr
+#include <stdexcept> // for invalid_argument, out_of_range
+#include <thread>    // for thread, yield
+#include <vector>    // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+
+TEST_CASE("SPSC rings hand over elements in order", "[ingest][ring]") {
+  auto ring = stl::concurrent::SpscRing<int>{5};
+  REQUIRE(ring.capacity() == 8);
+
+  auto popped        = std::vector<int>{};
+  const auto collect = [&popped](int e) { popped.push_back(e); };
+
+  // Fill the ring, wrap around it, and pop in bounded batches.
+  for (int i = 0; i < 8; i++) { REQUIRE(ring.try_push(i)); }
+  REQUIRE_FALSE(ring.try_push(8));
+  REQUIRE(ring.consume(collect, 3) == 3);
+  for (int i = 8; i < 11; i++) { REQUIRE(ring.try_push(i)); }
+  REQUIRE_FALSE(ring.try_push(11));
+  REQUIRE(ring.consume(collect) == 8);
+  REQUIRE(ring.consume(collect) == 0);
+
+  REQUIRE(popped.size() == 11);
+  for (int i = 0; i < 11; i++) { REQUIRE(popped[static_cast<size_t>(i)] == i); }
+
+  SECTION("An element that fails to be consumed is popped") {
+    REQUIRE(ring.try_push(1));
+    REQUIRE(ring.try_push(2));
+    REQUIRE_THROWS_AS(
+        ring.consume([](int) { throw std::invalid_argument("bad element"); }),
+        std::invalid_argument);
+    REQUIRE(ring.consume(collect) == 1);
+    REQUIRE(popped.back() == 2);
+  }
+}
+
+TEST_CASE("Consuming returns while producers keep pushing", "[ingest]") {
+  auto queue = stl::IngestQueue{2, 64};
+  for (size_t i = 0; i < 10; i++) {
+    REQUIRE(queue.push(0, 0, static_cast<double>(i), 0));
+  }
+
+  // The producers push as fast as they can, so the rings are never empty for long.
+  auto stop      = std::atomic<bool>{false};
+  auto producers = std::vector<std::thread>{};
+  for (size_t p = 0; p < 2; p++) {
+    producers.emplace_back([&, p]() {
+      size_t i = (p == 0) ? 10 : 0;
+      while (!stop) {
+        if (queue.push(p, p, static_cast<double>(i), 0)) {
+          i++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  auto next     = std::vector<double>{0, 0};
+  auto in_order = true;
+  const auto fn = [&](const stl::IngestQueue::Record& r) {
+    in_order = in_order && (r.time == next[r.channel]);
+    next[r.channel] += 1;
+    std::this_thread::yield();
+  };
+  const size_t first = queue.consume(fn, 8);
+  REQUIRE(first >= 10);
+  REQUIRE(first <= 2 * 64);
+  for (size_t call = 0; call < 100; call++) { REQUIRE(queue.consume(fn, 8) <= 2 * 64); }
+
+  stop = true;
+  for (auto& th : producers) { th.join(); }
+  queue.consume(fn, 8);
+  REQUIRE(queue.consume(fn, 8) == 0);
+  REQUIRE(in_order);
+}
+
+TEST_CASE("Ingestion queues batch samples from many threads", "[ingest]") {
+  constexpr size_t n_producers = 4;
+  constexpr size_t n_samples   = 20000;
+
+  SECTION("Each producer fills its own signal while the consumer drains") {
+    auto queue   = stl::IngestQueue{n_producers, 256};
+    auto signals = std::vector<std::shared_ptr<Signal>>{};
+    for (size_t i = 0; i < n_producers; i++) {
+      signals.push_back(std::make_shared<Signal>());
+    }
+
+    auto done      = std::atomic<size_t>{0};
+    auto producers = std::vector<std::thread>{};
+    for (size_t p = 0; p < n_producers; p++) {
+      producers.emplace_back([&, p]() {
+        for (size_t i = 0; i < n_samples; i++) {
+          const double t = static_cast<double>(i);
+          while (!queue.push(p, p, t, t * static_cast<double>(p))) {
+            std::this_thread::yield();
+          }
+        }
+        done++;
+      });
+    }
+    while (done < n_producers) { queue.drain(signals); }
+    for (auto& th : producers) { th.join(); }
+    queue.drain(signals);
+
+    for (size_t p = 0; p < n_producers; p++) {
+      const auto& x = signals[p];
+      REQUIRE(x->size() == n_samples);
+      for (size_t i = 0; i < n_samples; i += 997) {
+        REQUIRE(x->at_idx(i).time == static_cast<double>(i));
+        REQUIRE(x->at_idx(i).value == static_cast<double>(i * p));
+      }
+    }
+  }
+
+  SECTION("Monitors see the samples of every producer") {
+    const auto x     = stl::Predicate("x");
+    const auto y     = stl::Predicate("y");
+    const auto phi   = stl::Once(x >= 0, {0.0, 5.0}) & stl::Historically(y <= 1);
+    const auto value = [](size_t channel, size_t i) {
+      return static_cast<double>((i * (channel + 3)) % 7) - 3;
+    };
+
+    // Producer `p` samples channel `p` at its own rate.
+    auto queue     = stl::IngestQueue{2, 64};
+    auto monitor   = stl::AsyncMonitor{phi};
+    auto verdicts  = std::vector<stl::AsyncMonitor::sample_type>{};
+    auto done      = std::atomic<size_t>{0};
+    auto producers = std::vector<std::thread>{};
+    for (size_t p = 0; p < 2; p++) {
+      producers.emplace_back([&, p]() {
+        for (size_t i = 0; i < n_samples; i++) {
+          const double t = static_cast<double>(i * (p + 1));
+          while (!queue.push(p, p, t, value(p, i))) { std::this_thread::yield(); }
+        }
+        done++;
+      });
+    }
+    while (done < 2) {
+      queue.drain(monitor);
+      for (const auto& s : monitor.poll()) { verdicts.push_back(s); }
+    }
+    for (auto& th : producers) { th.join(); }
+    queue.drain(monitor);
+    for (const auto& s : monitor.flush()) { verdicts.push_back(s); }
+    REQUIRE(monitor.dropped() == 0);
+
+    // The same samples, pushed from a single thread.
+    auto reference = stl::AsyncMonitor{phi};
+    for (size_t p = 0; p < 2; p++) {
+      for (size_t i = 0; i < n_samples; i++) {
+        reference.push(p, static_cast<double>(i * (p + 1)), value(p, i));
+      }
+    }
+    const auto expected = reference.flush();
+    REQUIRE(verdicts.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+      REQUIRE(verdicts[i].time == expected[i].time);
+      REQUIRE(verdicts[i].value == Approx(expected[i].value));
+    }
+  }
+}
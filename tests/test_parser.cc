@@ -1,9 +1,12 @@
+#include "signal_tl/generators.hpp"
 #include "signal_tl/internal/filesystem.hpp"
 #include "signal_tl/parser.hpp"
 
 #include <catch2/catch.hpp>
 #include <iostream>
 
+#include <cstdint>
+#include <map>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -33,6 +36,12 @@ TEST_CASE("Parsing of string input specifications", "[parser][string-input]") {
       "(define-formula phi5 (eventually phi4))\n"
       "(define-formula phi6 (always phi5))\n"
       "(assert monitor phi6)\n",
+      "; The past-time operators mirror the future-time ones.\n"
+      "(define-formula alarm (> x 10))\n"
+      "(define-formula reset (once (< x 0)))\n"
+      "(define-formula safe (historically (not alarm)))\n"
+      "(define-formula recovered (since (not alarm) reset))\n"
+      "(assert monitor (or safe recovered))\n",
   }));
 
   SECTION("Valid specifications are parsed") {
@@ -61,3 +70,25 @@ TEST_CASE("Parsing of file input specifications", "[parser][file-input]") {
     }
   }
 }
+
+TEST_CASE("Generated specifications round-trip", "[parser][generators]") {
+  namespace gen = signal_tl::generators;
+
+  auto options                = gen::FormulaOptions{};
+  options.signals             = {"x", "y", "z"};
+  options.depth               = 6;
+  options.past                = true;
+  options.bounded_probability = 0.0;
+  options.max_threshold       = 100.0;
+
+  auto assertions = std::map<std::string, signal_tl::ast::Expr>{};
+  for (std::uint64_t seed = 0; seed < 20; seed++) {
+    assertions["phi" + std::to_string(seed)] = gen::random_formula(options, seed);
+  }
+  const auto text = gen::to_spec(assertions);
+  INFO("Specification:\n" << text);
+
+  const auto spec = signal_tl::parser::from_string(text);
+  REQUIRE(spec->assertions.size() == assertions.size());
+  REQUIRE(gen::to_spec(spec->assertions) == text);
+}
@@ -0,0 +1,986 @@
+#include "signal_tl/signal_tl.hpp" // for Signal, Predicate, compute_robust...
+
+#include "minmax.hpp" // for compute_max_seq
+
+#include <catch2/catch.hpp> // for Approx, operator""_catch_sr, SourceLineInfo
+
+#include <algorithm>   // for min, max, sort, stable_sort
+#include <cmath>       // for sin, cos, round, llround
+#include <cstdint>     // for int64_t
+#include <limits>      // for numeric_limits
+#include <map>         // for map
+#include <memory>      // for make_shared, shared_ptr
+#include <optional>    // for optional
+#include <random>      // for mt19937, normal_distribution
+#include <stdexcept>   // for invalid_argument, out_of_range
+#include <string>      // for string, to_string
+#include <tuple>       // for tuple, get
+#include <type_traits> // for is_same_v
+#include <utility>     // for make_pair
+#include <vector>      // for vector
+
+namespace stl = signal_tl;
+using namespace signal_tl::signal;
+using signal_tl::ast::Expr;
+
+namespace {
+
+Trace make_trace(double phase, size_t n = 100) {
+  auto t = std::vector<double>{};
+  auto x = std::vector<double>{};
+  auto y = std::vector<double>{};
+  for (size_t i = 0; i < n; i++) {
+    const double ti = 0.5 * static_cast<double>(i);
+    t.push_back(ti);
+    x.push_back(std::sin(ti + phase));
+    y.push_back(std::cos(ti - phase));
+  }
+  return Trace{
+      {"x", std::make_shared<Signal>(x, t)}, {"y", std::make_shared<Signal>(y, t)}};
+}
+
+Expr get_phi() {
+  auto x = stl::Predicate("x") > 0;
+  auto y = stl::Predicate("y") <= 0.5;
+  return stl::Always(x | stl::Eventually(y, {0.0, 2.0}));
+}
+
+bool same_signal(const SignalPtr& a, const SignalPtr& b) {
+  if (a->size() != b->size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a->size(); i++) {
+    if (a->at_idx(i).time != b->at_idx(i).time ||
+        a->at_idx(i).value != b->at_idx(i).value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename V>
+V value_at_of(const BasicSignalPtr<T, V>& sig, T t) {
+  auto out = std::vector<V>(1);
+  sig->interpolate_at(&t, &t + 1, out.begin());
+  return out[0];
+}
+
+} // namespace
+
+TEST_CASE("Batch robustness matches sequential evaluation", "[robustness][batch]") {
+  const auto phi = get_phi();
+  auto traces    = std::vector<Trace>{};
+  for (size_t i = 0; i < 16; i++) {
+    traces.push_back(make_trace(0.1 * static_cast<double>(i)));
+  }
+
+  const auto n_threads = GENERATE(as<size_t>{}, 0, 1, 4);
+  const auto robs      = stl::compute_robustness_batch(phi, traces, n_threads);
+
+  REQUIRE(robs.size() == traces.size());
+  for (size_t i = 0; i < traces.size(); i++) {
+    REQUIRE(same_signal(robs[i], stl::compute_robustness(phi, traces[i])));
+  }
+}
+
+TEST_CASE("Windowed max of a linear signal", "[robustness][window][kernel]") {
+  const auto x = std::make_shared<Signal>(
+      std::vector<double>{0, 2, 0, 1, -1}, std::vector<double>{0, 1, 2, 3, 4});
+  const auto z = stl::minmax::compute_max_seq(x, 0.5, 1.5);
+
+  for (double t = 0; t <= 4; t += 0.125) {
+    // The max over [t + 0.5, t + 1.5] is at an end of the window or at a sample.
+    const double l  = value_at_of(x, std::min(t + 0.5, 4.0));
+    const double r  = value_at_of(x, std::min(t + 1.5, 4.0));
+    double expected = std::max(l, r);
+    for (const auto& s : *x) {
+      if (s.time > t + 0.5 && s.time < t + 1.5) {
+        expected = std::max(expected, s.value);
+      }
+    }
+    INFO("t = " << t);
+    REQUIRE(value_at_of(z, t) == Approx(expected));
+  }
+}
+
+TEST_CASE("Windows admit samples at decimal times", "[robustness][window][kernel]") {
+  // Sampled every 0.1, with a spike of 5 at t = 0.7 (or 1.4). Neither the sample times
+  // nor `t_i - a` and `t_i - b` are exact in binary.
+  const auto spike = [](size_t n, size_t at, Interpolation interp) {
+    auto values = std::vector<double>(n, 0.0);
+    auto times  = std::vector<double>(n);
+    for (size_t k = 0; k < n; k++) { times[k] = 0.1 * static_cast<double>(k); }
+    values[at] = 5;
+    return std::make_shared<Signal>(values, times, interp);
+  };
+
+  SECTION("Step signals") {
+    const auto x   = spike(20, 7, Interpolation::Step);
+    const auto phi = stl::Eventually(stl::Predicate("x") > 0, {0.0, 0.2});
+    const auto rob = stl::compute_robustness(phi, Trace{{"x", x}});
+    // The window [t, t + 0.2] sees the spike from t = 0.5 until it ends at t = 0.8.
+    for (double t = 0.025; t < 1.9; t += 0.05) {
+      INFO("t = " << t);
+      REQUIRE(value_at_of(rob, t) == ((t > 0.5 && t < 0.8) ? 5.0 : 0.0));
+    }
+  }
+
+  SECTION("Linear signals") {
+    const auto x = spike(30, 14, Interpolation::Linear);
+    const auto z = stl::minmax::compute_max_seq(x, 0.3, 0.4);
+    for (double t = 0.01; t < 2.9; t += 0.05) {
+      // The max over [t + 0.3, t + 0.4] is at an end of the window or at a sample.
+      const double l  = value_at_of(x, std::min(t + 0.3, 2.9));
+      const double r  = value_at_of(x, std::min(t + 0.4, 2.9));
+      double expected = std::max(l, r);
+      if (t + 0.3 < 1.4 && t + 0.4 > 1.4) {
+        expected = 5;
+      }
+      INFO("t = " << t);
+      REQUIRE(value_at_of(z, t) == Approx(expected).margin(1e-9));
+    }
+  }
+}
+
+TEST_CASE("Unbounded operators cross the running optimum", "[robustness][unbounded]") {
+  const auto x = std::make_shared<Signal>(
+      std::vector<double>{0, 2, 0, 1}, std::vector<double>{0, 1, 2, 3});
+  const auto trace = Trace{{"x", x}};
+  const auto phi   = stl::Eventually(stl::Predicate("x") >= 0);
+  const auto rob   = stl::compute_robustness(phi, trace);
+
+  // On [1, 2], `x` falls from 2 to 0 and crosses the later maximum, 1, at t = 1.5.
+  for (double t = 0; t <= 3; t += 0.25) {
+    const double expected = (t <= 1) ? 2 : std::max(1.0, 2 - 2 * (t - 1));
+    INFO("t = " << t);
+    REQUIRE(value_at_of(rob, t) == Approx(expected));
+  }
+}
+
+TEST_CASE("Bounded operators only see their interval", "[robustness][interval]") {
+  const auto x = std::make_shared<Signal>(
+      std::vector<double>{9, 0, 0, 0, 5}, std::vector<double>{0, 1, 2, 3, 4});
+  const auto trace = Trace{{"x", x}};
+  const auto p     = stl::Predicate("x") >= 0;
+
+  // Only the samples at t = 0 and t = 4 are positive.
+  const auto rob1 = stl::compute_robustness(stl::Eventually(p, {1.0, 2.0}), trace);
+  REQUIRE(value_at_of(rob1, 0.0) == Approx(0.0));
+  // The window [0.5, 4.5] is as wide as the signal, but doesn't start at 0.
+  const auto rob2 = stl::compute_robustness(stl::Eventually(p, {0.5, 4.5}), trace);
+  REQUIRE(value_at_of(rob2, 0.0) == Approx(5.0));
+}
+
+TEST_CASE("Step signals are evaluated without interpolation", "[robustness][step]") {
+  const auto times  = std::vector<double>{0, 1, 2.5, 3, 4, 6, 7.5, 9, 10};
+  const auto values = std::vector<double>{1, 3, -1, 2, 0, 4, -2, 1, 1};
+  const auto x      = std::make_shared<Signal>(values, times, Interpolation::Step);
+  const auto trace  = Trace{{"x", x}};
+
+  // Brute force evaluation of the step signal at time `t`.
+  const auto value_at = [&](double t) {
+    size_t i = 0;
+    while (i + 1 < times.size() && times[i + 1] <= t) { i++; }
+    return values[i];
+  };
+
+  const double a = 0.5, b = 2.0;
+  const auto phi = stl::Always(stl::Predicate("x") >= 0, {a, b});
+  const auto rob = stl::compute_robustness(phi, trace);
+  REQUIRE(rob->interpolation() == Interpolation::Step);
+
+  for (double t = 0; t <= 10; t += 0.125) {
+    // The min over [t + a, t + b] is attained at t + a or at a sample in the window.
+    const double end = std::min(t + b, 10.0);
+    double expected  = value_at(std::min(t + a, 10.0));
+    for (size_t i = 0; i < times.size(); i++) {
+      if (times[i] > t + a && times[i] <= end) {
+        expected = std::min(expected, values[i]);
+      }
+    }
+    INFO("t = " << t);
+    REQUIRE(value_at_of(rob, t) == Approx(expected));
+  }
+}
+
+TEST_CASE("Step operands are linearized next to linear ones", "[robustness][step]") {
+  const auto x = std::make_shared<Signal>(
+      std::vector<double>{0, 10, 10},
+      std::vector<double>{0, 10, 20},
+      Interpolation::Step);
+  const auto y = std::make_shared<Signal>(
+      std::vector<double>{5, 5}, std::vector<double>{0, 20}, Interpolation::Linear);
+  const auto trace = Trace{{"x", x}, {"y", y}};
+  const auto p     = stl::Predicate("x") >= 0;
+  const auto q     = stl::Predicate("y") >= 0;
+
+  // The jump of `x` at t = 10 is kept, rather than interpolated over [0, 10].
+  const auto lin = x->linearize();
+  REQUIRE(lin->interpolation() == Interpolation::Linear);
+  REQUIRE(lin->size() == 4);
+  REQUIRE(value_at_of(lin, 9.5) == 0);
+
+  const auto rob_and = stl::compute_robustness(stl::And({p, q}), trace);
+  const auto rob_or  = stl::compute_robustness(stl::Or({p, q}), trace);
+  const auto rob_and_sync =
+      stl::compute_robustness(stl::And({p, q}), trace, /* synchronized */ true);
+  for (double t = 0; t <= 20; t += 0.5) {
+    INFO("t = " << t);
+    REQUIRE(value_at_of(rob_and, t) == ((t < 10) ? 0.0 : 5.0));
+    REQUIRE(value_at_of(rob_or, t) == ((t < 10) ? 5.0 : 10.0));
+    REQUIRE(value_at_of(rob_and_sync, t) == ((t < 10) ? 0.0 : 5.0));
+  }
+}
+
+TEST_CASE("Bounded temporal operators on linear signals", "[robustness][window]") {
+  const auto trace = make_trace(0.3, 40);
+  const auto& x    = trace.at("x");
+
+  // Brute force evaluation of `x` extended with its last value after it ends.
+  const auto value_at = [&](double t) { return value_at_of(x, t); };
+
+  const auto [a, b] = GENERATE(
+      std::make_pair(0.0, 2.0),
+      std::make_pair(1.0, 3.25),
+      std::make_pair(0.25, 100.0),
+      std::make_pair(0.0, 100.0));
+  const auto phi = stl::Eventually(stl::Predicate("x") >= 0, {a, b});
+  const auto rob = stl::compute_robustness(phi, trace);
+
+  for (double t = x->begin_time(); t <= x->end_time(); t += 0.05) {
+    double expected = std::max(value_at(t + a), value_at(t + b));
+    for (const auto& s : *x) {
+      if (s.time > t + a && s.time < t + b) {
+        expected = std::max(expected, s.value);
+      }
+    }
+    INFO("[a, b] = [" << a << ", " << b << "], t = " << t);
+    REQUIRE(value_at_of(rob, t) == Approx(expected).margin(1e-9));
+  }
+}
+
+TEST_CASE("Robustness over integer ticks and float values", "[robustness][types]") {
+  using TickSignal = BasicSignal<std::int64_t, float>;
+  const auto ms    = [](double t) {
+    return static_cast<std::int64_t>(std::llround(t * 1000));
+  };
+
+  // The same trace as `make_trace`, timestamped in milliseconds.
+  const auto trace = make_trace(0.3);
+  auto ticks       = BasicTrace<std::int64_t, float>{};
+  for (const auto& [name, sig] : trace) {
+    auto out = std::make_shared<TickSignal>();
+    for (const auto& s : *sig) {
+      out->push_back(ms(s.time), static_cast<float>(s.value));
+    }
+    ticks[name] = out;
+  }
+
+  const auto [a, b] = GENERATE(
+      std::make_pair(0.0, 2.0), std::make_pair(0.75, 3.0), std::make_pair(0.0, 100.0));
+  const auto phi = [](double a, double b) {
+    auto x = stl::Predicate("x") > 0;
+    auto y = stl::Predicate("y") <= 0.5;
+    return stl::Always(x | stl::Eventually(y, {a, b}));
+  };
+
+  const auto expected = stl::compute_robustness(phi(a, b), trace);
+  const auto actual   = stl::compute_robustness(phi(1000 * a, 1000 * b), ticks);
+  static_assert(
+      std::is_same_v<decltype(actual), const BasicSignalPtr<std::int64_t, float>>);
+
+  REQUIRE(actual->begin_time() == 0);
+  REQUIRE(actual->end_time() == ms(expected->end_time()));
+  for (const auto& s : *expected) {
+    REQUIRE(value_at_of(actual, ms(s.time)) == Approx(s.value).margin(1e-3));
+  }
+}
+
+TEST_CASE(
+    "Simplified robustness is within the reported error bound",
+    "[robustness][simplify]") {
+  const auto trace   = make_trace(0.2, 400);
+  const auto phi     = get_phi();
+  const auto epsilon = GENERATE(0.0, 0.01, 0.1);
+
+  auto report     = stl::RobustnessReport{};
+  auto options    = stl::RobustnessOptions{};
+  options.epsilon = epsilon;
+
+  const auto expected = stl::compute_robustness(phi, trace);
+  const auto actual   = stl::compute_robustness(phi, trace, options, &report);
+  REQUIRE(report.error_bound <= 4 * epsilon);
+  REQUIRE(actual->size() <= expected->size());
+
+  auto times = std::vector<double>{};
+  for (const auto& s : *expected) { times.push_back(s.time); }
+  for (const auto& s : *actual) { times.push_back(s.time); }
+  std::sort(times.begin(), times.end());
+  for (const double t : times) {
+    REQUIRE(
+        std::abs(value_at_of(actual, t) - value_at_of(expected, t)) <=
+        report.error_bound + 1e-9);
+  }
+}
+
+TEST_CASE(
+    "Until and Since are simplified within the reported error bound",
+    "[robustness][simplify]") {
+  // Noisy signals, whose simplified versions cross the thresholds at other samples.
+  auto rng   = std::mt19937{5}; // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  auto noise = std::normal_distribution<double>{0.0, 0.2};
+  auto t     = std::vector<double>{};
+  auto x     = std::vector<double>{};
+  auto y     = std::vector<double>{};
+  for (size_t i = 0; i < 300; i++) {
+    t.push_back(0.1 * static_cast<double>(i));
+    x.push_back(std::sin(t.back()) + noise(rng));
+    y.push_back(std::cos(t.back()) + noise(rng));
+  }
+  const auto trace = Trace{
+      {"x", std::make_shared<Signal>(x, t)}, {"y", std::make_shared<Signal>(y, t)}};
+  const auto p = stl::Predicate("x");
+  const auto q = stl::Predicate("y");
+
+  const auto phi = GENERATE_COPY(
+      stl::Until(p > -0.5, q > 0.3),
+      stl::Until(p > -0.2, stl::Eventually(q > 0.5, {0.0, 3.0})),
+      stl::Since(p > -0.5, q > 0.3),
+      stl::Always(stl::Since(p > -0.2, stl::Once(q > 0.5, {0.0, 3.0})), {0.0, 2.0}));
+
+  auto report     = stl::RobustnessReport{};
+  auto options    = stl::RobustnessOptions{};
+  options.epsilon = 0.1;
+
+  const auto expected = stl::compute_robustness(phi, trace);
+  const auto actual   = stl::compute_robustness(phi, trace, options, &report);
+  // Only the output of Until (Since) and the operators above it are simplified.
+  REQUIRE(report.error_bound <= 2 * options.epsilon);
+
+  auto times = std::vector<double>{};
+  for (const auto& s : *expected) { times.push_back(s.time); }
+  for (const auto& s : *actual) { times.push_back(s.time); }
+  for (const double ti : times) {
+    INFO("t = " << ti);
+    REQUIRE(
+        std::abs(value_at_of(actual, ti) - value_at_of(expected, ti)) <=
+        report.error_bound + 1e-9);
+  }
+}
+
+TEST_CASE(
+    "Large conjunctions are folded into a running envelope",
+    "[robustness][memory]") {
+  const size_t n_samples = 500;
+  auto trace             = Trace{};
+  auto args              = std::vector<Expr>{};
+  for (size_t i = 0; i < 64; i++) {
+    const auto name = "x" + std::to_string(i);
+    trace[name]     = make_trace(0.1 * static_cast<double>(i), n_samples).at("x");
+    args.push_back(stl::Predicate(name) > 0.01 * static_cast<double>(i));
+  }
+  const auto conj = Expr{std::make_shared<stl::ast::And>(args)};
+  const auto phi  = stl::Always(conj | stl::Eventually(args.front(), {0.0, 2.0}));
+
+  auto report = stl::RobustnessReport{};
+  const auto rob =
+      stl::compute_robustness(phi, trace, stl::RobustnessOptions{}, &report);
+  REQUIRE(rob->size() > 0);
+  REQUIRE(report.peak_memory > 0);
+
+  // The conjunction is the minimum over the robustness of its conjuncts, but they
+  // should never be live all at once.
+  const auto actual = stl::compute_robustness(conj, trace);
+  auto ys           = std::vector<SignalPtr>{};
+  size_t all_live   = 0;
+  for (const auto& arg : args) {
+    ys.push_back(stl::compute_robustness(arg, trace));
+    all_live += ys.back()->size() * sizeof(Sample);
+  }
+  REQUIRE(report.peak_memory < all_live / 2);
+  for (const auto& s : *ys.front()) {
+    double expected = value_at_of(ys.front(), s.time);
+    for (const auto& y : ys) { expected = std::min(expected, value_at_of(y, s.time)); }
+    REQUIRE(value_at_of(actual, s.time) == Approx(expected));
+  }
+}
+
+TEST_CASE(
+    "Robustness is only computed over the query interval",
+    "[robustness][query]") {
+  const auto trace = make_trace(0.3, 20000);
+  const auto x     = stl::Predicate("x") > 0;
+  const auto y     = stl::Predicate("y") <= 0.5;
+  const auto psi   = stl::Always(stl::Not(y), {0.5, 2.0});
+  const auto phi =
+      stl::Always((x & stl::Eventually(y, {1.0, 3.0})) | psi, {0.0, 4.0});
+  const auto expected = stl::compute_robustness(phi, trace);
+
+  auto full_report = stl::RobustnessReport{};
+  stl::compute_robustness(phi, trace, stl::RobustnessOptions{}, &full_report);
+
+  const double begin = GENERATE(0.0, 17.25, 500.0);
+  const double width = GENERATE(0.0, 10.0);
+  auto options        = stl::RobustnessOptions{};
+  options.query_begin = begin;
+  options.query_end   = begin + width;
+  auto report         = stl::RobustnessReport{};
+  const auto actual   = stl::compute_robustness(phi, trace, options, &report);
+
+  REQUIRE(actual->begin_time() == begin);
+  REQUIRE(actual->end_time() == begin + width);
+  for (const auto& s : *actual) {
+    REQUIRE(s.value == Approx(value_at_of(expected, s.time)));
+  }
+  // The cost depends on the horizon of the formula, not the length of the trace.
+  REQUIRE(report.peak_memory * 100 < full_report.peak_memory);
+
+  options.query_end = begin - 1;
+  REQUIRE_THROWS_AS(
+      stl::compute_robustness(phi, trace, options), std::invalid_argument);
+  options.query_begin = -10;
+  options.query_end   = -1;
+  REQUIRE_THROWS_AS(
+      stl::compute_robustness(phi, trace, options), std::out_of_range);
+}
+
+TEST_CASE(
+    "Formula horizons are computed from the intervals",
+    "[robustness][horizon]") {
+  const auto x = stl::Predicate("x") > 0;
+  const auto y = stl::Predicate("y") <= 0.5;
+
+  const auto bounded = stl::Always(stl::Eventually(x, {0.0, 2.0}), {0.0, 10.0});
+  REQUIRE(stl::ast::horizon(bounded).future == Approx(12.0));
+  REQUIRE(stl::ast::horizon(bounded).past == 0.0);
+  REQUIRE(stl::ast::horizon(x & y).future == 0.0);
+
+  const auto until = stl::Until(x, stl::Always(y, {1.0, 2.0}), {0.0, 3.0});
+  REQUIRE(stl::ast::horizon(until).future == Approx(5.0));
+  REQUIRE(stl::ast::horizon(until | bounded).future == Approx(12.0));
+  REQUIRE(stl::ast::horizon(until).is_bounded());
+
+  const auto unbounded = stl::Eventually(bounded);
+  REQUIRE_FALSE(stl::ast::horizon(unbounded).is_bounded());
+  REQUIRE_FALSE(stl::ast::horizon(stl::Until(x, y)).is_bounded());
+}
+
+TEST_CASE(
+    "Robustness can be computed at a single time point",
+    "[robustness][scalar]") {
+  const auto trace = make_trace(0.7, 400);
+  const auto x     = stl::Predicate("x") > 0;
+  const auto y     = stl::Predicate("y") <= 0.5;
+  const auto c     = stl::Predicate("x") < 2; // Always satisfied by at least 1.
+
+  const auto phi = GENERATE_COPY(
+      Expr{x},
+      stl::Not(y),
+      x & y,
+      (x | y) & c,
+      stl::Always(x | stl::Eventually(y, {0.0, 2.0}), {0.0, 5.0}),
+      Expr{std::make_shared<stl::ast::And>(std::vector<Expr>{
+          c, stl::Eventually(x, {1.0, 3.0}), stl::Always(y, {0.5, 4.0}), c | x})},
+      stl::Eventually(stl::Until(x, y)) | stl::Const(false));
+  const double t0 = GENERATE(0.0, 11.5, 42.0);
+
+  const auto expected = value_at_of(stl::compute_robustness(phi, trace), t0);
+  const auto actual   = stl::compute_robustness_at(phi, trace, t0);
+  REQUIRE(actual == Approx(expected));
+
+  const int sign = stl::compute_sign_at(phi, trace, t0);
+  REQUIRE(sign == ((expected > 0) ? 1 : ((expected < 0) ? -1 : 0)));
+
+  REQUIRE_THROWS_AS(stl::compute_robustness_at(phi, trace, -1.0), std::out_of_range);
+}
+
+TEST_CASE(
+    "Unbounded operators take the optimum over the suffix",
+    "[robustness][summary]") {
+  const auto shape = GENERATE(0, 1, 2);
+  auto sig         = std::make_shared<Signal>();
+  for (size_t i = 0; i < 200; i++) {
+    const double t = 0.25 * static_cast<double>(i);
+    const double v = (shape == 0) ? std::sin(t) : ((shape == 1) ? t : -t);
+    sig->push_back(t, v);
+  }
+  const auto trace = Trace{{"x", sig}};
+  const auto x     = stl::Predicate("x") > 0;
+
+  const auto ev = stl::compute_robustness(stl::Eventually(x), trace);
+  const auto al = stl::compute_robustness(stl::Always(x), trace);
+  for (const auto& s : *sig) {
+    double hi = s.value, lo = s.value;
+    for (auto it = sig->begin_at(s.time); it != sig->end(); it++) {
+      hi = std::max(hi, it->value);
+      lo = std::min(lo, it->value);
+    }
+    REQUIRE(value_at_of(ev, s.time) == Approx(hi));
+    REQUIRE(value_at_of(al, s.time) == Approx(lo));
+  }
+}
+
+TEST_CASE(
+    "Windows over predicates are answered by range indices",
+    "[robustness][scalar][range_index]") {
+  const auto trace = make_trace(0.2, 1000);
+  const auto x     = stl::Predicate("x") >= 0.25;
+  const auto y     = stl::Predicate("y") < -0.5;
+
+  const double a = GENERATE(0.0, 0.3, 2.0);
+  const double b = GENERATE(0.3, 7.25, 1000.0);
+  if (b <= a) {
+    return;
+  }
+  const double t0 = GENERATE(0.0, 100.0, 498.0);
+
+  const auto phi = GENERATE_COPY(
+      stl::Eventually(x, {a, b}),
+      stl::Always(y, {a, b}),
+      stl::Always(x, {a, b}) | stl::Eventually(y, {a, b}));
+  const auto expected = stl::compute_robustness_at(phi, trace, t0);
+
+  for (const auto& [name, sig] : trace) { REQUIRE(sig->range_index() != nullptr); }
+  const auto actual = stl::compute_robustness_at(phi, trace, t0);
+  REQUIRE(actual == Approx(expected));
+  REQUIRE(actual == Approx(value_at_of(stl::compute_robustness(phi, trace), t0)));
+}
+
+TEST_CASE(
+    "Parametric formulas are evaluated over a grid of parameters",
+    "[robustness][sweep]") {
+  const auto trace = make_trace(0.4, 300);
+  const auto c     = stl::ast::Parameter{"c"};
+  const auto x     = stl::Predicate("x") > c;
+  const auto y     = stl::Predicate("y") <= 0.5;
+  const auto z     = stl::Predicate("y") >= c;
+
+  const auto phi = GENERATE_COPY(
+      Expr{x},
+      stl::Always(stl::Not(x), {0.0, stl::ast::Parameter{"T"}}),
+      stl::Eventually(x, {0.0, 2.0}) & y,
+      stl::Always(x | stl::Eventually(z, {0.5, stl::ast::Parameter{"T"}})),
+      stl::Until(x, y));
+
+  auto grid = std::vector<stl::ast::ParameterValues>{};
+  for (const double ci : {-0.5, 0.0, 0.25, 0.9}) {
+    for (const double ti : {1.0, 3.5}) { grid.push_back({{"c", ci}, {"T", ti}}); }
+  }
+  auto options        = stl::RobustnessOptions{};
+  options.query_begin = GENERATE(0.0, 40.0);
+  options.query_end   = options.query_begin + 60.0;
+
+  const auto robs = stl::compute_robustness_sweep(phi, trace, grid, options);
+  REQUIRE(robs.size() == grid.size());
+  for (size_t i = 0; i < grid.size(); i++) {
+    const auto psi = stl::ast::substitute(phi, grid[i]);
+    REQUIRE(stl::ast::parameters(psi).empty());
+    const auto expected = stl::compute_robustness(psi, trace, options);
+    REQUIRE(robs[i]->begin_time() == expected->begin_time());
+    REQUIRE(robs[i]->end_time() == expected->end_time());
+    for (const auto& s : *expected) {
+      REQUIRE(value_at_of(robs[i], s.time) == Approx(s.value).margin(1e-9));
+    }
+  }
+
+  grid.push_back({{"c", 0.0}, {"T", -1.0}});
+  if (stl::ast::parameters(phi).count("T") != 0) {
+    REQUIRE_THROWS_AS(
+        stl::compute_robustness_sweep(phi, trace, grid, options),
+        std::invalid_argument);
+  }
+}
+
+TEST_CASE("Tightest parameter values are mined from traces", "[robustness][mining]") {
+  const auto trace = make_trace(0.3, 200);
+  const auto c     = stl::ast::Parameter{"c"};
+  const auto b     = stl::ast::Parameter{"b"};
+  const auto x     = stl::Predicate("x");
+  const auto y     = stl::Predicate("y");
+
+  const auto max_over = [&](const std::string& name, double lo, double hi) {
+    double out = -std::numeric_limits<double>::infinity();
+    for (const auto& s : *trace.at(name)) {
+      if (s.time >= lo && s.time <= hi) {
+        out = std::max(out, s.value);
+      }
+    }
+    return out;
+  };
+
+  SECTION("Thresholds under temporal operators have a closed form") {
+    const auto phi = stl::Always(x < c, {0.0, 10.0});
+    REQUIRE(stl::monotonicity(phi, "c") == 1);
+    const auto out = stl::mine_parameter(phi, "c", trace);
+    REQUIRE(out.has_value());
+    REQUIRE(*out == Approx(max_over("x", 0.0, 10.0)));
+
+    auto options  = stl::MiningOptions{};
+    options.upper = max_over("x", 0.0, 10.0) - 0.1;
+    REQUIRE_FALSE(stl::mine_parameter(phi, "c", trace, options).has_value());
+  }
+
+  SECTION("Other parameters are bisected") {
+    auto options      = stl::MiningOptions{};
+    options.tolerance = 1e-4;
+
+    const auto psi =
+        stl::Always((x < c) & stl::Eventually(y < c, {0.0, 2.0}), {0.0, 5.0});
+    REQUIRE(stl::monotonicity(psi, "c") == 1);
+    const auto c_out = stl::mine_parameter(psi, "c", trace, options);
+    REQUIRE(c_out.has_value());
+    const auto at = [&](const Expr& phi, const std::string& name, double value) {
+      const auto bound = stl::ast::substitute(phi, {{name, value}});
+      return stl::compute_robustness_at(bound, trace, 0.0);
+    };
+    REQUIRE(at(psi, "c", *c_out) >= 0);
+    REQUIRE(at(psi, "c", *c_out - 2 * options.tolerance) < 0);
+
+    const auto phi = stl::Eventually(x > 0.9, {0.0, b});
+    REQUIRE(stl::monotonicity(phi, "b") == 1);
+    const auto b_out = stl::mine_parameter(phi, "b", trace, options);
+    REQUIRE(b_out.has_value());
+    REQUIRE(at(phi, "b", *b_out) >= 0);
+    REQUIRE(at(phi, "b", std::max(*b_out - 2 * options.tolerance, 0.0)) < 0);
+    REQUIRE(stl::monotonicity(stl::Always(x > 0.9, {0.0, b}), "b") == -1);
+  }
+
+  SECTION("Parameters must be monotonic") {
+    REQUIRE_THROWS_AS(stl::monotonicity((x < c) & (y > c), "c"), std::invalid_argument);
+    REQUIRE_THROWS_AS(stl::mine_parameter(x < c, "b", trace), std::invalid_argument);
+  }
+
+  SECTION("Traces are mined in parallel") {
+    const auto phi = stl::Eventually(stl::Always(x > c, {0.0, 1.0}), {0.0, 4.0});
+    auto traces    = std::vector<Trace>{};
+    auto expected  = std::vector<std::optional<double>>{};
+    for (const double phase : {0.0, 0.5, 1.0, 2.0}) {
+      traces.push_back(make_trace(phase));
+      expected.push_back(stl::mine_parameter(phi, "c", traces.back()));
+    }
+    REQUIRE(stl::mine_parameter_batch(phi, "c", traces, {}, 2) == expected);
+  }
+}
+
+TEST_CASE(
+    "Satisfaction is computed as sets of intervals",
+    "[robustness][satisfaction]") {
+  const auto trace = make_trace(0.6, 300);
+  const auto x     = stl::Predicate("x") > 0.2;
+  const auto y     = stl::Predicate("y") <= -0.3;
+
+  SECTION("The satisfaction is where the robustness is non-negative") {
+    const auto phi = GENERATE_COPY(
+        Expr{x},
+        stl::Not(y),
+        x & y,
+        x | stl::Not(y),
+        stl::Eventually(x, {1.0, 2.5}),
+        stl::Always(y | x, {0.0, 3.0}),
+        stl::Always(stl::Eventually(y, {0.0, 4.0})),
+        stl::Eventually(stl::Always(x, {0.5, 1.5}) & y),
+        stl::Not(stl::Eventually(x, {10.0, 200.0})),
+        stl::Once(x, {1.0, 2.5}),
+        stl::Historically(y | x, {0.0, 3.0}),
+        stl::Historically(stl::Once(y, {0.0, 4.0})));
+
+    const auto sat = stl::compute_satisfaction(phi, trace);
+    const auto rob = stl::compute_robustness(phi, trace);
+    for (const auto& s : *rob) {
+      // The end points of the intervals are only accurate to rounding errors.
+      if (std::abs(s.value) > 1e-9) {
+        REQUIRE(sat.contains(s.time) == (s.value > 0));
+      }
+    }
+    REQUIRE(sat.size() < rob->size());
+  }
+
+  SECTION("Step signals hold the value after their last jump") {
+    // `x` jumps to a violating value at its last sample.
+    const auto xs = std::make_shared<Signal>(
+        std::vector<double>{-1, -1, 1, -1},
+        std::vector<double>{0, 5, 8, 10},
+        Interpolation::Step);
+    const auto steps = Trace{{"x", xs}};
+    const auto p     = stl::Predicate("x") > 0;
+    const auto phi   = GENERATE_COPY(
+        stl::Eventually(p, {1.0, 2.0}),
+        stl::Always(stl::Not(p), {1.0, 2.0}),
+        stl::Eventually(stl::Eventually(p, {0.0, 1.0}), {1.0, 2.0}),
+        stl::Once(p, {1.0, 2.0}),
+        stl::Historically(stl::Not(p), {0.0, 3.0}));
+
+    const auto sat = stl::compute_satisfaction(phi, steps);
+    const auto rob = stl::compute_robustness(phi, steps);
+    // Step signals take their value after a jump at the jump, so compare in between.
+    for (double t = 0.125; t < 10; t += 0.25) {
+      INFO("t = " << t);
+      REQUIRE(sat.contains(t) == (value_at_of(rob, t) >= 0));
+    }
+  }
+
+  SECTION("Until holds until the right operand holds") {
+    auto t = std::vector<double>{0.0, 10.0};
+    auto u = stl::compute_satisfaction(
+        stl::Until(stl::Predicate("x") < 5, stl::Predicate("x") > 3),
+        Trace{{"x", std::make_shared<Signal>(std::vector<double>{0.0, 10.0}, t)}});
+    // The left operand holds on [0, 5], and the right one on [3, 10].
+    REQUIRE(u == IntervalSet({{0.0, 10.0}}));
+
+    u = stl::compute_satisfaction(
+        stl::Until(stl::Predicate("x") < 5, stl::Predicate("x") > 7, {0.0, 1.0}),
+        Trace{{"x", std::make_shared<Signal>(std::vector<double>{0.0, 10.0}, t)}});
+    // The right operand never holds while the left one does.
+    REQUIRE(u == IntervalSet({{7.0, 10.0}}));
+  }
+}
+
+TEST_CASE("Past-time operators look back over the trace", "[robustness][past]") {
+  const auto times  = std::vector<double>{0, 1, 2.5, 3, 4, 6, 7.5, 9, 10, 12};
+  const auto xs     = std::vector<double>{1, 3, -1, 2, 0, 4, -2, 1, 1, 3};
+  const auto ys     = std::vector<double>{-1, 0, 2, -3, 1, 1, 0, -2, 3, 0};
+  const auto x      = std::make_shared<Signal>(xs, times, Interpolation::Step);
+  const auto y      = std::make_shared<Signal>(ys, times, Interpolation::Step);
+  const auto trace  = Trace{{"x", x}, {"y", y}};
+  const auto px     = stl::Predicate("x") >= 0;
+  const auto py     = stl::Predicate("y") >= 0;
+  const double inf  = std::numeric_limits<double>::infinity();
+
+  // Brute force evaluation of the step signal `v` at time `t`, which takes its first
+  // value before it starts.
+  const auto value_at = [&](const std::vector<double>& v, double t) {
+    size_t i = 0;
+    while (i + 1 < times.size() && times[i + 1] <= t) { i++; }
+    return v[i];
+  };
+  // Brute force evaluation of `x S[a, b] y` at `t`: the max over `s` in the window of
+  // the min of `y(s)` and of `x` over `[s, t]`.
+  const auto since = [&](double t, double a, double b) {
+    const double lo = std::max(t - b, times.front());
+    const double hi = std::max(t - a, times.front());
+    auto starts     = std::vector<double>{lo};
+    for (const double ti : times) {
+      if (ti > lo && ti <= hi) {
+        starts.push_back(ti);
+      }
+    }
+    double out = -inf;
+    for (const double s : starts) {
+      double val = std::min(value_at(ys, s), value_at(xs, s));
+      for (size_t i = 0; i < times.size(); i++) {
+        if (times[i] > s && times[i] <= t) {
+          val = std::min(val, xs[i]);
+        }
+      }
+      out = std::max(out, val);
+    }
+    return out;
+  };
+
+  SECTION("Once and Historically are windowed max and min over the past") {
+    const auto [a, b] = GENERATE_COPY(
+        std::make_pair(0.0, 2.0),
+        std::make_pair(1.0, 3.25),
+        std::make_pair(0.5, 1.0),
+        std::make_pair(0.0, inf));
+    const auto once = stl::compute_robustness(stl::Once(px, {a, b}), trace);
+    const auto hist = stl::compute_robustness(stl::Historically(px, {a, b}), trace);
+    REQUIRE(once->interpolation() == Interpolation::Step);
+
+    for (double t = 0; t <= 12; t += 0.125) {
+      // The window is `[t - b, t - a]`, clamped to the start of the trace.
+      const double lo = std::max(t - b, 0.0), hi = std::max(t - a, 0.0);
+      double max = value_at(xs, lo), min = value_at(xs, lo);
+      for (size_t i = 0; i < times.size(); i++) {
+        if (times[i] > lo && times[i] <= hi) {
+          max = std::max(max, xs[i]);
+          min = std::min(min, xs[i]);
+        }
+      }
+      INFO("[a, b] = [" << a << ", " << b << "], t = " << t);
+      REQUIRE(value_at_of(once, t) == Approx(max));
+      REQUIRE(value_at_of(hist, t) == Approx(min));
+    }
+  }
+
+  SECTION("Past windows over decimal time steps are strictly increasing in time") {
+    // Shifting the windows back by `b` rounds some of these times onto each other.
+    auto x = std::make_shared<Signal>();
+    auto y = std::make_shared<Signal>();
+    for (int i = 0; i < 50; i++) {
+      const double t = 0.1 * i;
+      x->push_back(t, std::sin(t));
+      if (i % 3 == 0) {
+        y->push_back(t, std::cos(t));
+      }
+    }
+    const auto decimal = stl::Trace{{"x", x}, {"y", y}};
+    const auto phi     = stl::Historically(stl::Predicate("x") >= -0.9, {0.0, 1.0}) |
+                     stl::Once(stl::Predicate("y") >= 0.5, {0.0, 2.0});
+    const auto rob = stl::compute_robustness(phi, decimal);
+    for (size_t i = 1; i < rob->size(); i++) {
+      REQUIRE(rob->at_idx(i - 1).time < rob->at_idx(i).time);
+    }
+  }
+
+  SECTION("Since holds while the left operand has held since the right one") {
+    const auto [a, b] = GENERATE_COPY(
+        std::make_pair(0.0, inf),
+        std::make_pair(0.0, 2.0),
+        std::make_pair(1.0, 3.5),
+        std::make_pair(2.0, inf));
+    const auto rob = stl::compute_robustness(stl::Since(px, py, {a, b}), trace);
+    for (const double t : times) {
+      INFO("[a, b] = [" << a << ", " << b << "], t = " << t);
+      REQUIRE(value_at_of(rob, t) == Approx(since(t, a, b)));
+    }
+  }
+
+  SECTION("The online monitor matches the robustness at every sample") {
+    const auto phi = GENERATE_COPY(
+        Expr{px},
+        stl::Once(px, {1.0, 3.0}),
+        stl::Historically(px | py, {0.5, 4.0}),
+        stl::Historically(stl::Once(py, {0.0, 2.0})),
+        stl::Since(px, py),
+        stl::Since(px, stl::Not(py), {1.0, 3.5}),
+        stl::Once(stl::Since(py, px, {0.0, 2.0}) & stl::Historically(px, {0.0, 1.0})));
+
+    // The subformulas only change at the samples if the trace is sampled uniformly,
+    // with a period that divides the bounds of the intervals.
+    auto grid = std::vector<double>{}, u = std::vector<double>{}, v = u;
+    for (size_t i = 0; i < 40; i++) {
+      grid.push_back(0.5 * static_cast<double>(i));
+      u.push_back(std::round(3 * std::sin(1.3 * static_cast<double>(i))));
+      v.push_back(std::round(2 * std::cos(0.7 * static_cast<double>(i))));
+    }
+    const auto uniform = Trace{
+        {"x", std::make_shared<Signal>(u, grid, Interpolation::Step)},
+        {"y", std::make_shared<Signal>(v, grid, Interpolation::Step)}};
+
+    const auto rob = stl::compute_robustness(phi, uniform);
+    auto monitor   = stl::OnlineMonitor{phi};
+    for (size_t i = 0; i < grid.size(); i++) {
+      const double r = monitor.update(grid[i], {{"x", u[i]}, {"y", v[i]}});
+      INFO("t = " << grid[i]);
+      REQUIRE(r == Approx(value_at_of(rob, grid[i])));
+    }
+  }
+
+  SECTION("The online monitor rejects formulas and samples it cannot evaluate") {
+    REQUIRE_THROWS_AS(
+        stl::OnlineMonitor{stl::Once(stl::Eventually(px, {0.0, 1.0}))},
+        std::invalid_argument);
+
+    auto monitor = stl::OnlineMonitor{stl::Since(px, py, {0.0, 2.0})};
+    REQUIRE(monitor.signals() == std::vector<std::string>{"x", "y"});
+    monitor.update(0.0, {{"x", 1.0}, {"y", 1.0}});
+    REQUIRE_THROWS_AS(
+        monitor.update(0.0, {{"x", 1.0}, {"y", 1.0}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(monitor.update(1.0, {{"x", 1.0}}), std::out_of_range);
+  }
+}
+
+TEST_CASE("Asynchronous channels are aligned by their watermarks", "[online]") {
+  const auto px  = stl::Predicate("x") >= 0;
+  const auto py  = stl::Predicate("y") >= 0;
+  const auto phi = stl::Since(px, stl::Once(py, {0.0, 2.0}), {0.0, 3.0});
+
+  // `x` is sampled every second and `y` every 2.5 seconds.
+  auto samples = std::vector<std::tuple<std::string, double, double>>{};
+  for (size_t i = 0; i < 12; i++) {
+    const double t = static_cast<double>(i);
+    samples.emplace_back("x", t, std::round(2 * std::sin(1.7 * t)));
+  }
+  for (size_t i = 0; i < 5; i++) {
+    const double t = 2.5 * static_cast<double>(i);
+    samples.emplace_back("y", t, std::round(2 * std::cos(0.9 * t)));
+  }
+
+  // The synchronous reference, with every channel holding its latest value.
+  auto expected = std::vector<std::pair<double, double>>{};
+  {
+    auto in_order = samples;
+    std::sort(in_order.begin(), in_order.end(), [](const auto& l, const auto& r) {
+      return std::get<1>(l) < std::get<1>(r);
+    });
+    auto monitor = stl::OnlineMonitor{phi};
+    auto held    = std::map<std::string, double>{};
+    for (size_t i = 0; i < in_order.size(); i++) {
+      const auto& [name, t, v] = in_order[i];
+      held[name]               = v;
+      if (i + 1 < in_order.size() && std::get<1>(in_order[i + 1]) == t) {
+        continue;
+      }
+      expected.emplace_back(t, monitor.update(t, held));
+    }
+  }
+
+  SECTION("Jittered samples within the lateness give the synchronous verdicts") {
+    // Each sample is delayed by up to 1.4 seconds, within the lateness of 2 seconds.
+    const auto arrival = [](const auto& s) {
+      const double t = std::get<1>(s);
+      return t + 0.7 * static_cast<double>(std::llround(t) % 3);
+    };
+    auto arrivals = samples;
+    std::stable_sort(
+        arrivals.begin(), arrivals.end(), [&](const auto& l, const auto& r) {
+          return arrival(l) < arrival(r);
+        });
+
+    auto monitor = stl::AsyncMonitor{phi, 2.0};
+    REQUIRE(monitor.signals() == std::vector<std::string>{"x", "y"});
+    auto verdicts = std::vector<stl::AsyncMonitor::sample_type>{};
+    for (const auto& [name, t, v] : arrivals) {
+      REQUIRE(monitor.push(name, t, v));
+      for (const auto& s : monitor.poll()) {
+        // Nothing is released past the safe time.
+        REQUIRE(s.time <= monitor.watermark());
+        verdicts.push_back(s);
+      }
+    }
+    for (const auto& s : monitor.flush()) { verdicts.push_back(s); }
+
+    REQUIRE(monitor.dropped() == 0);
+    REQUIRE(verdicts.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+      REQUIRE(verdicts[i].time == expected[i].first);
+      REQUIRE(verdicts[i].value == Approx(expected[i].second));
+    }
+  }
+
+  SECTION("The slowest channel holds back the verdicts until its heartbeat") {
+    auto monitor = stl::AsyncMonitor{phi, 0.5};
+    REQUIRE(monitor.push("y", 0.0, 1.0));
+    for (size_t i = 0; i < 5; i++) {
+      REQUIRE(monitor.push("x", static_cast<double>(i), 1.0));
+    }
+    REQUIRE(monitor.watermark() == Approx(-0.5));
+    REQUIRE(monitor.poll().empty());
+
+    // `y` has not changed up to 3, so the samples of `x` up to 3 can be evaluated.
+    monitor.heartbeat("y", 3.0);
+    REQUIRE(monitor.watermark() == Approx(3.0));
+    const auto verdicts = monitor.poll();
+    REQUIRE(verdicts.size() == 4);
+    REQUIRE(verdicts.back().time == Approx(3.0));
+  }
+
+  SECTION("Samples that come too late or repeat a time are dropped") {
+    auto monitor = stl::AsyncMonitor{phi, 1.0};
+    REQUIRE(monitor.push("x", 0.0, 1.0));
+    REQUIRE(monitor.push("y", 0.0, 1.0));
+    REQUIRE(monitor.push("x", 3.0, 1.0));
+    REQUIRE(monitor.push("y", 3.0, 1.0));
+    REQUIRE(monitor.poll().size() == 1);
+
+    REQUIRE(monitor.push("x", 1.5, -1.0));
+    REQUIRE_FALSE(monitor.push("x", 3.0, -1.0));
+    REQUIRE(monitor.flush().size() == 2);
+    REQUIRE_FALSE(monitor.push("y", 2.0, -1.0));
+    REQUIRE(monitor.dropped() == 2);
+
+    REQUIRE_THROWS_AS(monitor.push("z", 4.0, 0.0), std::out_of_range);
+    REQUIRE_THROWS_AS(stl::AsyncMonitor(phi, -1.0), std::invalid_argument);
+  }
+}
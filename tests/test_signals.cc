@@ -1,10 +1,16 @@
-#include "signal_tl/signal.hpp" // for Sample, Signal, signal
+#include "signal_tl/compressed.hpp"   // for CompressedSignal
+#include "signal_tl/interval_set.hpp" // for IntervalSet
+#include "signal_tl/range_index.hpp"  // for RangeIndex
+#include "signal_tl/signal.hpp"       // for Sample, Signal, signal
 
 #include <catch2/catch.hpp> // for Approx, operator==, SourceLineInfo
 
-#include <memory> // for __shared_ptr_access, shared_ptr, all...
-#include <random> // for default_random_engine, random_device
-#include <vector> // for vector
+#include <algorithm> // for min, minmax_element
+#include <cmath>     // for sin, abs, round, sqrt
+#include <memory>    // for __shared_ptr_access, shared_ptr, all...
+#include <random>    // for default_random_engine, random_device
+#include <stdexcept> // for invalid_argument
+#include <vector>    // for vector
 
 using namespace signal_tl::signal;
 
@@ -73,3 +79,394 @@ TEST_CASE("Signals are monotonically increasing", "[signal]") {
     REQUIRE_NOTHROW(Signal{samples});
   }
 }
+
+TEST_CASE("Signals can be simplified within a tolerance", "[signal][simplify]") {
+  const auto interpolation = GENERATE(Interpolation::Linear, Interpolation::Step);
+  const double epsilon     = GENERATE(0.0, 0.05, 0.2);
+
+  // A noisy sine wave.
+  auto rng   = std::default_random_engine{42}; // NOLINT
+  auto noise = std::uniform_real_distribution<>{-0.05, 0.05};
+  auto sig   = std::make_shared<Signal>(interpolation);
+  for (size_t i = 0; i < 2000; i++) {
+    const double t = 0.01 * static_cast<double>(i);
+    sig->push_back(t, std::sin(t) + noise(rng));
+  }
+
+  const auto simple = sig->simplify(epsilon);
+  REQUIRE(simple->interpolation() == interpolation);
+  REQUIRE(simple->begin_time() == sig->begin_time());
+  REQUIRE(simple->end_time() == sig->end_time());
+  REQUIRE(simple->size() <= sig->size());
+  if (epsilon >= 0.2) {
+    REQUIRE(simple->size() < sig->size() / 10);
+  }
+
+  // Check the error on a grid that contains every sample and the midpoints between.
+  auto times = std::vector<double>{};
+  for (const auto& s : *sig) {
+    if (!times.empty()) {
+      times.push_back((times.back() + s.time) / 2);
+    }
+    times.push_back(s.time);
+  }
+  auto expected = std::vector<double>(times.size());
+  auto actual   = std::vector<double>(times.size());
+  sig->interpolate_at(times.begin(), times.end(), expected.begin());
+  simple->interpolate_at(times.begin(), times.end(), actual.begin());
+  for (size_t i = 0; i < times.size(); i++) {
+    REQUIRE(std::abs(actual[i] - expected[i]) <= epsilon + 1e-9);
+  }
+
+  REQUIRE_THROWS(sig->simplify(-1.0));
+}
+
+TEST_CASE("Signals can be stored compressed", "[signal][compressed]") {
+  const auto interpolation = GENERATE(Interpolation::Linear, Interpolation::Step);
+  const size_t block_size  = GENERATE(as<size_t>{}, 1, 7, 1024);
+
+  // A regularly sampled, quantized sensor reading, with a few irregular timestamps.
+  auto sig = std::make_shared<Signal>(interpolation);
+  for (size_t i = 0; i < 5000; i++) {
+    const double t = 0.01 * static_cast<double>(i) + ((i % 997 == 0) ? 0.003 : 0.0);
+    sig->push_back(t, std::round(100 * std::sin(0.1 * t)) / 4);
+  }
+  sig->push_back(1e6, -1e300); // NOLINT
+
+  const auto compressed = CompressedSignal{*sig, block_size};
+  REQUIRE(compressed.size() == sig->size());
+  REQUIRE(compressed.begin_time() == sig->begin_time());
+  REQUIRE(compressed.end_time() == sig->end_time());
+  if (block_size == CompressedSignal::default_block_size) {
+    REQUIRE(compressed.memory_usage() * 4 < sig->size() * sizeof(Sample));
+  }
+
+  SECTION("Decoding the blocks gives back the exact samples") {
+    size_t i = 0;
+    compressed.for_each_block([&](const std::vector<Sample>& samples) {
+      for (const auto& s : samples) {
+        const auto expected = sig->at_idx(i++);
+        REQUIRE(s.time == expected.time);
+        REQUIRE(s.value == expected.value);
+        REQUIRE(s.derivative == expected.derivative);
+      }
+    });
+    REQUIRE(i == sig->size());
+
+    const auto out = compressed.decompress();
+    REQUIRE(out->size() == sig->size());
+    REQUIRE(out->interpolation() == interpolation);
+  }
+
+  SECTION("Random access only decodes the block containing the time point") {
+    const double t = GENERATE(take(50, random(0.0, 49.99)));
+    auto expected  = 0.0;
+    sig->interpolate_at(&t, &t + 1, &expected);
+    REQUIRE(compressed.at(t).value == Approx(expected));
+
+    const auto window = compressed.decompress(t, t + 1);
+    REQUIRE(window->begin_time() <= t);
+    REQUIRE(window->end_time() >= std::min(t + 1, sig->end_time()));
+    REQUIRE_THROWS(compressed.at(-1.0));
+  }
+
+  auto appended = compressed;
+  REQUIRE_THROWS(appended.push_back(sig->end_time(), 0.0));
+}
+
+TEST_CASE("Signals can be sliced without copying", "[signal][slice]") {
+  auto sig = std::make_shared<Signal>();
+  for (size_t i = 0; i <= 100; i++) {
+    const double t = 0.5 * static_cast<double>(i);
+    sig->push_back(t, std::sin(t));
+  }
+
+  const double start = GENERATE(0.0, 3.0, 3.2, 49.9);
+  const double end   = start + GENERATE(0.0, 0.1, 7.0, 100.0);
+
+  const auto view = slice_view(sig, start, end);
+  REQUIRE((view == sig || view->borrowed_storage() != nullptr));
+  REQUIRE(view->begin() >= sig->begin());
+  REQUIRE(view->end() <= sig->end());
+  REQUIRE(view->begin_time() <= start);
+  REQUIRE(view->end_time() >= std::min(end, sig->end_time()));
+
+  const auto copy = sig->slice(start, end);
+  REQUIRE(copy->begin_time() == start);
+  REQUIRE(copy->end_time() == std::min(end, sig->end_time()));
+  for (const auto& s : *copy) {
+    auto expected = 0.0;
+    auto actual   = 0.0;
+    sig->interpolate_at(&s.time, &s.time + 1, &expected);
+    view->interpolate_at(&s.time, &s.time + 1, &actual);
+    REQUIRE(s.value == Approx(expected));
+    REQUIRE(actual == Approx(expected));
+  }
+
+  REQUIRE(slice_view(sig, -1.0, 100.0) == sig);
+}
+
+TEST_CASE("Signals can be evaluated on a sorted time grid", "[signal][interpolate]") {
+  auto sig = Signal{
+      std::vector<double>{0.0, 2.0, 1.0}, // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+      std::vector<double>{0.0, 1.0, 3.0}}; // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+  auto grid = std::vector<double>{
+      -1.0, 0.0, 0.5, 1.0, 2.0, 3.0, 4.0}; // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+  auto values = std::vector<double>(grid.size());
+  sig.interpolate_at(grid.begin(), grid.end(), values.begin());
+
+  auto expected = std::vector<double>{
+      0.0, 0.0, 1.0, 2.0, 1.5, 1.0, 1.0}; // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+  for (size_t i = 0; i < grid.size(); i++) {
+    INFO("t = " << grid[i]);
+    REQUIRE(values[i] == Approx(expected[i]));
+  }
+}
+
+TEST_CASE("Signals can borrow samples from external storage", "[signal][borrow]") {
+  const auto source = Signal{
+      std::vector<double>{1.0, 3.0, 2.0}, // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+      std::vector<double>{0.0, 1.0, 2.0}}; // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+  auto owner = std::make_shared<std::vector<Sample>>(source.begin(), source.end());
+
+  auto storage = std::shared_ptr<const Sample>(owner, owner->data());
+  auto sig     = Signal{storage, owner->size()};
+
+  REQUIRE(sig.size() == 3);
+  REQUIRE(sig.data() == owner->data());
+  REQUIRE(sig.end_time() == Approx(2.0));
+  REQUIRE(sig.at_idx(0).derivative == Approx(2.0));
+
+  SECTION("Copies share the borrowed samples") {
+    auto copy = sig; // NOLINT(performance-unnecessary-copy-initialization)
+    REQUIRE(copy.data() == owner->data());
+  }
+
+  SECTION("Modifying the signal copies the samples") {
+    sig.push_back(3.0, 0.0); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    REQUIRE(sig.size() == 4);
+    REQUIRE(sig.data() != owner->data());
+    REQUIRE(owner->size() == 3);
+    REQUIRE(sig.at_idx(2).derivative == Approx(-2.0));
+  }
+}
+
+TEST_CASE("Uniquely owned signals are modified in place", "[signal][inplace]") {
+  auto sig = std::make_shared<Signal>(
+      std::vector<double>{1.0, 3.0, 2.0}, // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+      std::vector<double>{0.0, 1.0, 2.0}); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+  const auto* data = sig->data();
+
+  SECTION("A uniquely owned signal is not copied") {
+    make_mutable(sig).affine_inplace(-1.0, 1.0);
+    REQUIRE(sig->data() == data);
+    REQUIRE(sig->at_idx(1).value == Approx(-2.0));
+    REQUIRE(sig->at_idx(0).derivative == Approx(-2.0));
+
+    make_mutable(sig).shift_inplace(1.0);
+    REQUIRE(sig->data() == data);
+    REQUIRE(sig->begin_time() == Approx(1.0));
+  }
+
+  SECTION("A shared signal is copied on write") {
+    const auto shared = sig; // NOLINT(performance-unnecessary-copy-initialization)
+    make_mutable(sig).affine_inplace(-1.0, 0.0);
+    REQUIRE(sig != shared);
+    REQUIRE(shared->data() == data);
+    REQUIRE(shared->at_idx(1).value == Approx(3.0));
+    REQUIRE(sig->at_idx(1).value == Approx(-3.0));
+  }
+
+  SECTION("Simplification compacts the samples in place") {
+    sig->push_back(3.0, 1.0); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    sig->push_back(4.0, 0.0); // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+    data = sig->data();
+
+    make_mutable(sig).simplify_inplace(0.0);
+    REQUIRE(sig->data() == data);
+    REQUIRE(sig->size() == 3);
+    REQUIRE(sig->at_idx(1).time == Approx(1.0));
+    REQUIRE(sig->at_idx(1).derivative == Approx(-1.0));
+    REQUIRE(sig->end_time() == Approx(4.0));
+  }
+}
+
+TEST_CASE("Signals can be resized to an interval", "[signal][resize]") {
+  auto sig = std::make_shared<Signal>();
+  for (size_t i = 0; i <= 100; i++) {
+    const double t = 1.0 + static_cast<double>(i);
+    sig->push_back(t, std::sin(t));
+  }
+
+  SECTION("Truncating interpolates at both ends") {
+    const auto out = sig->resize(2.5, 50.5, -10.0);
+    REQUIRE(out->begin_time() == 2.5);
+    REQUIRE(out->end_time() == 50.5);
+    REQUIRE(out->size() == 50);
+    for (const auto& s : *out) {
+      auto expected = 0.0;
+      sig->interpolate_at(&s.time, &s.time + 1, &expected);
+      REQUIRE(s.value == Approx(expected));
+    }
+  }
+
+  SECTION("Extending fills the start and holds the end") {
+    const auto out = sig->resize(0.0, 200.0, -10.0);
+    REQUIRE(out->size() == sig->size() + 2);
+    REQUIRE(out->front().value == -10.0);
+    REQUIRE(out->at_idx(1).time == sig->begin_time());
+    REQUIRE(out->back().time == 200.0);
+    REQUIRE(out->back().value == sig->back().value);
+  }
+
+  SECTION("Outside of the signal, the output is filled") {
+    const auto out = sig->resize(500.0, 600.0, -10.0);
+    REQUIRE(out->size() == 2);
+    REQUIRE(out->front().value == -10.0);
+    REQUIRE(out->back().value == -10.0);
+  }
+}
+
+TEST_CASE("Synchronized signals share their time points", "[signal][synchronize]") {
+  // Interleaved time points, with `y` starting between two samples of `x`.
+  auto x = std::make_shared<Signal>();
+  auto y = std::make_shared<Signal>();
+  for (size_t i = 0; i <= 100; i++) {
+    const double t = static_cast<double>(i);
+    x->push_back(t, std::sin(t));
+    y->push_back(t + 0.5, std::cos(t));
+  }
+
+  const auto [xs, ys] = synchronize(x, y);
+  REQUIRE(xs->size() == ys->size());
+  REQUIRE(xs->begin_time() == y->begin_time());
+  for (size_t i = 0; i < xs->size(); i++) {
+    const double t = xs->at_idx(i).time;
+    REQUIRE(ys->at_idx(i).time == t);
+
+    auto expected = 0.0;
+    x->interpolate_at(&t, &t + 1, &expected);
+    if (t <= x->end_time()) {
+      REQUIRE(xs->at_idx(i).value == Approx(expected));
+    }
+  }
+}
+
+TEST_CASE("Signals cache their summary statistics", "[signal][summary]") {
+  auto sig = std::make_shared<Signal>(
+      std::vector<double>{1.0, 3.0, 2.0, 3.0, -1.0}, // NOLINT
+      std::vector<double>{0.0, 0.5, 1.0, 1.5, 2.0}); // NOLINT
+
+  const auto summary = sig->summary();
+  REQUIRE(summary.min == -1.0);
+  REQUIRE(summary.max == 3.0);
+  REQUIRE(summary.argmin == 4);
+  REQUIRE(summary.argmax == 3);
+  REQUIRE_FALSE(summary.nondecreasing);
+  REQUIRE_FALSE(summary.nonincreasing);
+  REQUIRE(summary.uniform);
+
+  SECTION("Copies share the summary") {
+    const auto copy = *sig;
+    REQUIRE(copy.summary().max == 3.0);
+  }
+
+  SECTION("Modifying the signal invalidates the summary") {
+    sig->push_back(3.0, 10.0); // NOLINT
+    REQUIRE(sig->summary().max == 10.0);
+    REQUIRE(sig->summary().argmax == 5);
+    REQUIRE_FALSE(sig->summary().uniform);
+
+    sig->affine_inplace(-1, 0);
+    REQUIRE(sig->summary().min == -10.0);
+    REQUIRE(sig->summary().max == 1.0);
+  }
+
+  SECTION("Monotonic signals are detected") {
+    auto ramp = Signal{};
+    for (size_t i = 0; i < 10; i++) {
+      ramp.push_back(0.1 * static_cast<double>(i), std::sqrt(static_cast<double>(i)));
+    }
+    REQUIRE(ramp.summary().nondecreasing);
+    REQUIRE_FALSE(ramp.summary().nonincreasing);
+    REQUIRE(ramp.summary().uniform);
+  }
+}
+
+TEST_CASE("Range indices answer windowed min/max queries", "[signal][range_index]") {
+  const auto interpolation = GENERATE(Interpolation::Linear, Interpolation::Step);
+  auto rng                 = std::default_random_engine{7}; // NOLINT
+  auto noise               = std::uniform_real_distribution<>{-1.0, 1.0};
+  auto sig                 = std::make_shared<Signal>(interpolation);
+  for (size_t i = 0; i < 300; i++) {
+    sig->push_back(0.1 * static_cast<double>(i) + 0.05 * noise(rng), noise(rng));
+  }
+
+  REQUIRE(sig->cached_range_index() == nullptr);
+  const auto index = sig->range_index();
+  REQUIRE(sig->cached_range_index() == index);
+  REQUIRE(index->size() == sig->size());
+
+  const double start = GENERATE(take(20, random(-1.0, 31.0)));
+  const double width = GENERATE(0.0, 0.07, 1.0, 12.5, 40.0);
+  const double end   = start + width;
+
+  // Evaluate the signal on a grid with every sample in the window, and its ends.
+  auto times = std::vector<double>{start};
+  for (const auto& s : *sig) {
+    if (s.time > start && s.time < end) {
+      times.push_back(s.time);
+    }
+  }
+  times.push_back(end);
+  auto values = std::vector<double>(times.size());
+  sig->interpolate_at(times.begin(), times.end(), values.begin());
+
+  const auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+  REQUIRE(index->min(start, end) == Approx(*lo));
+  REQUIRE(index->max(start, end) == Approx(*hi));
+
+  sig->push_back(100.0, 5.0); // NOLINT
+  REQUIRE(sig->cached_range_index() == nullptr);
+  REQUIRE(sig->range_index()->max(0.0, 100.0) == 5.0);
+}
+
+TEST_CASE("Shifted signals do not reuse the range index", "[signal][range_index]") {
+  auto x = std::make_shared<Signal>(
+      std::vector<double>{0, 0, 100, 0, 0}, std::vector<double>{0, 1, 2, 3, 4});
+  REQUIRE(x->range_index()->max(1.5, 2.5) == Approx(100.0));
+
+  const auto y = x->shift(5.0);
+  REQUIRE(y->range_index()->max(6.5, 7.5) == Approx(100.0));
+  REQUIRE(y->range_index()->max(5.0, 6.0) == Approx(0.0));
+
+  x->shift_inplace(5.0);
+  REQUIRE(x->cached_range_index() == nullptr);
+  REQUIRE(x->range_index()->max(6.5, 7.5) == Approx(100.0));
+}
+
+TEST_CASE("Interval sets support set operations", "[signal][interval_set]") {
+  const auto x =
+      IntervalSet({{0.0, 1.0}, {0.5, 2.0}, {3.0, 4.0}, {4.0, 5.0}, {7.0, 7.0}});
+  const auto y = IntervalSet({{1.5, 3.5}, {6.0, 8.0}});
+
+  REQUIRE(x == IntervalSet({{0.0, 2.0}, {3.0, 5.0}, {7.0, 7.0}}));
+  REQUIRE(x.contains(4.5));
+  REQUIRE(x.contains(7.0));
+  REQUIRE_FALSE(x.contains(2.5));
+  REQUIRE(x.measure() == Approx(4.0));
+
+  REQUIRE(x.unite(y) == IntervalSet({{0.0, 5.0}, {6.0, 8.0}}));
+  REQUIRE(x.intersect(y) == IntervalSet({{1.5, 2.0}, {3.0, 3.5}, {7.0, 7.0}}));
+  REQUIRE(
+      x.complement(-1.0, 10.0) ==
+      IntervalSet({{-1.0, 0.0}, {2.0, 3.0}, {5.0, 10.0}}));
+  REQUIRE(x.clip(1.0, 3.5) == IntervalSet({{1.0, 2.0}, {3.0, 3.5}}));
+
+  // Points `t` with `[t + 1, t + 2]` meeting (or contained in) the set.
+  REQUIRE(x.minkowski_sum(-2.0, -1.0) == IntervalSet({{-2.0, 4.0}, {5.0, 6.0}}));
+  REQUIRE(x.minkowski_difference(1.0, 2.0) == IntervalSet({{-1.0, 0.0}, {2.0, 3.0}}));
+
+  REQUIRE_THROWS_AS(IntervalSet({{1.0, 0.0}}), std::invalid_argument);
+  REQUIRE_THROWS_AS(IntervalSet({{1.0, 2.0}, {0.0, 3.0}}), std::invalid_argument);
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#ifndef SIGNAL_TEMPORAL_LOGIC_MONITOR_PROTOCOL_HPP
+#define SIGNAL_TEMPORAL_LOGIC_MONITOR_PROTOCOL_HPP
+
+/// The framing spoken over the Unix socket of `stl-monitord`.
+///
+/// Every frame is a 5 byte header, the length of the payload (`uint32`) and the type
+/// of the frame (`uint8`), followed by the payload. Numbers are in the byte order of
+/// the host, as the socket is local. Strings are a `uint16` length and the bytes.
+///
+/// Clients send:
+///
+/// - `Subscribe` (no payload): stream the verdicts of every trace to this client.
+/// - `Declare` (`uint16` channel, string trace, string signal): samples on `channel`
+///   of this client are samples of the signal in the trace. A trace is shared by all
+///   the clients that declare channels in it.
+/// - `Samples` (`n` times `uint16` channel, `double` time, `double` value): samples of
+///   declared channels, in increasing time per channel.
+/// - `Sync` (`uint32` token): answered by `SyncAck` once the frames sent before it
+///   are processed.
+///
+/// The server sends:
+///
+/// - `Verdict` (string trace, string assertion, `double` time, `double` robustness,
+///   `uint8` final): the robustness of an assertion of the specification at a time. A
+///   verdict that is not final can still change as samples arrive.
+/// - `SyncAck` (`uint32` token).
+/// - `Error` (string message): the frame was rejected, and the connection is closed.
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint8_t, uint16_t, uint32_t
+#include <cstring>     // for memcpy
+#include <stdexcept>   // for runtime_error
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <vector>      // for vector
+
+#include <sys/socket.h> // for send, MSG_NOSIGNAL
+
+namespace signal_tl::monitor_protocol {
+
+enum class FrameType : std::uint8_t {
+  Subscribe = 1,
+  Declare   = 2,
+  Samples   = 3,
+  Sync      = 4,
+  Verdict   = 16,
+  SyncAck   = 17,
+  Error     = 18,
+};
+
+constexpr size_t HEADER_SIZE = 5;
+/// Frames larger than this are rejected.
+constexpr size_t MAX_PAYLOAD = 1 << 24;
+
+/// Append-only encoder of a frame.
+class Writer {
+  std::vector<char> bytes;
+
+  template <typename N>
+  void put(N n) {
+    const auto size = this->bytes.size();
+    this->bytes.resize(size + sizeof(N));
+    std::memcpy(this->bytes.data() + size, &n, sizeof(N));
+  }
+
+ public:
+  explicit Writer(FrameType type) : bytes(HEADER_SIZE, 0) {
+    this->bytes[4] = static_cast<char>(type);
+  }
+
+  Writer& u8(std::uint8_t n) {
+    this->put(n);
+    return *this;
+  }
+  Writer& u16(std::uint16_t n) {
+    this->put(n);
+    return *this;
+  }
+  Writer& u32(std::uint32_t n) {
+    this->put(n);
+    return *this;
+  }
+  Writer& f64(double n) {
+    this->put(n);
+    return *this;
+  }
+  Writer& str(std::string_view s) {
+    this->put(static_cast<std::uint16_t>(s.size()));
+    this->bytes.insert(this->bytes.end(), s.begin(), s.end());
+    return *this;
+  }
+
+  /// The frame, with the length of the payload filled in.
+  std::vector<char> finish() {
+    const auto length = static_cast<std::uint32_t>(this->bytes.size() - HEADER_SIZE);
+    std::memcpy(this->bytes.data(), &length, sizeof(length));
+    return this->bytes;
+  }
+};
+
+/// Decoder of the payload of a frame.
+///
+/// @throws std::runtime_error if the payload is too short.
+class Reader {
+  const char* data;
+  size_t size;
+  size_t pos = 0;
+
+  template <typename N>
+  N get() {
+    if (this->pos + sizeof(N) > this->size) {
+      throw std::runtime_error("Truncated frame");
+    }
+    N n;
+    std::memcpy(&n, this->data + this->pos, sizeof(N));
+    this->pos += sizeof(N);
+    return n;
+  }
+
+ public:
+  Reader(const char* payload, size_t length) : data{payload}, size{length} {}
+
+  [[nodiscard]] bool done() const {
+    return this->pos == this->size;
+  }
+
+  std::uint8_t u8() {
+    return this->get<std::uint8_t>();
+  }
+  std::uint16_t u16() {
+    return this->get<std::uint16_t>();
+  }
+  std::uint32_t u32() {
+    return this->get<std::uint32_t>();
+  }
+  double f64() {
+    return this->get<double>();
+  }
+  std::string str() {
+    const size_t n = this->u16();
+    if (this->pos + n > this->size) {
+      throw std::runtime_error("Truncated frame");
+    }
+    auto out = std::string(this->data + this->pos, n);
+    this->pos += n;
+    return out;
+  }
+};
+
+/// Split the complete frames off the front of `buffer`, calling `fn(type, reader)` on
+/// each, and keep the incomplete rest.
+///
+/// @throws std::runtime_error if a frame is larger than `MAX_PAYLOAD`.
+template <typename Fn>
+void for_each_frame(std::vector<char>& buffer, Fn&& fn) {
+  size_t pos = 0;
+  while (buffer.size() - pos >= HEADER_SIZE) {
+    std::uint32_t length = 0;
+    std::memcpy(&length, buffer.data() + pos, sizeof(length));
+    if (length > MAX_PAYLOAD) {
+      throw std::runtime_error("Frame too large");
+    } else if (buffer.size() - pos < HEADER_SIZE + length) {
+      break;
+    }
+    const auto type = static_cast<FrameType>(buffer[pos + 4]);
+    fn(type, Reader{buffer.data() + pos + HEADER_SIZE, length});
+    pos += HEADER_SIZE + length;
+  }
+  buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+}
+
+/// Write all of `bytes` to the socket `fd`, or return `false` if it is closed.
+inline bool send_all(int fd, const char* bytes, size_t n) {
+  while (n > 0) {
+    const auto sent = ::send(fd, bytes, n, MSG_NOSIGNAL);
+    if (sent <= 0) {
+      return false;
+    }
+    bytes += sent;
+    n -= static_cast<size_t>(sent);
+  }
+  return true;
+}
+
+} // namespace signal_tl::monitor_protocol
+
+#endif
@@ -0,0 +1,349 @@
+/// stl-eval: evaluate the assertions of a specification file over trace files.
+///
+/// Usage: stl-eval [--threads N] [--output PATH] [--epsilon E] [--at-start]
+///                 SPEC_FILE TRACE_FILE...
+///
+/// The trace files are evaluated concurrently on `N` threads (`0`, the default, uses
+/// the hardware concurrency), each thread loading one trace at a time and evaluating
+/// every assertion over it. The results are written to the output (`-`, the default,
+/// is the standard output) as each of them is computed, as CSV rows
+/// `trace,assertion,time,robustness`. With `--at-start`, only the robustness at the
+/// start of each trace is written, and it is computed with `compute_robustness_at`.
+/// `--epsilon` is passed to `RobustnessOptions::epsilon`.
+///
+/// Once every trace is evaluated, the time spent on each assertion, the estimate of the
+/// peak memory held by its intermediate signals (`RobustnessReport::peak_memory`), and
+/// the peak resident memory of the process are printed to the standard error.
+///
+/// A trace file is either a CSV file or a binary file. A CSV file has a header row,
+/// `time,x,y,...`, and a row per time step: an empty cell is a signal that has no
+/// sample at that time. A binary file, in the byte order of the host, is:
+///
+/// - the 8 bytes `STLTRACE`, and the number of signals (`uint32`);
+/// - for each signal, its name (a `uint16` length and the bytes), its number of
+///   samples (`uint64`), and its samples as pairs of `double` time and value.
+
+#include "signal_tl/fmt.hpp" // IWYU pragma: keep
+#include "signal_tl/signal_tl.hpp"
+
+#include "signal_tl/internal/parallel.hpp" // for parallel_for
+#include "signal_tl/parser.hpp"            // for from_file, Specification
+
+#include <fmt/format.h> // for print, format, memory_buffer
+
+#include <algorithm> // for max
+#include <chrono>    // for steady_clock, duration
+#include <cstdint>   // for uint16_t, uint32_t, uint64_t
+#include <cstdio>    // for FILE, fopen, fclose, fwrite, fflush
+#include <cstdlib>   // for strtod, strtoull, EXIT_FAILURE
+#include <exception> // for exception
+#include <fstream>   // for ifstream
+#include <iterator>  // for back_inserter
+#include <limits>    // for numeric_limits
+#include <map>       // for map
+#include <memory>    // for make_shared
+#include <mutex>     // for mutex, lock_guard
+#include <stdexcept> // for runtime_error, invalid_argument
+#include <string>    // for string, getline
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+#include <sys/resource.h> // for getrusage, rusage, RUSAGE_SELF
+
+namespace stl = signal_tl;
+
+namespace {
+
+struct Options {
+  size_t n_threads   = 0;
+  std::string output = "-";
+  double epsilon     = 0.0;
+  bool at_start      = false;
+  std::string spec;
+  std::vector<std::string> traces;
+};
+
+/// The accumulated cost of an assertion over the traces.
+struct Statistics {
+  size_t n_traces    = 0;
+  double seconds     = 0;
+  double max_seconds = 0;
+  size_t peak_memory = 0;
+};
+
+constexpr char MAGIC[] = "STLTRACE";
+
+template <typename N>
+N read_number(std::ifstream& in, const std::string& path) {
+  N n;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (!in.read(reinterpret_cast<char*>(&n), sizeof(N))) {
+    throw std::runtime_error(fmt::format("{}: truncated trace file", path));
+  }
+  return n;
+}
+
+stl::Trace read_binary(std::ifstream& in, const std::string& path) {
+  auto trace           = stl::Trace{};
+  const auto n_signals = read_number<std::uint32_t>(in, path);
+  for (std::uint32_t k = 0; k < n_signals; k++) {
+    auto name = std::string(read_number<std::uint16_t>(in, path), '\0');
+    if (!in.read(name.data(), static_cast<std::streamsize>(name.size()))) {
+      throw std::runtime_error(fmt::format("{}: truncated trace file", path));
+    }
+    const auto n_samples = read_number<std::uint64_t>(in, path);
+    auto x               = std::make_shared<stl::signal::Signal>();
+    x->reserve(n_samples);
+    for (std::uint64_t i = 0; i < n_samples; i++) {
+      const auto t = read_number<double>(in, path);
+      x->push_back(t, read_number<double>(in, path));
+    }
+    if (!trace.emplace(name, x).second) {
+      throw std::runtime_error(fmt::format("{}: duplicate signal '{}'", path, name));
+    }
+  }
+  return trace;
+}
+
+/// Read a line, without the `\r` of a CRLF line ending.
+bool read_line(std::istream& in, std::string& line) {
+  if (!std::getline(in, line)) {
+    return false;
+  }
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+  return true;
+}
+
+std::vector<std::string> split_row(const std::string& line) {
+  auto cells = std::vector<std::string>{};
+  for (size_t start = 0, end = 0; start <= line.size(); start = end + 1) {
+    end = std::min(line.find(',', start), line.size());
+    cells.push_back(line.substr(start, end - start));
+  }
+  return cells;
+}
+
+double parse_cell(const std::string& cell, const std::string& path, size_t row) {
+  char* end       = nullptr;
+  const double x  = std::strtod(cell.c_str(), &end);
+  const bool junk = *end != '\0' && *end != ' ';
+  if (end == cell.c_str() || junk) {
+    throw std::runtime_error(fmt::format("{}:{}: not a number: '{}'", path, row, cell));
+  }
+  return x;
+}
+
+stl::Trace read_csv(std::ifstream& in, const std::string& path) {
+  auto line = std::string{};
+  if (!read_line(in, line)) {
+    throw std::runtime_error(fmt::format("{}: empty trace file", path));
+  }
+  const auto names = split_row(line);
+  auto trace       = stl::Trace{};
+  auto signals     = std::vector<stl::signal::SignalPtr>{};
+  for (size_t k = 1; k < names.size(); k++) {
+    signals.push_back(std::make_shared<stl::signal::Signal>());
+    if (!trace.emplace(names[k], signals.back()).second) {
+      throw std::runtime_error(
+          fmt::format("{}: duplicate column '{}'", path, names[k]));
+    }
+  }
+
+  for (size_t row = 2; read_line(in, line); row++) {
+    if (line.empty()) {
+      continue;
+    }
+    const auto cells = split_row(line);
+    if (cells.size() != names.size()) {
+      throw std::runtime_error(fmt::format(
+          "{}:{}: expected {} columns, got {}", path, row, names.size(), cells.size()));
+    }
+    const double t = parse_cell(cells[0], path, row);
+    for (size_t k = 1; k < cells.size(); k++) {
+      if (!cells[k].empty()) {
+        signals[k - 1]->push_back(t, parse_cell(cells[k], path, row));
+      }
+    }
+  }
+
+  return trace;
+}
+
+/// Read a trace file, in either format.
+stl::Trace read_trace(const std::string& path) {
+  auto in = std::ifstream{path, std::ios::binary};
+  if (!in) {
+    throw std::runtime_error(fmt::format("{}: cannot open trace file", path));
+  }
+  char magic[sizeof(MAGIC) - 1] = {};
+  in.read(magic, sizeof(magic));
+  if (in && std::string(magic, sizeof(magic)) == MAGIC) {
+    return read_binary(in, path);
+  }
+  in.clear();
+  in.seekg(0);
+  return read_csv(in, path);
+}
+
+/// The first time at which every signal of `trace` is defined.
+double trace_begin(const stl::Trace& trace) {
+  double begin = std::numeric_limits<double>::lowest();
+  for (const auto& [id, x] : trace) { begin = std::max(begin, x->begin_time()); }
+  return begin;
+}
+
+/// Serializes the rows of the results to the output, a result at a time.
+class ResultWriter {
+  std::FILE* out;
+  std::mutex mtx;
+
+ public:
+  explicit ResultWriter(const std::string& path) :
+      out{(path == "-") ? stdout : std::fopen(path.c_str(), "w")} {
+    if (this->out == nullptr) {
+      throw std::runtime_error(fmt::format("{}: cannot open output file", path));
+    }
+    fmt::print(this->out, "trace,assertion,time,robustness\n");
+  }
+  ResultWriter(const ResultWriter&) = delete;
+  ResultWriter& operator=(const ResultWriter&) = delete;
+  ~ResultWriter() {
+    if (this->out != stdout) {
+      std::fclose(this->out);
+    }
+  }
+
+  void write(const fmt::memory_buffer& rows) {
+    std::lock_guard<std::mutex> lock{this->mtx};
+    std::fwrite(rows.data(), 1, rows.size(), this->out);
+    std::fflush(this->out);
+  }
+};
+
+Options parse_args(int argc, char* argv[]) {
+  auto opt = Options{};
+  for (int i = 1; i < argc; i++) {
+    const auto arg = std::string{argv[i]};
+    if (arg == "--at-start") {
+      opt.at_start = true;
+    } else if (arg.rfind("--", 0) == 0 && i + 1 >= argc) {
+      throw std::invalid_argument(fmt::format("Missing value of option {}", arg));
+    } else if (arg == "--threads") {
+      opt.n_threads = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--output") {
+      opt.output = argv[++i];
+    } else if (arg == "--epsilon") {
+      opt.epsilon = std::strtod(argv[++i], nullptr);
+    } else if (arg.rfind("--", 0) == 0) {
+      throw std::invalid_argument(fmt::format("Unknown option {}", arg));
+    } else if (opt.spec.empty()) {
+      opt.spec = arg;
+    } else {
+      opt.traces.push_back(arg);
+    }
+  }
+  if (opt.spec.empty() || opt.traces.empty()) {
+    throw std::invalid_argument(
+        "Usage: stl-eval [--threads N] [--output PATH] [--epsilon E] [--at-start] "
+        "SPEC_FILE TRACE_FILE...");
+  }
+  return opt;
+}
+
+void print_statistics(const std::map<std::string, Statistics>& stats) {
+  fmt::print(
+      stderr,
+      "{:<24} {:>8} {:>12} {:>12} {:>12} {:>14}\n",
+      "assertion",
+      "traces",
+      "total (s)",
+      "mean (ms)",
+      "max (ms)",
+      "peak mem (KiB)");
+  for (const auto& [name, s] : stats) {
+    const auto n    = static_cast<double>(std::max<size_t>(s.n_traces, 1));
+    const auto mean = s.seconds / n;
+    fmt::print(
+        stderr,
+        "{:<24} {:>8} {:>12.3f} {:>12.3f} {:>12.3f} {:>14.1f}\n",
+        name,
+        s.n_traces,
+        s.seconds,
+        1e3 * mean,
+        1e3 * s.max_seconds,
+        static_cast<double>(s.peak_memory) / 1024.0);
+  }
+
+  auto usage = rusage{};
+  if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+    // `ru_maxrss` is in KiB on Linux.
+    fmt::print(stderr, "peak resident memory: {} KiB\n", usage.ru_maxrss);
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const auto opt   = parse_args(argc, argv);
+    const auto spec  = stl::parser::from_file(opt.spec);
+    auto writer      = ResultWriter{opt.output};
+    auto stats       = std::map<std::string, Statistics>{};
+    auto stats_mtx   = std::mutex{};
+    size_t n_failed  = 0;
+    auto options     = stl::semantics::RobustnessOptions{};
+    options.epsilon  = opt.epsilon;
+    using clock_type = std::chrono::steady_clock;
+
+    for (const auto& [name, phi] : spec->assertions) { stats[name] = Statistics{}; }
+
+    stl::parallel::parallel_for(opt.traces.size(), opt.n_threads, [&](size_t i) {
+      const auto& path = opt.traces[i];
+      try {
+        const auto trace = read_trace(path);
+        for (const auto& [name, phi] : spec->assertions) {
+          auto rows        = fmt::memory_buffer{};
+          auto out         = std::back_inserter(rows);
+          auto report      = stl::semantics::RobustnessReport{};
+          const auto start = clock_type::now();
+          if (opt.at_start) {
+            const double t0 = trace_begin(trace);
+            const double r  = stl::semantics::compute_robustness_at(phi, trace, t0);
+            fmt::format_to(out, "{},{},{},{}\n", path, name, t0, r);
+          } else {
+            const auto rob =
+                stl::semantics::compute_robustness(phi, trace, options, &report);
+            for (const auto& s : *rob) {
+              fmt::format_to(out, "{},{},{},{}\n", path, name, s.time, s.value);
+            }
+          }
+          const auto elapsed =
+              std::chrono::duration<double>(clock_type::now() - start).count();
+          writer.write(rows);
+
+          std::lock_guard<std::mutex> lock{stats_mtx};
+          auto& s = stats[name];
+          s.n_traces++;
+          s.seconds += elapsed;
+          s.max_seconds = std::max(s.max_seconds, elapsed);
+          s.peak_memory = std::max(s.peak_memory, report.peak_memory);
+        }
+      } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock{stats_mtx};
+        fmt::print(stderr, "stl-eval: {}: {}\n", path, e.what());
+        n_failed++;
+      }
+    });
+
+    print_statistics(stats);
+    if (n_failed > 0) {
+      return EXIT_FAILURE;
+    }
+  } catch (const std::exception& e) {
+    fmt::print(stderr, "stl-eval: {}\n", e.what());
+    return EXIT_FAILURE;
+  }
+  return 0;
+}
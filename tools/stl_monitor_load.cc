@@ -0,0 +1,214 @@
+/// stl-monitor-load: throughput benchmark of `stl-monitord`, with local clients.
+///
+/// Usage: stl-monitor-load [--socket PATH] [--clients N] [--samples M] [--batch B]
+///                         [--signals x,y,...] [--prefix NAME]
+///
+/// Each of the `N` clients streams its own trace, `NAME-1` to `NAME-N`, with `M`
+/// samples of each signal sent in frames of `B` time steps, and waits for the server to
+/// acknowledge them. A subscriber counts the verdicts streamed back meanwhile. The
+/// server keeps the traces, so another run against the same server needs a new prefix.
+
+#include "monitor_protocol.hpp"
+
+#include <fmt/format.h> // for print
+
+#include <algorithm> // for min, max
+#include <atomic>    // for atomic
+#include <chrono>    // for steady_clock, duration
+#include <cmath>     // for sin
+#include <cstdint>   // for uint16_t, uint32_t
+#include <cstdlib>   // for strtoull, EXIT_FAILURE
+#include <cstring>   // for strncpy
+#include <exception> // for exception
+#include <stdexcept> // for runtime_error, invalid_argument
+#include <string>    // for string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <sys/socket.h> // for socket, connect, recv, shutdown
+#include <sys/un.h>     // for sockaddr_un
+#include <unistd.h>     // for close
+
+namespace proto = signal_tl::monitor_protocol;
+using proto::FrameType;
+
+namespace {
+
+struct Options {
+  std::string socket = "/tmp/stl-monitord.sock";
+  size_t n_clients   = 4;
+  size_t n_samples   = 100000;
+  size_t batch       = 256;
+  /// The signals of every trace, on the channels `0, 1, ...`.
+  std::vector<std::string> signals = {"x", "y"};
+  std::string prefix               = "load";
+};
+
+int connect_to(const std::string& path) {
+  auto addr       = sockaddr_un{};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+    throw std::runtime_error(fmt::format("Cannot connect to {}", path));
+  }
+  return fd;
+}
+
+void send_frame(int fd, proto::Writer& frame) {
+  const auto bytes = frame.finish();
+  if (!proto::send_all(fd, bytes.data(), bytes.size())) {
+    throw std::runtime_error("The server closed the connection");
+  }
+}
+
+/// Read frames from `fd`, calling `fn(type, reader)` on each, until `fn` returns
+/// `false`.
+template <typename Fn>
+void read_frames(int fd, Fn&& fn) {
+  auto inbox   = std::vector<char>{};
+  bool reading = true;
+  char buffer[1 << 16];
+  while (reading) {
+    const auto n = ::recv(fd, buffer, sizeof(buffer), 0);
+    if (n <= 0) {
+      throw std::runtime_error("The server closed the connection");
+    }
+    inbox.insert(inbox.end(), buffer, buffer + n);
+    proto::for_each_frame(inbox, [&](FrameType type, proto::Reader in) {
+      if (type == FrameType::Error) {
+        throw std::runtime_error(in.str());
+      }
+      reading = reading && fn(type, in);
+    });
+  }
+}
+
+/// Wait for the acknowledgement of a `Sync` frame sent on `fd`.
+void sync(int fd, std::uint32_t token) {
+  auto frame = proto::Writer{FrameType::Sync}.u32(token);
+  send_frame(fd, frame);
+  read_frames(fd, [token](FrameType type, proto::Reader& in) {
+    return type != FrameType::SyncAck || in.u32() != token;
+  });
+}
+
+void run_client(const Options& opt, size_t id) {
+  const int fd = connect_to(opt.socket);
+  for (size_t k = 0; k < opt.signals.size(); k++) {
+    auto frame = proto::Writer{FrameType::Declare}
+                     .u16(static_cast<std::uint16_t>(k))
+                     .str(fmt::format("{}-{}", opt.prefix, id))
+                     .str(opt.signals[k]);
+    send_frame(fd, frame);
+  }
+
+  for (size_t i = 0; i < opt.n_samples; i += opt.batch) {
+    auto frame = proto::Writer{FrameType::Samples};
+    for (size_t j = i; j < std::min(i + opt.batch, opt.n_samples); j++) {
+      const double t = 0.01 * static_cast<double>(j);
+      for (size_t k = 0; k < opt.signals.size(); k++) {
+        frame.u16(static_cast<std::uint16_t>(k))
+            .f64(t)
+            .f64(std::sin(t * static_cast<double>(k + 1) + static_cast<double>(id)));
+      }
+    }
+    send_frame(fd, frame);
+  }
+  sync(fd, static_cast<std::uint32_t>(id));
+  ::close(fd);
+}
+
+Options parse_args(int argc, char* argv[]) {
+  auto opt        = Options{};
+  const auto size = [](const char* arg) { return std::strtoull(arg, nullptr, 10); };
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const auto arg = std::string{argv[i]};
+    if (arg == "--socket") {
+      opt.socket = argv[i + 1];
+    } else if (arg == "--clients") {
+      opt.n_clients = size(argv[i + 1]);
+    } else if (arg == "--samples") {
+      opt.n_samples = size(argv[i + 1]);
+    } else if (arg == "--batch") {
+      opt.batch = std::max<size_t>(1, size(argv[i + 1]));
+    } else if (arg == "--prefix") {
+      opt.prefix = argv[i + 1];
+    } else if (arg == "--signals") {
+      opt.signals.clear();
+      auto names = std::string{argv[i + 1]};
+      for (size_t start = 0, end = 0; start <= names.size(); start = end + 1) {
+        end = std::min(names.find(',', start), names.size());
+        opt.signals.push_back(names.substr(start, end - start));
+      }
+    } else {
+      throw std::invalid_argument(fmt::format("Unknown option {}", arg));
+    }
+  }
+  return opt;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const auto opt = parse_args(argc, argv);
+
+    // Subscribe before any sample is sent.
+    const int subscriber = connect_to(opt.socket);
+    auto subscribe       = proto::Writer{FrameType::Subscribe};
+    send_frame(subscriber, subscribe);
+    sync(subscriber, 0);
+
+    auto n_verdicts = std::atomic<size_t>{0};
+    auto counter    = std::thread{[&]() {
+      try {
+        read_frames(subscriber, [&](FrameType type, proto::Reader&) {
+          n_verdicts += (type == FrameType::Verdict) ? 1 : 0;
+          return true;
+        });
+      } catch (const std::exception&) {
+        // The connection is shut down at the end of the benchmark.
+      }
+    }};
+
+    const auto start = std::chrono::steady_clock::now();
+    auto failed      = std::atomic<bool>{false};
+    auto clients     = std::vector<std::thread>{};
+    for (size_t i = 0; i < opt.n_clients; i++) {
+      clients.emplace_back([&opt, &failed, i]() {
+        try {
+          run_client(opt, i + 1);
+        } catch (const std::exception& e) {
+          fmt::print(stderr, "stl-monitor-load: client {}: {}\n", i + 1, e.what());
+          failed = true;
+        }
+      });
+    }
+    for (auto& th : clients) { th.join(); }
+    const auto elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ::shutdown(subscriber, SHUT_RDWR);
+    counter.join();
+    ::close(subscriber);
+    if (failed) {
+      return EXIT_FAILURE;
+    }
+
+    const auto total = opt.n_clients * opt.n_samples * opt.signals.size();
+    fmt::print(
+        "{} clients, {} samples in {:.3f} s: {:.0f} samples/s, {} verdicts\n",
+        opt.n_clients,
+        total,
+        elapsed,
+        static_cast<double>(total) / elapsed,
+        n_verdicts.load());
+  } catch (const std::exception& e) {
+    fmt::print(stderr, "stl-monitor-load: {}\n", e.what());
+    return EXIT_FAILURE;
+  }
+  return 0;
+}
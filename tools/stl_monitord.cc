@@ -0,0 +1,474 @@
+/// stl-monitord: monitor the assertions of specification files over traces that local
+/// processes stream to it over a Unix domain socket.
+///
+/// Usage: stl-monitord [--socket PATH] [--lateness SECONDS] [--max-backlog BYTES]
+///                     SPEC_FILE...
+///
+/// The assertions of all the specification files are monitored over every trace that a
+/// client declares (see `monitor_protocol.hpp` for the framing). A trace is shared by
+/// all the clients that feed it, so processes that observe the same system keep a
+/// single copy of it, in the server.
+///
+/// Assertions with only past-time operators are monitored online: their verdicts are
+/// final as soon as every signal has reached their time, and the samples are not kept.
+/// The other assertions are evaluated at the start of the trace, over the samples
+/// received so far, and their verdict is final once the trace covers their horizon.
+/// All the frames that arrive together, from all the clients, are applied before the
+/// traces are evaluated, so the cost of an evaluation is shared by a batch of samples.
+///
+/// The sockets are non-blocking: the frames to a client are queued, and sent when its
+/// socket accepts them, so a client that stops reading does not stall the others. A
+/// client with more than `--max-backlog` bytes (16 MiB by default) waiting is
+/// disconnected.
+
+#include "monitor_protocol.hpp"
+
+#include "signal_tl/fmt.hpp" // IWYU pragma: keep
+#include "signal_tl/signal_tl.hpp"
+
+#include "signal_tl/parser.hpp" // for from_file, Specification
+
+#include <fmt/format.h> // for print, format
+
+#include <algorithm> // for max, min
+#include <atomic>    // for atomic
+#include <csignal>   // for signal, SIGINT, SIGTERM
+#include <cerrno>    // for errno, EAGAIN, EWOULDBLOCK
+#include <cstddef>   // for size_t, ptrdiff_t
+#include <cstdint>   // for uint16_t, uint32_t
+#include <cstdlib>   // for strtod, strtoull, EXIT_FAILURE
+#include <cstring>   // for strncpy
+#include <exception> // for exception
+#include <limits>    // for numeric_limits
+#include <map>       // for map
+#include <memory>    // for make_shared, shared_ptr
+#include <optional>  // for optional
+#include <stdexcept> // for runtime_error, invalid_argument, out_of_range
+#include <string>    // for string
+#include <utility>   // for pair, move
+#include <vector>    // for vector
+
+#include <fcntl.h>      // for fcntl, F_GETFL, F_SETFL, O_NONBLOCK
+#include <poll.h>       // for poll, pollfd, POLLIN, POLLOUT
+#include <sys/socket.h> // for socket, bind, listen, accept, recv, send
+#include <sys/un.h>     // for sockaddr_un
+#include <unistd.h>     // for close, unlink
+
+namespace stl   = signal_tl;
+namespace proto = signal_tl::monitor_protocol;
+using proto::FrameType;
+
+namespace {
+
+std::atomic<bool> stopping{false};
+
+struct Options {
+  std::string socket = "/tmp/stl-monitord.sock";
+  double lateness    = 0;
+  size_t max_backlog = size_t{16} << 20U;
+  std::vector<std::string> specs;
+};
+
+/// The state of an assertion over one trace.
+struct Assertion {
+  std::string name;
+  stl::ast::Expr phi;
+  stl::ast::Horizon horizon;
+  /// The monitor of a past-time assertion.
+  std::optional<stl::AsyncMonitor> online = std::nullopt;
+  /// The last verdict sent of an offline assertion.
+  std::optional<std::pair<double, double>> last = std::nullopt;
+  bool final                                   = false;
+};
+
+struct TraceState {
+  std::string name;
+  /// The shared copy of the trace, kept only if some assertion is offline.
+  stl::Trace signals;
+  bool keep_signals = false;
+  std::vector<Assertion> assertions;
+  bool dirty = false;
+};
+
+/// A channel declared by a client.
+struct Channel {
+  TraceState* trace;
+  std::string signal;
+  /// The index of the signal in the monitor of each assertion, if it uses it.
+  std::vector<std::optional<size_t>> indices;
+};
+
+struct Client {
+  int fd;
+  std::vector<char> inbox                   = {};
+  std::map<std::uint16_t, Channel> channels = {};
+  bool subscribed                           = false;
+  /// Tokens of the `Sync` frames to answer after the next evaluation.
+  std::vector<std::uint32_t> syncs = {};
+  /// The frames not sent yet.
+  std::vector<char> outbox = {};
+};
+
+class Server {
+  std::vector<std::pair<std::string, stl::ast::Expr>> spec;
+  double lateness;
+  size_t max_backlog;
+  std::map<std::string, TraceState> traces;
+  std::vector<Client> clients;
+
+ public:
+  Server(
+      std::vector<std::pair<std::string, stl::ast::Expr>> assertions,
+      double late,
+      size_t backlog) :
+      spec{std::move(assertions)}, lateness{late}, max_backlog{backlog} {}
+
+  void accept(int fd) {
+    this->clients.push_back(Client{fd});
+  }
+
+  [[nodiscard]] const std::vector<Client>& connections() const {
+    return this->clients;
+  }
+
+  /// Read from the client `i`, and return `false` if its connection is closed.
+  bool receive(size_t i);
+
+  /// Evaluate the traces that changed, and queue the verdicts.
+  void evaluate();
+
+  /// Send as much of the queued frames as the sockets accept.
+  void flush();
+
+  /// Close the connections that are marked as closed.
+  void sweep() {
+    auto open = std::vector<Client>{};
+    for (auto& c : this->clients) {
+      if (c.fd >= 0) {
+        open.push_back(std::move(c));
+      }
+    }
+    this->clients = std::move(open);
+  }
+
+  void close(size_t i) {
+    ::close(this->clients[i].fd);
+    this->clients[i].fd = -1;
+  }
+
+ private:
+  TraceState& trace(const std::string& name);
+  void handle(Client& client, FrameType type, proto::Reader& in);
+  void publish(const TraceState& trace, const Assertion& a, double t, double rho);
+  /// Queue `frame` for `client`, or disconnect it if too much is queued already.
+  void send(Client& client, const std::vector<char>& frame);
+};
+
+TraceState& Server::trace(const std::string& name) {
+  auto it = this->traces.find(name);
+  if (it != this->traces.end()) {
+    return it->second;
+  }
+
+  auto& state = this->traces[name];
+  state.name  = name;
+  for (const auto& [id, phi] : this->spec) {
+    auto a = Assertion{id, phi, stl::ast::horizon(phi)};
+    try {
+      a.online.emplace(phi, this->lateness);
+    } catch (const std::invalid_argument&) {
+      // The assertion has future-time operators, and is evaluated over the trace.
+      state.keep_signals = true;
+    }
+    state.assertions.push_back(std::move(a));
+  }
+  fmt::print(stderr, "New trace {}\n", name);
+  return state;
+}
+
+bool Server::receive(size_t i) {
+  auto& client = this->clients[i];
+  char buffer[1 << 16];
+  const auto n = ::recv(client.fd, buffer, sizeof(buffer), 0);
+  if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    return true;
+  } else if (n <= 0) {
+    return false;
+  }
+  client.inbox.insert(client.inbox.end(), buffer, buffer + n);
+  try {
+    proto::for_each_frame(client.inbox, [&](FrameType type, proto::Reader in) {
+      this->handle(client, type, in);
+    });
+  } catch (const std::exception& e) {
+    // The connection is closed anyway, so the error is sent only if it fits in the
+    // socket buffer.
+    const auto frame = proto::Writer{FrameType::Error}.str(e.what()).finish();
+    proto::send_all(client.fd, frame.data(), frame.size());
+    return false;
+  }
+  return true;
+}
+
+void Server::handle(Client& client, FrameType type, proto::Reader& in) {
+  switch (type) {
+    case FrameType::Subscribe:
+      client.subscribed = true;
+      break;
+    case FrameType::Declare: {
+      const auto id = in.u16();
+      auto& trace   = this->trace(in.str());
+      auto channel  = Channel{&trace, in.str(), {}};
+      for (const auto& a : trace.assertions) {
+        auto& index = channel.indices.emplace_back(std::nullopt);
+        if (!a.online) {
+          continue;
+        }
+        const auto& names = a.online->signals();
+
+        const auto it = std::lower_bound(names.begin(), names.end(), channel.signal);
+        if (it != names.end() && *it == channel.signal) {
+          index = static_cast<size_t>(it - names.begin());
+        }
+      }
+      if (trace.keep_signals && trace.signals.count(channel.signal) == 0) {
+        trace.signals[channel.signal] = std::make_shared<stl::Signal>();
+      }
+      client.channels.insert_or_assign(id, std::move(channel));
+      break;
+    }
+    case FrameType::Samples:
+      while (!in.done()) {
+        const auto id  = in.u16();
+        const double t = in.f64();
+        const double v = in.f64();
+        const auto it  = client.channels.find(id);
+        if (it == client.channels.end()) {
+          throw std::runtime_error(fmt::format("Undeclared channel {}", id));
+        }
+        auto& [trace, signal, indices] = it->second;
+        if (trace->keep_signals) {
+          // Samples out of order are rejected by the signal.
+          trace->signals.at(signal)->push_back(t, v);
+        }
+        for (size_t k = 0; k < indices.size(); k++) {
+          if (indices[k].has_value()) {
+            trace->assertions[k].online->push(*indices[k], t, v);
+          }
+        }
+        trace->dirty = true;
+      }
+      break;
+    case FrameType::Sync:
+      client.syncs.push_back(in.u32());
+      break;
+    default:
+      throw std::runtime_error(
+          fmt::format("Unexpected frame of type {}", static_cast<int>(type)));
+  }
+}
+
+void Server::publish(
+    const TraceState& trace, const Assertion& a, double t, double rho) {
+  const auto frame = proto::Writer{FrameType::Verdict}
+                          .str(trace.name)
+                          .str(a.name)
+                          .f64(t)
+                          .f64(rho)
+                          .u8((a.final || a.online) ? 1 : 0)
+                          .finish();
+  for (auto& c : this->clients) {
+    if (c.subscribed) {
+      this->send(c, frame);
+    }
+  }
+}
+
+void Server::send(Client& client, const std::vector<char>& frame) {
+  if (client.fd < 0) {
+    return;
+  } else if (client.outbox.size() + frame.size() > this->max_backlog) {
+    fmt::print(
+        stderr, "Disconnecting a client with {} bytes unread\n", client.outbox.size());
+    ::close(client.fd);
+    client.fd = -1;
+    client.outbox.clear();
+    return;
+  }
+  client.outbox.insert(client.outbox.end(), frame.begin(), frame.end());
+}
+
+void Server::flush() {
+  for (auto& c : this->clients) {
+    size_t done = 0;
+    while (c.fd >= 0 && done < c.outbox.size()) {
+      const auto n =
+          ::send(c.fd, c.outbox.data() + done, c.outbox.size() - done, MSG_NOSIGNAL);
+      if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        break;
+      } else if (n <= 0) {
+        ::close(c.fd);
+        c.fd = -1;
+        break;
+      }
+      done += static_cast<size_t>(n);
+    }
+    c.outbox.erase(c.outbox.begin(), c.outbox.begin() + static_cast<std::ptrdiff_t>(done));
+  }
+}
+
+void Server::evaluate() {
+  for (auto& [name, trace] : this->traces) {
+    if (!trace.dirty) {
+      continue;
+    }
+    trace.dirty = false;
+
+    // The time range over which every signal of the trace is defined.
+    double begin = std::numeric_limits<double>::lowest();
+    double end   = std::numeric_limits<double>::max();
+    for (const auto& [id, x] : trace.signals) {
+      if (x->empty()) {
+        begin = std::numeric_limits<double>::max();
+        break;
+      }
+      begin = std::max(begin, x->begin_time());
+      end   = std::min(end, x->end_time());
+    }
+
+    for (auto& a : trace.assertions) {
+      if (a.online) {
+        for (const auto& s : a.online->poll()) {
+          this->publish(trace, a, s.time, s.value);
+        }
+        continue;
+      } else if (a.final || begin > end) {
+        continue;
+      }
+      try {
+        const double rho = stl::compute_robustness_at(a.phi, trace.signals, begin);
+        a.final = a.horizon.is_bounded() && end >= begin + a.horizon.future;
+        if (a.final || !a.last || *a.last != std::make_pair(begin, rho)) {
+          a.last = std::make_pair(begin, rho);
+          this->publish(trace, a, begin, rho);
+        }
+      } catch (const std::out_of_range&) {
+        // Some signal of the assertion has not been declared yet.
+      }
+    }
+  }
+
+  for (auto& c : this->clients) {
+    for (const auto token : c.syncs) {
+      this->send(c, proto::Writer{FrameType::SyncAck}.u32(token).finish());
+    }
+    c.syncs.clear();
+  }
+}
+
+Options parse_args(int argc, char* argv[]) {
+  auto opt = Options{};
+  for (int i = 1; i < argc; i++) {
+    const auto arg = std::string{argv[i]};
+    if (arg == "--socket" && i + 1 < argc) {
+      opt.socket = argv[++i];
+    } else if (arg == "--lateness" && i + 1 < argc) {
+      opt.lateness = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--max-backlog" && i + 1 < argc) {
+      opt.max_backlog = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg.rfind("--", 0) == 0) {
+      throw std::invalid_argument(fmt::format("Unknown option {}", arg));
+    } else {
+      opt.specs.push_back(arg);
+    }
+  }
+  if (opt.specs.empty()) {
+    throw std::invalid_argument("No specification file given");
+  }
+  return opt;
+}
+
+int listen_on(const std::string& path) {
+  auto addr       = sockaddr_un{};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    throw std::invalid_argument(fmt::format("Socket path too long: {}", path));
+  }
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  ::unlink(path.c_str());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+      ::listen(fd, SOMAXCONN) < 0) {
+    throw std::runtime_error(fmt::format("Cannot listen on {}", path));
+  }
+  return fd;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    const auto opt = parse_args(argc, argv);
+
+    auto assertions = std::vector<std::pair<std::string, stl::ast::Expr>>{};
+    for (const auto& path : opt.specs) {
+      const auto spec = stl::parser::from_file(path);
+      for (const auto& [name, phi] : spec->assertions) {
+        for (const auto& [other, psi] : assertions) {
+          if (other == name) {
+            throw std::invalid_argument(fmt::format("Duplicate assertion {}", name));
+          }
+        }
+        assertions.emplace_back(name, phi);
+      }
+    }
+    fmt::print(stderr, "Loaded {} assertions\n", assertions.size());
+
+    const int listener = listen_on(opt.socket);
+    std::signal(SIGINT, [](int) { stopping = true; });
+    std::signal(SIGTERM, [](int) { stopping = true; });
+    fmt::print(stderr, "Listening on {}\n", opt.socket);
+
+    auto server = Server{std::move(assertions), opt.lateness, opt.max_backlog};
+    auto fds    = std::vector<pollfd>{};
+    while (!stopping) {
+      fds.clear();
+      fds.push_back(pollfd{listener, POLLIN, 0});
+      for (const auto& c : server.connections()) {
+        const short events = (c.outbox.empty()) ? POLLIN : (POLLIN | POLLOUT);
+        fds.push_back(pollfd{c.fd, events, 0});
+      }
+      if (::poll(fds.data(), fds.size(), 100) <= 0) {
+        continue;
+      }
+
+      // Apply the frames of every client that is ready before evaluating.
+      for (size_t i = 1; i < fds.size(); i++) {
+        const bool ready = (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+        if (ready && !server.receive(i - 1)) {
+          server.close(i - 1);
+        }
+      }
+      server.evaluate();
+      server.flush();
+      server.sweep();
+      if ((fds[0].revents & POLLIN) != 0) {
+        const int fd = ::accept(listener, nullptr, nullptr);
+        if (fd >= 0 && ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK) == 0) {
+          server.accept(fd);
+        } else if (fd >= 0) {
+          ::close(fd);
+        }
+      }
+    }
+
+    ::close(listener);
+    ::unlink(opt.socket.c_str());
+  } catch (const std::exception& e) {
+    fmt::print(stderr, "stl-monitord: {}\n", e.what());
+    return EXIT_FAILURE;
+  }
+  return 0;
+}